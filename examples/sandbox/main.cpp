@@ -1,12 +1,82 @@
-// #include <iostream>
 #include <jate/application.h>
 
 #include <jate/components/render_units/rect2d_render_unit.h>
+#include <jate/components/render_units/sprite_render_unit.h>
+#include <jate/components/render_units/text_render_unit.h>
+#include <jate/components/render_units/particle_emitter_render_unit.h>
+#include <jate/components/render_units/streamed_mesh_render_unit.h>
+
+#include <spdlog/spdlog.h>
+
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Writes a captured frame as a binary PPM, easy to diff against a golden image
+static bool writeCaptureToPPM(const jate::rendering::FrameCapture& capture, const std::string& path)
+{
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open())
+        return false;
+
+    file << "P6\n" << capture.width << " " << capture.height << "\n255\n";
+    for (size_t i = 0; i + 3 < capture.pixels.size(); i += 4)
+    {
+        file.write(reinterpret_cast<const char*>(&capture.pixels[i]), 3);  // Drop alpha
+    }
+
+    return static_cast<bool>(file);
+}
+
+// A small checkerboard, to have a texture without loading any file
+static std::vector<uint8_t> makeCheckerboard(uint32_t size, uint32_t squareSize)
+{
+    std::vector<uint8_t> pixels(static_cast<size_t>(size) * size * 4);
+    for (uint32_t y = 0; y < size; y++)
+    {
+        for (uint32_t x = 0; x < size; x++)
+        {
+            bool light = ((x / squareSize) + (y / squareSize)) % 2 == 0;
+            uint8_t* pixel = &pixels[(static_cast<size_t>(y) * size + x) * 4];
+            pixel[0] = light ? 230 : 40;
+            pixel[1] = light ? 180 : 60;
+            pixel[2] = light ? 60 : 120;
+            pixel[3] = 255;
+        }
+    }
+    return pixels;
+}
 
 int main(int argc, char** argv)
 {
+    // Usage : sandbox [--headless <frame count>] [--capture <output.ppm>] [--mesh <file.jmesh>] [--compact-vertices]
+    jate::ApplicationConfig config{};
+    std::string capturePath;
+    std::string meshPath;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--headless") == 0 && i + 1 < argc)
+        {
+            config.headless = true;
+            config.maxFrameCount = std::stoull(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--capture") == 0 && i + 1 < argc)
+        {
+            capturePath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--mesh") == 0 && i + 1 < argc)
+        {
+            meshPath = argv[++i];     // Converted offline by the mesh_converter tool
+        }
+        else if (strcmp(argv[i], "--compact-vertices") == 0)
+        {
+            config.renderer.vertexLayout = jate::rendering::VertexLayout::compact();
+        }
+    }
+
     // Hello, world
-    jate::Application app;
+    jate::Application app(config);
     auto world = app.createWorld();
 
     auto rectangle = world->spawnEntity();
@@ -14,6 +84,62 @@ int main(int argc, char** argv)
 
     rectRenderUnit->setRect(0.f, 0.f, 0.5f, 0.3f);
 
+    // Sprites sharing one texture, drawn together
+    jate::rendering::renderer_texture_id checkerTexture = app.getRenderer()->allocateTexture(64, 64, makeCheckerboard(64, 8));
+    for (int i = 0; i < 3; i++)
+    {
+        auto spriteEntity = world->spawnEntity();
+        auto spriteRenderUnit = spriteEntity->addComponent<jate::components::SpriteRenderUnit>();
+        spriteRenderUnit->setTexture(checkerTexture);
+        spriteRenderUnit->setRect(-0.6f + 0.6f * i, 0.6f, 0.3f, 0.3f);
+        spriteRenderUnit->setColor({1.f, 1.f, 1.f, 0.5f + 0.25f * i});
+    }
+
+    // Text, drawn with the sprites
+    auto font = std::make_shared<jate::rendering::BitmapFont>();
+    auto label = world->spawnEntity();
+    auto textRenderUnit = label->addComponent<jate::components::TextRenderUnit>();
+    textRenderUnit->setFont(font);
+    textRenderUnit->setText("Hello, jate!\nSprites and text share one draw");
+    textRenderUnit->setPosition(-0.9f, -0.9f);
+    textRenderUnit->setGlyphSize(0.04f, 0.06f);
+
+    // Particles, simulated on the GPU
+    auto fountain = world->spawnEntity();
+    auto emitterRenderUnit = fountain->addComponent<jate::components::ParticleEmitterRenderUnit>();
+    jate::rendering::ParticleEmitterSettings emitterSettings;
+    emitterSettings.initialVelocity = {0.f, -1.2f, 0.f};
+    emitterSettings.velocitySpread = 0.3f;
+    emitterSettings.gravity = {0.f, 1.5f, 0.f};
+    emitterSettings.blendMode = jate::rendering::ParticleBlendMode::Additive;
+    emitterRenderUnit->setSettings(emitterSettings);
+    emitterRenderUnit->setOffset({0.6f, 0.3f, 0.f});
+
+    if (!meshPath.empty())
+    {
+        // Streamed : frames are rendered while the mesh loads, and it shows up once uploaded
+        auto meshHandle = app.getAssetManager()->loadMesh(meshPath, jate::assets::AssetPriority::High, {},
+            [meshPath](jate::assets::asset_id, jate::assets::AssetState state) {
+                if (state != jate::assets::AssetState::Ready)
+                    spdlog::error("Could not load {}", meshPath);
+            });
+
+        auto meshEntity = world->spawnEntity();
+        auto meshRenderUnit = meshEntity->addComponent<jate::components::StreamedMeshRenderUnit>();
+        meshRenderUnit->setMesh(app.getAssetManager(), meshHandle);
+    }
+
     app.run();
+
+    if (!capturePath.empty())
+    {
+        jate::rendering::FrameCapture capture;
+        if (!app.getRenderer()->captureLastFrame(capture) || !writeCaptureToPPM(capture, capturePath))
+        {
+            spdlog::error("Could not write frame capture to {}", capturePath);
+            return EXIT_FAILURE;
+        }
+    }
+
     return EXIT_SUCCESS;
 }
\ No newline at end of file
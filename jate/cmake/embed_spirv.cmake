@@ -0,0 +1,15 @@
+# Turns a SPIR-V binary into the comma separated list of its 32 bits words, included by embedded_shaders.cpp
+# Usage : cmake -DINPUT=<shader.spv> -DOUTPUT=<shader.spv.inc> -P embed_spirv.cmake
+
+file(READ ${INPUT} SPIRV_HEX HEX)
+
+string(LENGTH "${SPIRV_HEX}" SPIRV_HEX_LENGTH)
+math(EXPR SPIRV_PADDING "${SPIRV_HEX_LENGTH} % 8")
+if(SPIRV_HEX_LENGTH EQUAL 0 OR NOT SPIRV_PADDING EQUAL 0)
+    message(FATAL_ERROR "${INPUT} is not SPIR-V : its size is not a multiple of 4 bytes")
+endif()
+
+# glslc writes words little endian
+string(REGEX REPLACE "(..)(..)(..)(..)" "0x\\4\\3\\2\\1u,\n" SPIRV_WORDS "${SPIRV_HEX}")
+
+file(WRITE ${OUTPUT} "${SPIRV_WORDS}")
\ No newline at end of file
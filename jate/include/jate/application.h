@@ -3,30 +3,122 @@
 
 #include <jate/window/window.h>
 #include <jate/rendering/renderer.h>
+#include <jate/rendering/render_thread.h>
+#include <jate/assets/asset_manager.h>
 #include <jate/models/world.h>
 #include <jate/systems/system.h>
+#include <jate/timing/frame_statistics.h>
+#include <jate/timing/frame_pacer.h>
 
+#include <chrono>
 #include <memory>
 #include <map>
+#include <string>
+#include <vector>
 
 namespace jate
 {
+    struct ApplicationConfig
+    {
+        std::string name = "My window";
+        uint16_t width = 800;
+        uint16_t height = 600;
+
+        /// @brief Runs without any window, rendering into offscreen images
+        bool headless = false;
+
+        /// @brief Stops the main loop after this amount of frames. 0 means no limit.
+        uint64_t maxFrameCount = 0;
+
+        /// @brief Records and submits frames on a dedicated thread, overlapping with the simulation of the next frame.
+        ///        This adds up to one frame of latency.
+        bool useRenderThread = false;
+
+        /// @brief Caps the frame rate, in frames per second. 0 means no cap.
+        double targetFrameRate = 0.0;
+
+        /// @brief Duration of a simulation step, in seconds. Simulation runs at this rate whatever the frame rate is,
+        ///        and rendering interpolates transforms between the two last steps.
+        double fixedTimeStep = 1.0 / 60.0;
+
+        /// @brief Maximum amount of simulation steps run in a single frame. When a frame takes longer than that,
+        ///        the remaining time is dropped and the simulation slows down instead of spiraling.
+        uint32_t maxFixedStepsPerFrame = 8;
+
+        /// @brief When built with JATE_ENABLE_PROFILING, exports the CPU profile once this frame is reached (0 means never).
+        ///        Pressing F12 exports it as well.
+        uint64_t profileCaptureFrame = 0;
+        std::string profileCapturePath = "jate_trace.json";
+
+        /// @brief Present mode, swap chain image count and frames in flight.
+        ///        Headless mode and size are taken from the fields above.
+        rendering::RendererConfig renderer{};
+    };
+
     class Application
     {
     public:
-        Application();
+        Application(const ApplicationConfig& config = {});
         ~Application();
 
         models::World* createWorld();
 
+        inline rendering::ARenderer* getRenderer() const { return m_renderer.get(); }
+
+        /// @brief Loads assets in the background. Its completion callbacks run on the main thread, at the start of each frame.
+        inline assets::AssetManager* getAssetManager() const { return m_assetManager.get(); }
+
+        /// @brief CPU frame, frame interval, fence wait and present timings since the start (or the last reset)
+        inline timing::FrameStatistics& getFrameStatistics() { return m_frameStatistics; }
+
+        /// @param targetFrameRate Frames per second. 0 removes the cap.
+        inline void setTargetFrameRate(double targetFrameRate) { m_framePacer.setTargetFrameRate(targetFrameRate); }
+        inline double getTargetFrameRate() const { return m_framePacer.getTargetFrameRate(); }
+
+        inline double getFixedTimeStep() const { return m_config.fixedTimeStep; }
+
+        /// @brief Amount of simulation steps run since the start
+        inline uint64_t getFixedStepCount() const { return m_fixedStepCount; }
+
         void run();
     
     private:
+        bool shouldStop() const;
+        void handleProfileCapture();
+
+        /// @brief Renders the world snapshot, or hands it over to the render thread
+        void renderFrame();
+
+        /// @brief Moves the events received by the window since the last frame to m_pendingInputEvents
+        void collectInputEvents();
+        /// @brief Drops the events received by the window, e.g. while minimized : they are stale once restored
+        void discardInputEvents();
+
+        /// @brief Runs as many simulation steps as the elapsed time requires.
+        ///        Each step gets the input events received before its end, in real time.
+        /// @return Interpolation alpha for the render phase
+        float runFixedSteps(double frameDeltaTime, std::chrono::steady_clock::time_point frameStart);
+
+        static const int ms_PROFILE_CAPTURE_KEY = GLFW_KEY_F12;
+        static constexpr std::chrono::milliseconds ms_RENDER_THREAD_SUBMIT_TIMEOUT{10};
+        static constexpr double ms_MINIMIZED_WAIT_TIMEOUT = 0.1;   // Seconds
+        bool m_profileCaptureKeyWasDown = false;
+
+        ApplicationConfig m_config;
         bool m_running = false;
-        Window m_window;
+        uint64_t m_frameCount = 0;
+        uint64_t m_fixedStepCount = 0;
+        double m_fixedStepAccumulator = 0.0;
+        std::vector<input::InputEvent> m_pendingInputEvents;   // Received, but after the end of the last simulation step
+        std::unique_ptr<Window> m_window;   // Null in headless mode
+
+        timing::FrameStatistics m_frameStatistics;
+        timing::FramePacer m_framePacer;
         
         std::unique_ptr<rendering::ARenderer> m_renderer;
+        std::unique_ptr<assets::AssetManager> m_assetManager;     // Uploads to the renderer, so it is destroyed before it
         std::unique_ptr<models::World> m_world;
+        std::unique_ptr<rendering::RenderThread> m_renderThread;   // Declared last, so that it is stopped before anything it renders is destroyed
         
     };
 }
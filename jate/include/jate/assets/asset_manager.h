@@ -0,0 +1,175 @@
+#ifndef Jate_AssetManager_H
+#define Jate_AssetManager_H
+
+#include <jate/assets/mapped_file.h>
+#include <jate/assets/mesh_asset.h>
+#include <jate/rendering/renderer.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace jate::assets
+{
+    using asset_id = uint32_t;
+
+    /// @brief Loads are started highest priority first, then in request order
+    enum class AssetPriority : uint8_t
+    {
+        Low,        // Streamed ahead, e.g. the next level
+        Normal,
+        High,       // Needed for the coming frames
+    };
+
+    enum class AssetState : uint8_t
+    {
+        Waiting,    // For its dependencies
+        Queued,     // For a worker thread
+        Loading,
+        Uploading,  // Meshes only : loaded, waiting for the frame uploading them to complete on the GPU
+        Ready,
+        Failed,     // Its file, or one of its dependencies, could not be loaded
+        Cancelled,
+    };
+
+    /// @brief Identifies an asset of a given type. Handles are plain values : copying one does not keep the asset loaded.
+    template <typename T>
+    struct AssetHandle
+    {
+        asset_id id = 0;
+
+        inline bool isValid() const { return id != 0; }
+    };
+
+    /// @brief Renderer memory of an uploaded mesh, ready to be drawn
+    struct MeshSlots
+    {
+        rendering::renderer_memory_slot_id verticesSlot;
+        rendering::renderer_memory_slot_id indicesSlot;
+    };
+
+    /// @brief Loads assets on background threads, so that a level can be streamed while frames keep being rendered.
+    ///        Files are memory mapped by a pool of worker threads, meshes are then uploaded with the next frame.
+    ///        Every method must be called from the same thread (the one running the world), except where stated otherwise.
+    class AssetManager
+    {
+    public:
+        /// @brief Called from update() once an asset is ready, failed, or was cancelled
+        using completion_callback = std::function<void (asset_id id, AssetState state)>;
+
+        /// @param renderer Meshes are uploaded to it. It must outlive the manager.
+        /// @param workerCount I/O threads. Loads are bound by the disk : a few threads are enough to keep it busy.
+        AssetManager(rendering::ARenderer* renderer, uint32_t workerCount = 2);
+        /// @brief Cancels queued loads, waits for the running ones, and releases every asset
+        ~AssetManager();
+
+        // No copy allowed
+        AssetManager(const AssetManager&) = delete;
+        AssetManager& operator=(const AssetManager&) = delete;
+
+        /// @brief Maps a file in memory, e.g. SPIR-V code or any data parsed by the caller
+        /// @param dependencies Assets that must be ready before this one starts loading. If one fails or is cancelled, so does this one.
+        AssetHandle<MappedFile> loadFile(const std::string& path, AssetPriority priority = AssetPriority::Normal,
+            const std::vector<asset_id>& dependencies = {}, completion_callback onComplete = {});
+
+        /// @brief Maps a .jmesh file, and uploads it to the renderer. It is ready once the upload is done on the GPU.
+        AssetHandle<MeshAsset> loadMesh(const std::string& path, AssetPriority priority = AssetPriority::Normal,
+            const std::vector<asset_id>& dependencies = {}, completion_callback onComplete = {});
+
+        /// @brief Stops a load. Queued loads never start, running ones are dropped once done. Assets depending on it are cancelled too.
+        ///        Ready assets are not affected : use release() instead.
+        void cancel(asset_id id);
+
+        /// @brief Drops the asset. Its renderer memory is handed to the snapshot of the next update() :
+        ///        snapshots waiting to be rendered can still draw it.
+        void release(asset_id id);
+
+        /// @brief Runs the completion callbacks, and starts the loads whose dependencies just became ready. Call it once per frame.
+        /// @param snapshot Renderer memory of the meshes released since the last call goes into it, to be freed once rendered
+        void update(rendering::RenderSnapshot& snapshot);
+
+        /// @brief Can be called from any thread
+        AssetState getState(asset_id id) const;
+
+        /// @return nullptr until the asset is ready
+        std::shared_ptr<const MappedFile> getFile(AssetHandle<MappedFile> handle) const;
+        std::shared_ptr<const MeshAsset> getMesh(AssetHandle<MeshAsset> handle) const;
+        /// @return Empty until the mesh is ready
+        std::optional<MeshSlots> getMeshSlots(AssetHandle<MeshAsset> handle) const;
+
+    private:
+        enum class AssetType : uint8_t
+        {
+            File,
+            Mesh,
+        };
+
+        struct AssetRecord
+        {
+            AssetType type;
+            AssetState state = AssetState::Waiting;
+            AssetPriority priority;
+            std::string path;
+            uint32_t pendingDependencies = 0;
+            std::vector<asset_id> dependents;
+            completion_callback onComplete;
+
+            std::shared_ptr<const void> data;       // MappedFile or MeshAsset, once loaded
+            std::optional<MeshSlots> meshSlots;
+        };
+
+        struct QueuedLoad
+        {
+            AssetPriority priority;
+            uint64_t sequence;      // Request order, among loads of the same priority
+            asset_id id;
+
+            bool operator<(const QueuedLoad& other) const;
+        };
+
+        /// @brief Shared with upload callbacks, which run on the thread rendering frames and may outlive the manager
+        struct UploadCompletions
+        {
+            std::mutex mutex;
+            std::vector<asset_id> ids;
+        };
+
+        asset_id requestLoad(AssetType type, const std::string& path, AssetPriority priority,
+            const std::vector<asset_id>& dependencies, completion_callback onComplete);
+
+        /// @brief Sets a final state, and propagates failures to dependents. m_mutex must be held.
+        void finish(asset_id id, AssetState state);
+        /// @brief m_mutex must be held
+        void enqueue(asset_id id, AssetRecord& record);
+
+        void workerLoop();
+        /// @brief Runs on a worker thread, without holding m_mutex
+        void load(asset_id id, AssetType type, const std::string& path);
+
+        rendering::ARenderer* m_renderer;
+
+        mutable std::mutex m_mutex;
+        std::condition_variable m_queueCondition;
+        bool m_stopping = false;
+        std::priority_queue<QueuedLoad> m_queue;
+        uint64_t m_nextSequence = 0;
+        asset_id m_nextId = 1;      // 0 is the invalid handle
+        std::unordered_map<asset_id, AssetRecord> m_records;
+        std::vector<asset_id> m_completed;      // Callbacks to run in update()
+        std::vector<MeshSlots> m_slotsToFree;   // Meshes released, or uploaded after being cancelled : handed to the snapshot in update()
+
+        std::shared_ptr<UploadCompletions> m_uploadCompletions;
+
+        std::vector<std::thread> m_workers;
+    };
+}
+
+#endif
\ No newline at end of file
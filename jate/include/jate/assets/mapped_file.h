@@ -0,0 +1,38 @@
+#ifndef Jate_MappedFile_H
+#define Jate_MappedFile_H
+
+#include <cstddef>
+#include <string>
+
+namespace jate::assets
+{
+    /// @brief A whole file mapped read-only in memory. Pages are loaded by the OS when first read :
+    ///        opening a file costs nothing, and its content is never copied into an intermediate buffer.
+    class MappedFile
+    {
+    public:
+        /// @brief Throws if the file can't be opened or mapped, or if it is empty
+        explicit MappedFile(const std::string& path);
+        ~MappedFile();
+
+        // No copy allowed
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        inline const std::byte* getData() const { return m_data; }
+        inline size_t getSize() const { return m_size; }
+        inline const std::string& getPath() const { return m_path; }
+
+    private:
+        std::string m_path;
+        const std::byte* m_data = nullptr;
+        size_t m_size = 0;
+
+#ifdef _WIN32
+        void* m_fileHandle = nullptr;
+        void* m_mappingHandle = nullptr;
+#endif
+    };
+}
+
+#endif
\ No newline at end of file
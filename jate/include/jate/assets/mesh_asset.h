@@ -0,0 +1,85 @@
+#ifndef Jate_MeshAsset_H
+#define Jate_MeshAsset_H
+
+#include <jate/assets/mapped_file.h>
+#include <jate/rendering/data_structs.h>
+
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace jate::assets
+{
+    // .jmesh file layout : a header, a table of sections, then the sections themselves.
+    // Every section starts at a multiple of ms_SECTION_ALIGNMENT, so its content can be used in place once the file is mapped.
+    // Values are stored in the byte order of the machine writing the file : little endian on every supported platform.
+
+    struct MeshFileHeader
+    {
+        char magic[4];              // "JMSH"
+        uint32_t version;
+        uint32_t vertexStride;      // sizeof(VertexData) when written : files written with another vertex layout are rejected
+        uint32_t sectionCount;      // Entries of the section table, right after the header
+    };
+
+    enum class MeshSectionType : uint32_t
+    {
+        Vertices = 1,   // VertexData array
+        Indices = 2,    // uint32_t array, 3 per triangle
+        Bounds = 3,     // A single MeshBounds
+    };
+
+    struct MeshFileSection
+    {
+        MeshSectionType type;
+        uint32_t reserved;      // Zero : keeps the 64 bit fields aligned
+        uint64_t offset;        // From the start of the file
+        uint64_t size;          // In bytes
+    };
+
+    /// @brief Axis aligned bounding box of the vertex positions
+    struct MeshBounds
+    {
+        glm::vec3 min;
+        glm::vec3 max;
+    };
+
+    /// @brief A mesh read from a .jmesh file. The file is memory mapped : vertices and indices are views into the mapping,
+    ///        so that they can be handed to ARenderer::allocateVertexData() without being parsed nor copied.
+    ///        The asset must outlive the views it returns.
+    class MeshAsset
+    {
+    public:
+        /// @brief Maps the file and validates its layout and indices. Throws if the file can't be read, or is not a valid mesh file of the current version.
+        explicit MeshAsset(const std::string& path);
+
+        // No copy allowed
+        MeshAsset(const MeshAsset&) = delete;
+        MeshAsset& operator=(const MeshAsset&) = delete;
+
+        inline std::span<const rendering::VertexData> getVertices() const { return m_vertices; }
+        inline std::span<const uint32_t> getIndices() const { return m_indices; }
+        inline const MeshBounds& getBounds() const { return m_bounds; }
+
+        /// @brief Writes a .jmesh file, e.g. from an offline converter. Throws if the file can't be written.
+        static void write(const std::string& path, std::span<const rendering::VertexData> vertices, std::span<const uint32_t> indices);
+
+        static MeshBounds computeBounds(std::span<const rendering::VertexData> vertices);
+
+        static constexpr char ms_MAGIC[4] = {'J', 'M', 'S', 'H'};
+        static constexpr uint32_t ms_VERSION = 1;     // Bumped whenever the layout, or VertexData, changes
+        static constexpr uint64_t ms_SECTION_ALIGNMENT = 16;
+
+    private:
+        /// @brief Returns the content of a section, checked against the file size and the element type. Empty if the section is missing.
+        template <typename T>
+        std::span<const T> getSection(MeshSectionType type) const;
+
+        MappedFile m_file;
+        std::span<const rendering::VertexData> m_vertices;
+        std::span<const uint32_t> m_indices;
+        MeshBounds m_bounds;
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,38 @@
+#ifndef Jate_MeshRenderUnit_H
+#define Jate_MeshRenderUnit_H
+
+#include <jate/components/render_units/render_unit.h>
+
+namespace jate::components
+{
+    /// @brief A render unit drawing its own vertex and index data, allocated in renderer memory slots
+    class AMeshRenderUnit : public ARenderUnit
+    {
+    public:
+        AMeshRenderUnit(jate::models::Entity* entity) : ARenderUnit(entity) {}
+
+        /// @brief Adds this unit's draw to the snapshot. Memory is allocated through the renderer the first time.
+        virtual void draw(rendering::ARenderer* renderer, rendering::RenderSnapshot& snapshot, float interpolationAlpha) override;
+
+        virtual void free(rendering::RenderSnapshot& snapshot) override;
+
+    private:
+        void initialize(rendering::ARenderer* renderer);
+
+    protected:
+
+        struct AllocatedRenderingData
+        {
+            rendering::renderer_memory_slot_id verticesSlot, indicesSlot;
+        };
+
+        /// @brief This method initializes renderer slots with the right vertex / index data
+        ///        It will be used by the draw() method.
+        virtual AllocatedRenderingData allocateRenderingData(rendering::ARenderer* renderer) const = 0;
+
+        bool m_initialized = false;
+        AllocatedRenderingData m_allocatedData;
+    };
+}
+
+#endif
\ No newline at end of file
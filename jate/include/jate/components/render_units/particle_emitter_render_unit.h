@@ -0,0 +1,33 @@
+#ifndef Jate_ParticleEmitterRenderUnit_H
+#define Jate_ParticleEmitterRenderUnit_H
+
+#include <jate/components/render_units/render_unit.h>
+
+#include <optional>
+
+namespace jate::components
+{
+    /// @brief Emits particles from the entity position. The whole simulation runs on the GPU :
+    ///        the CPU cost per frame is the same for a thousand particles and for a million.
+    class ParticleEmitterRenderUnit : public ARenderUnit
+    {
+    public:
+        ParticleEmitterRenderUnit(jate::models::Entity* entity) : ARenderUnit(entity) {}
+
+        /// @brief Must be called before the first draw : the particle system is created with these settings, and keeps them.
+        void setSettings(const rendering::ParticleEmitterSettings& settings);
+        /// @brief Emitter position, relative to the entity
+        void setOffset(const glm::vec3& offset);
+
+        /// @brief Creates the particle system through the renderer the first time
+        virtual void draw(rendering::ARenderer* renderer, rendering::RenderSnapshot& snapshot, float interpolationAlpha) override;
+        virtual void free(rendering::RenderSnapshot& snapshot) override;
+
+    private:
+        rendering::ParticleEmitterSettings m_settings;
+        glm::vec3 m_offset = {0.f, 0.f, 0.f};
+        std::optional<rendering::renderer_particle_system_id> m_particleSystem;
+    };
+}
+
+#endif
\ No newline at end of file
@@ -1,14 +1,14 @@
 #ifndef Jate_Rect2DRenderUnit_H
 #define Jate_Rect2DRenderUnit_H
 
-#include <jate/components/render_units/render_unit.h>
+#include <jate/components/render_units/mesh_render_unit.h>
 
 namespace jate::components
 {
-    class Rect2DRenderUnit : public ARenderUnit
+    class Rect2DRenderUnit : public AMeshRenderUnit
     {
     public:
-        Rect2DRenderUnit(jate::models::Entity* entity) : ARenderUnit(entity) {}
+        Rect2DRenderUnit(jate::models::Entity* entity) : AMeshRenderUnit(entity) {}
 
         void setRect(float centerX, float centerY, float width, float height);
 
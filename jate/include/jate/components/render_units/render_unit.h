@@ -6,30 +6,18 @@
 
 namespace jate::components
 {
+    /// @brief A component drawn by the render system, every frame
     class ARenderUnit : public AComponent
     {
     public:
         ARenderUnit(jate::models::Entity* entity) : AComponent(entity) {}
 
-        void draw(rendering::ARenderer* renderer);
-        void free(rendering::ARenderer* renderer);
+        /// @brief Adds this unit's draws to the snapshot. Renderer memory can be allocated here, the first time.
+        /// @param interpolationAlpha Position between the two last simulation steps, used to interpolate the entity transform
+        virtual void draw(rendering::ARenderer* renderer, rendering::RenderSnapshot& snapshot, float interpolationAlpha) = 0;
 
-    private:
-        void initialize(rendering::ARenderer* renderer);
-
-    protected:
-
-        struct AllocatedRenderingData
-        {
-            rendering::renderer_memory_slot_id verticesSlot, indicesSlot;
-        };
-
-        /// @brief This method initializes renderer slots with the right vertex / index data
-        ///        It will be used by the draw() method.
-        virtual AllocatedRenderingData allocateRenderingData(rendering::ARenderer* renderer) const = 0;
-
-        bool m_initialized = false;
-        AllocatedRenderingData m_allocatedData;
+        /// @brief Schedules the release of this unit's renderer memory, once the snapshot has been rendered
+        virtual void free(rendering::RenderSnapshot& snapshot) = 0;
     };
 }
 
@@ -0,0 +1,36 @@
+#ifndef Jate_SpriteRenderUnit_H
+#define Jate_SpriteRenderUnit_H
+
+#include <jate/components/render_units/render_unit.h>
+
+#include <optional>
+
+namespace jate::components
+{
+    /// @brief A textured rectangle. Sprites share the renderer texture atlas, so any number of them is drawn in a single draw.
+    class SpriteRenderUnit : public ARenderUnit
+    {
+    public:
+        SpriteRenderUnit(jate::models::Entity* entity) : ARenderUnit(entity) {}
+
+        /// @brief The texture is not owned by the sprite : it is allocated through the renderer, and freed once no sprite draws it.
+        ///        Nothing is drawn until a texture is set.
+        void setTexture(rendering::renderer_texture_id textureId);
+        /// @brief Rectangle covered by the texture, relative to the entity
+        void setRect(float centerX, float centerY, float width, float height);
+        /// @brief Multiplies the texture color, alpha included
+        void setColor(const glm::vec4& color);
+
+        virtual void draw(rendering::ARenderer* renderer, rendering::RenderSnapshot& snapshot, float interpolationAlpha) override;
+        /// @brief Nothing to release : sprites do not allocate renderer memory
+        virtual void free(rendering::RenderSnapshot& snapshot) override {}
+
+    private:
+        std::optional<rendering::renderer_texture_id> m_texture;
+        float m_centerX = 0.f, m_centerY = 0.f;
+        float m_width = 1.f, m_height = 1.f;
+        glm::vec4 m_color = {1.f, 1.f, 1.f, 1.f};
+    };
+}
+
+#endif
\ No newline at end of file
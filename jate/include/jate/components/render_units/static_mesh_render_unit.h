@@ -0,0 +1,28 @@
+#ifndef Jate_StaticMeshRenderUnit_H
+#define Jate_StaticMeshRenderUnit_H
+
+#include <jate/components/render_units/mesh_render_unit.h>
+#include <jate/assets/mesh_asset.h>
+
+#include <memory>
+
+namespace jate::components
+{
+    /// @brief Draws a mesh loaded from a .jmesh file. Units drawing the same asset can share it.
+    class StaticMeshRenderUnit : public AMeshRenderUnit
+    {
+    public:
+        StaticMeshRenderUnit(jate::models::Entity* entity) : AMeshRenderUnit(entity) {}
+
+        /// @brief Must be called before the first draw. Vertices and indices are uploaded straight from the file mapping.
+        void setMesh(std::shared_ptr<const assets::MeshAsset> mesh);
+
+    protected:
+        virtual AllocatedRenderingData allocateRenderingData(rendering::ARenderer* renderer) const override;
+
+    private:
+        std::shared_ptr<const assets::MeshAsset> m_mesh;
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,28 @@
+#ifndef Jate_StreamedMeshRenderUnit_H
+#define Jate_StreamedMeshRenderUnit_H
+
+#include <jate/components/render_units/render_unit.h>
+#include <jate/assets/asset_manager.h>
+
+namespace jate::components
+{
+    /// @brief Draws a mesh loaded by the asset manager. Nothing is drawn until the mesh is ready, so that loading never stalls a frame.
+    class StreamedMeshRenderUnit : public ARenderUnit
+    {
+    public:
+        StreamedMeshRenderUnit(jate::models::Entity* entity) : ARenderUnit(entity) {}
+
+        /// @param assetManager Must outlive the unit
+        void setMesh(assets::AssetManager* assetManager, assets::AssetHandle<assets::MeshAsset> mesh);
+
+        virtual void draw(rendering::ARenderer* renderer, rendering::RenderSnapshot& snapshot, float interpolationAlpha) override;
+        /// @brief Nothing to release : the mesh memory belongs to the asset manager
+        virtual void free(rendering::RenderSnapshot& snapshot) override {}
+
+    private:
+        assets::AssetManager* m_assetManager = nullptr;
+        assets::AssetHandle<assets::MeshAsset> m_mesh;
+    };
+}
+
+#endif
\ No newline at end of file
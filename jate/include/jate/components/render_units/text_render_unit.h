@@ -0,0 +1,43 @@
+#ifndef Jate_TextRenderUnit_H
+#define Jate_TextRenderUnit_H
+
+#include <jate/components/render_units/render_unit.h>
+#include <jate/rendering/bitmap_font.h>
+
+#include <memory>
+#include <string>
+
+namespace jate::components
+{
+    /// @brief A string drawn with a bitmap font. Each glyph is a sprite : the glyphs of every text unit end up in a single instanced draw.
+    ///        The text is only laid out again when it changes, and identical strings share their layout through the font cache.
+    class TextRenderUnit : public ARenderUnit
+    {
+    public:
+        TextRenderUnit(jate::models::Entity* entity) : ARenderUnit(entity) {}
+
+        /// @brief The font can be shared by any number of units. It is uploaded to the renderer the first time it is drawn.
+        void setFont(std::shared_ptr<rendering::BitmapFont> font);
+        void setText(const std::string& text);
+        /// @brief Top left corner of the text, relative to the entity
+        void setPosition(float x, float y);
+        /// @brief Size of one character cell
+        void setGlyphSize(float width, float height);
+        /// @brief Color of the text, alpha included
+        void setColor(const glm::vec4& color);
+
+        virtual void draw(rendering::ARenderer* renderer, rendering::RenderSnapshot& snapshot, float interpolationAlpha) override;
+        /// @brief Glyph textures belong to the font : they are released with the last unit using it
+        virtual void free(rendering::RenderSnapshot& snapshot) override;
+
+    private:
+        std::shared_ptr<rendering::BitmapFont> m_font;
+        std::string m_text;
+        std::shared_ptr<const rendering::TextLayout> m_layout;    // Null when the text changed since the last draw
+        float m_x = 0.f, m_y = 0.f;
+        float m_glyphWidth = 0.05f, m_glyphHeight = 0.05f;
+        glm::vec4 m_color = {1.f, 1.f, 1.f, 1.f};
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,39 @@
+#ifndef Jate_InputEvent_H
+#define Jate_InputEvent_H
+
+#include <chrono>
+
+#include <stdint.h>
+
+namespace jate::input
+{
+    enum class InputEventType
+    {
+        Key,
+        Char,
+        MouseButton,
+        CursorMove,
+        Scroll
+    };
+
+    /// @brief A window input event, as received from GLFW. Codes and actions use the GLFW values (GLFW_KEY_*, GLFW_PRESS...).
+    struct InputEvent
+    {
+        InputEventType type;
+
+        /// @brief When the event was received, on the same clock as the application main loop
+        std::chrono::steady_clock::time_point timestamp;
+
+        // Key, MouseButton : key / button code. Char : unicode code point.
+        int32_t code = 0;
+        int32_t scancode = 0;
+        int32_t action = 0;
+        int32_t mods = 0;
+
+        // CursorMove : cursor position, in screen coordinates. Scroll : scroll offset.
+        double x = 0.0;
+        double y = 0.0;
+    };
+}
+
+#endif
\ No newline at end of file
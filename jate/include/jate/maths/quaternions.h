@@ -2,6 +2,7 @@
 #define Jate_Quaternion_H
 
 #include <concepts>
+#include <cmath>
 #include <jate/maths/vectors.h>
 
 namespace jate::maths
@@ -15,7 +16,7 @@ namespace jate::maths
 
         Quaternion<T> normalized() const
         {
-            T length_inv = 1.0 / (x * x + y * y + z * z + w * w);
+            T length_inv = 1.0 / std::sqrt(x * x + y * y + z * z + w * w);
             return Quaternion<T>(x * length_inv, y * length_inv, z * length_inv, w * length_inv);
         }
 
@@ -31,6 +32,21 @@ namespace jate::maths
             ).normalized();
         }
 
+        /// @brief Normalized linear interpolation along the shortest arc. Cheaper than a slerp,
+        ///        and accurate enough between two close rotations (e.g. two consecutive simulation steps).
+        static Quaternion<T> nlerp(const Quaternion<T>& a, const Quaternion<T>& b, T t)
+        {
+            T dot = a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+            T sign = dot < static_cast<T>(0) ? static_cast<T>(-1) : static_cast<T>(1);
+
+            return Quaternion<T>(
+                a.x + (sign * b.x - a.x) * t,
+                a.y + (sign * b.y - a.y) * t,
+                a.z + (sign * b.z - a.z) * t,
+                a.w + (sign * b.w - a.w) * t
+            ).normalized();
+        }
+
         static Quaternion<T> identity;
     };
 
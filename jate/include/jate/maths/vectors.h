@@ -3,6 +3,8 @@
 
 #include <jate/utils/concepts.h>
 
+#include <concepts>
+
 namespace jate::maths
 {
     // --- VECTOR 2D ---
@@ -78,6 +80,13 @@ namespace jate::maths
     template<jate::utils::concepts::arithmetic T>
     Vector3<T> Vector3<T>::back = Vector3<T>(static_cast<T>(0), static_cast<T>(0), static_cast<T>(1));
 
+    /// @brief Linear interpolation, t = 0 gives a and t = 1 gives b
+    template<std::floating_point T>
+    Vector3<T> lerp(const Vector3<T>& a, const Vector3<T>& b, T t)
+    {
+        return Vector3<T>(a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t);
+    }
+
     // Aliases
     using Vector3i = Vector3<int32_t>;
     using Vector3ui = Vector3<uint32_t>;
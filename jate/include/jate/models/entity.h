@@ -22,6 +22,21 @@ namespace jate::models
 
         inline Transform& getTransform() { return m_transform; }
 
+        /// @brief Transform at the end of the previous simulation step.
+        ///        Until the entity has gone through one, this is its current transform : it is not interpolated from the origin.
+        inline const Transform& getPreviousTransform() const { return m_hasPreviousTransform ? m_previousTransform : m_transform; }
+
+        /// @brief Called by the world before each simulation step.
+        ///        Can also be called after teleporting the entity, so that it is not interpolated from its old position.
+        inline void savePreviousTransform()
+        {
+            m_previousTransform = m_transform;
+            m_hasPreviousTransform = true;
+        }
+
+        /// @param alpha Position between the two last simulation steps, in [0, 1]
+        inline Transform getInterpolatedTransform(float alpha) const { return Transform::interpolate(getPreviousTransform(), m_transform, alpha); }
+
         template<utils::concepts::component_type Comp>
         Comp* addComponent()
         {
@@ -38,6 +53,8 @@ namespace jate::models
         World* m_world;
         uint32_t m_id;
         Transform m_transform;
+        Transform m_previousTransform;
+        bool m_hasPreviousTransform = false;   // Set by the first simulation step after spawning
         std::vector<std::unique_ptr<components::AComponent>> m_components;
     };
 }
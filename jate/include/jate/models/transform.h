@@ -20,6 +20,16 @@ namespace jate::models
         Transform(jate::maths::Vector3f _position, jate::maths::Quaternionf _rotation, jate::maths::Vector3f _scale) : position(_position), rotation(_rotation), scale(_scale) {}
         Transform() : position(jate::maths::Vector3f::zero), rotation(jate::maths::Quaternionf::identity), scale(jate::maths::Vector3f::one) {}
 
+        /// @brief Blends two transforms, alpha = 0 gives a and alpha = 1 gives b
+        static Transform interpolate(const Transform& a, const Transform& b, float alpha)
+        {
+            return Transform(
+                jate::maths::lerp(a.position, b.position, alpha),
+                jate::maths::Quaternionf::nlerp(a.rotation, b.rotation, alpha),
+                jate::maths::lerp(a.scale, b.scale, alpha)
+            );
+        }
+
         glm::mat4 getMatrix() const
         {
             return glm::mat4{
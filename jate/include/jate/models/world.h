@@ -8,6 +8,8 @@
 #include <vector>
 #include <map>
 #include <memory>
+#include <span>
+#include <utility>
 
 namespace jate { class Application; }
 
@@ -20,8 +22,35 @@ namespace jate::models
 
         Entity* spawnEntity();
 
+        /// @brief Destroys the entity and its components. GPU resources they own are released once no frame in flight uses them.
+        void despawnEntity(Entity* entity);
+
+        /// @brief Adds a system, ticked after the built-in ones. Should be called before spawning entities,
+        ///        since components added earlier are not signaled to it.
+        template<typename Sys, typename... Args>
+        Sys* addSystem(Args&&... args)
+        {
+            auto systemId = static_cast<systems::SystemEnum>(systems::FIRST_USER_SYSTEM + m_userSystemCount);
+            m_userSystemCount++;
+
+            auto system = std::make_unique<Sys>(std::forward<Args>(args)...);
+            Sys* systemPtr = system.get();
+            m_systems.emplace(systemId, std::move(system));
+            return systemPtr;
+        }
+
         inline Application& getApplication() const { return m_application; }
-        void tickSystems();
+
+        /// @brief Runs one simulation step : saves every entity transform for interpolation,
+        ///        dispatches the input events received during the step, then fixed-ticks systems.
+        void fixedTickSystems(double fixedDeltaTime, std::span<const input::InputEvent> inputEvents = {});
+
+        /// @brief Runs the render phase of every system.
+        void tickSystems(float interpolationAlpha);
+
+        /// @brief Draws extracted by the last tickSystems(), plus memory released since the snapshot was last consumed.
+        ///        The consumer is responsible for clearing it.
+        inline rendering::RenderSnapshot& getRenderSnapshot() { return m_renderSnapshot; }
 
         void onComponentAdded(components::AComponent* component);
         void onComponentRemoved(components::AComponent* component);
@@ -29,7 +58,11 @@ namespace jate::models
     private:
         void init_registerSystems();
 
+        // Declared first : entities release their render units into it when destroyed
+        rendering::RenderSnapshot m_renderSnapshot;
+
         std::map<systems::SystemEnum, std::unique_ptr<systems::ASystem>> m_systems;
+        uint32_t m_userSystemCount = 0;
         std::vector<std::unique_ptr<Entity>> m_entities;
         Application& m_application;
 
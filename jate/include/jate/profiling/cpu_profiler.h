@@ -0,0 +1,92 @@
+#ifndef Jate_CpuProfiler_H
+#define Jate_CpuProfiler_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <stdint.h>
+
+namespace jate::profiling
+{
+    struct ProfileZoneEvent
+    {
+        const char* name;   // Must have static storage duration (string literal, __func__)
+        uint64_t startNs;
+        uint64_t endNs;
+    };
+
+    /// @brief Collects timed zones from every thread into per-thread ring buffers, and exports them as a Chrome trace.
+    ///        Zones are recorded through the JATE_PROFILE_* macros, which compile to nothing unless JATE_ENABLE_PROFILING is defined.
+    class CpuProfiler
+    {
+    public:
+        static CpuProfiler& get();
+
+        // No copy allowed
+        CpuProfiler(const CpuProfiler&) = delete;
+        CpuProfiler& operator=(const CpuProfiler&) = delete;
+
+        /// @brief Nanoseconds elapsed since the profiler was created
+        uint64_t now() const;
+
+        void recordZone(const char* name, uint64_t startNs, uint64_t endNs);
+
+        /// @brief Writes every zone still held in the ring buffers to a Chrome trace JSON file (chrome://tracing, ui.perfetto.dev)
+        /// @return Whether the file could be written
+        bool exportChromeTrace(const std::string& path);
+
+        static constexpr size_t ms_EVENTS_PER_THREAD = 1 << 16;
+
+    private:
+        CpuProfiler();
+
+        /// @brief Only written by its thread, without any lock. Exports read it concurrently, and drop the zones overwritten meanwhile.
+        struct ThreadBuffer
+        {
+            uint32_t threadId;
+            std::vector<ProfileZoneEvent> events;   // Ring : zone n is stored at n % size
+            std::atomic<uint64_t> startedCount = 0;     // Zones whose write began
+            std::atomic<uint64_t> recordedCount = 0;    // Zones completely written
+        };
+
+        ThreadBuffer& getThreadBuffer();
+
+        uint64_t m_startTicks;
+
+        // Buffers are owned here rather than by their thread, so that zones of finished threads can still be exported
+        std::mutex m_threadBuffersMutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> m_threadBuffers;
+    };
+
+    /// @brief Records the time spent between its construction and its destruction
+    class ProfileZone
+    {
+    public:
+        ProfileZone(const char* name) : m_name(name), m_startNs(CpuProfiler::get().now()) {}
+        ~ProfileZone() { CpuProfiler::get().recordZone(m_name, m_startNs, CpuProfiler::get().now()); }
+
+        ProfileZone(const ProfileZone&) = delete;
+        ProfileZone& operator=(const ProfileZone&) = delete;
+
+    private:
+        const char* m_name;
+        uint64_t m_startNs;
+    };
+}
+
+#ifdef JATE_ENABLE_PROFILING
+    #define JATE_PROFILE_CONCAT_IMPL(a, b) a##b
+    #define JATE_PROFILE_CONCAT(a, b) JATE_PROFILE_CONCAT_IMPL(a, b)
+
+    /// @brief Profiles the rest of the enclosing scope. The name must be a string literal.
+    #define JATE_PROFILE_SCOPE(name) ::jate::profiling::ProfileZone JATE_PROFILE_CONCAT(jateProfileZone_, __LINE__)(name)
+    #define JATE_PROFILE_FUNCTION() JATE_PROFILE_SCOPE(__func__)
+#else
+    #define JATE_PROFILE_SCOPE(name) ((void)0)
+    #define JATE_PROFILE_FUNCTION() ((void)0)
+#endif
+
+#endif
\ No newline at end of file
@@ -0,0 +1,61 @@
+#ifndef Jate_AtlasPacker_H
+#define Jate_AtlasPacker_H
+
+#include <stdint.h>
+#include <optional>
+#include <vector>
+
+namespace jate::rendering
+{
+    /// @brief A rectangle of an atlas, in texels
+    struct AtlasRegion
+    {
+        uint32_t x = 0, y = 0;
+        uint32_t width = 0, height = 0;
+    };
+
+    /// @brief Packs rectangles into a fixed size atlas, as rows of rectangles (shelves).
+    ///        A rectangle goes to the first shelf it fits in without wasting too much height, or opens a new one.
+    ///        Freed space is reused by later allocations, and empty shelves at the end of the atlas are released.
+    class ShelfAtlasPacker
+    {
+    public:
+        /// @param alignment Every region position and size is a multiple of it
+        ShelfAtlasPacker(uint32_t width, uint32_t height, uint32_t alignment = 1);
+
+        /// @return The allocated region, or nothing if the atlas is full. Its size is rounded up to the alignment.
+        std::optional<AtlasRegion> allocate(uint32_t width, uint32_t height);
+        /// @param region Must have been returned by allocate() on this packer
+        void free(const AtlasRegion& region);
+
+        inline uint32_t getWidth() const { return m_width; }
+        inline uint32_t getHeight() const { return m_height; }
+        /// @brief Area of the allocated regions, in texels
+        inline uint64_t getUsedArea() const { return m_usedArea; }
+
+    private:
+        struct FreeSpan
+        {
+            uint32_t x;
+            uint32_t width;
+        };
+
+        struct Shelf
+        {
+            uint32_t y;
+            uint32_t height;
+            std::vector<FreeSpan> freeSpans;   // Sorted by x, never adjacent
+        };
+
+        static std::optional<uint32_t> takeSpan(Shelf& shelf, uint32_t width);
+        uint32_t align(uint32_t value) const;
+
+        uint32_t m_width, m_height;
+        uint32_t m_alignment;
+        std::vector<Shelf> m_shelves;   // Sorted by y
+        uint32_t m_nextShelfY = 0;
+        uint64_t m_usedArea = 0;
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,84 @@
+#ifndef Jate_BitmapFont_H
+#define Jate_BitmapFont_H
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+#include <jate/rendering/data_structs.h>
+
+#include <array>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace jate::rendering
+{
+    class ARenderer;
+
+    /// @brief A visible character of a laid out string
+    struct TextGlyph
+    {
+        renderer_texture_id texture;
+        glm::vec2 offset;   // Top left corner of the glyph cell, in cells from the top left corner of the text
+    };
+
+    /// @brief A string laid out as glyph cells : one cell per character, one row per line. Spaces take a cell but no glyph.
+    struct TextLayout
+    {
+        std::vector<TextGlyph> glyphs;
+        float width = 0.f;      // Columns of the longest line
+        float height = 0.f;     // Number of lines
+    };
+
+    /// @brief The built-in 8x8 ASCII font. Glyph coverage is rasterized into the renderer texture atlas,
+    ///        so text is drawn as sprites : every glyph of every string goes into the same instanced draw.
+    ///        Laid out strings are cached, so that strings drawn again (or by several units) are not laid out every frame.
+    class BitmapFont
+    {
+    public:
+        /// @param glyphScale Texels per font pixel in the atlas. Larger glyphs stay sharp when magnified.
+        /// @param layoutCacheCapacity Laid out strings kept, the least recently used ones are evicted first
+        BitmapFont(uint32_t glyphScale = 4, size_t layoutCacheCapacity = 1024);
+        /// @brief Frees the glyph textures, unless release() was called. The renderer they were uploaded to must still be alive.
+        ~BitmapFont();
+
+        // No copy allowed
+        BitmapFont(const BitmapFont&) = delete;
+        BitmapFont& operator=(const BitmapFont&) = delete;
+
+        /// @brief Rasterizes every glyph into the renderer texture atlas. Does nothing after the first call.
+        void upload(ARenderer* renderer);
+
+        /// @brief Hands the glyph textures to the snapshot, which frees them once its draws are rendered.
+        ///        The font is uploaded again if it is drawn afterwards.
+        void release(RenderSnapshot& snapshot);
+
+        /// @brief Lays out the text, or returns the cached layout. Characters the font does not have are shown as '?'.
+        ///        upload() must have been called. Thread safe.
+        std::shared_ptr<const TextLayout> layout(const std::string& text);
+
+        static constexpr uint32_t ms_GLYPH_SIZE = 8;     // Font pixels per side of a glyph
+        static constexpr char ms_FIRST_CHARACTER = ' ';
+        static constexpr char ms_LAST_CHARACTER = '~';
+
+    private:
+        using LruList = std::list<std::pair<std::string, std::shared_ptr<const TextLayout>>>;
+
+        std::shared_ptr<const TextLayout> buildLayout(const std::string& text) const;
+
+        uint32_t m_glyphScale;
+        ARenderer* m_renderer = nullptr;    // Set once uploaded
+        std::array<renderer_texture_id, ms_LAST_CHARACTER - ms_FIRST_CHARACTER + 1> m_glyphTextures{};
+
+        std::mutex m_cacheMutex;
+        size_t m_layoutCacheCapacity;
+        LruList m_lruLayouts;   // Most recently used first
+        std::unordered_map<std::string, LruList::iterator> m_cachedLayouts;
+    };
+}
+
+#endif
\ No newline at end of file
@@ -5,18 +5,138 @@
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE
 #include <glm/glm.hpp>
 
+#include <vector>
+#include <string>
+
 namespace jate::rendering
 {
+    using renderer_memory_slot_id = uint32_t;
+    using renderer_texture_id = uint32_t;
+    using renderer_particle_system_id = uint32_t;
+
     struct VertexData
     {
         glm::vec3 position;
 		glm::vec3 color;
     };
 
+    /// @brief How a vertex attribute is stored on the GPU. Shaders read floats whatever the format : the conversion is done by the vertex fetch.
+    enum class VertexAttributeFormat : uint8_t
+    {
+        Float32x3,      // 12 bytes, exact
+        Float16x4,      // 8 bytes, half floats : about 3 significant digits. Fine for positions of models, not of large worlds.
+        Unorm8x4,       // 4 bytes, clamped to [0, 1] : colors
+        Snorm8x4,       // 4 bytes, clamped to [-1, 1] : normals and other unit vectors
+    };
+
+    /// @brief Vertex layout of meshes on the GPU. VertexData is converted to it when uploaded.
+    struct VertexLayout
+    {
+        VertexAttributeFormat position = VertexAttributeFormat::Float32x3;
+        VertexAttributeFormat color = VertexAttributeFormat::Float32x3;
+
+        /// @brief 12 bytes per vertex instead of 24 : half float positions, 8 bit colors
+        static constexpr VertexLayout compact() { return {VertexAttributeFormat::Float16x4, VertexAttributeFormat::Unorm8x4}; }
+
+        bool operator==(const VertexLayout&) const = default;
+    };
+
+    /// @brief Per-draw data. Kept under its historical name : the Vulkan renderer reads it from a bindless storage buffer, indexed per draw.
     struct PushConstantData
     {
         glm::mat4 transform;
     };
+
+    struct DrawCommand
+    {
+        renderer_memory_slot_id verticesSlot;
+        renderer_memory_slot_id indicesSlot;
+        PushConstantData pushConstantData;
+    };
+
+    /// @brief A textured quad. Every sprite samples the same texture atlas, so they are all drawn in a single instanced draw.
+    struct SpriteDrawCommand
+    {
+        renderer_texture_id texture;
+        glm::mat4 transform;    // Applied to a unit quad centered on the origin
+        glm::vec4 color;        // Multiplies the texture color
+    };
+
+    /// @brief How particles are combined with what is drawn behind them
+    enum class ParticleBlendMode : uint8_t
+    {
+        Alpha,      // Covers the background, e.g. smoke
+        Additive,   // Brightens the background, e.g. sparks or fire
+    };
+
+    /// @brief Behaviour of a particle emitter, fixed when its particle system is created.
+    ///        Particles spawn around the emitter, move under gravity, and fade from the start to the end color over their lifetime.
+    struct ParticleEmitterSettings
+    {
+        uint32_t maxParticles = 100000;     // GPU memory is allocated for this many particles up front
+        float spawnRate = 10000.f;          // Particles per second. Spawning pauses while every particle is alive.
+        float spawnRadius = 0.01f;          // Particles spawn in a sphere around the emitter
+        glm::vec3 initialVelocity = {0.f, -0.5f, 0.f};
+        float velocitySpread = 0.2f;        // Random offset added to the initial velocity, per axis
+        glm::vec3 gravity = {0.f, 0.5f, 0.f};
+        float minLifetime = 1.f, maxLifetime = 2.f;     // Seconds
+        float startSize = 0.01f, endSize = 0.f;
+        glm::vec4 startColor = {1.f, 0.8f, 0.3f, 1.f};
+        glm::vec4 endColor = {1.f, 0.2f, 0.f, 0.f};
+        ParticleBlendMode blendMode = ParticleBlendMode::Alpha;
+    };
+
+    /// @brief Simulates and draws a particle system for the frame. Systems not drawn in a frame are paused.
+    struct ParticleDrawCommand
+    {
+        renderer_particle_system_id particleSystem;
+        glm::vec3 emitterPosition;
+    };
+
+    /// @brief Everything the renderer needs to draw a frame, extracted from the world by the simulation thread.
+    ///        Once handed to the renderer it is not modified anymore, so it can be rendered on another thread.
+    struct RenderSnapshot
+    {
+        std::vector<DrawCommand> drawCommands;
+        std::vector<SpriteDrawCommand> spriteCommands;
+        std::vector<ParticleDrawCommand> particleCommands;
+
+        // Slots released by the world during this frame. They are freed once the draws above are recorded,
+        // since a snapshot built earlier may still reference them.
+        std::vector<renderer_memory_slot_id> freedVertexSlots;
+        std::vector<renderer_memory_slot_id> freedIndexSlots;
+        std::vector<renderer_particle_system_id> freedParticleSystems;
+        std::vector<renderer_texture_id> freedTextures;
+
+        /// @brief Empties the snapshot, keeping its capacity for the next frame
+        void clear()
+        {
+            drawCommands.clear();
+            spriteCommands.clear();
+            particleCommands.clear();
+            freedVertexSlots.clear();
+            freedIndexSlots.clear();
+            freedParticleSystems.clear();
+            freedTextures.clear();
+        }
+    };
+
+    /// @brief Pixels read back from a rendered frame, tightly packed RGBA8 rows (sRGB encoded)
+    struct FrameCapture
+    {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        std::vector<uint8_t> pixels;
+    };
+
+    /// @brief GPU duration of a named profiling scope, over the last frames, in milliseconds
+    struct GpuScopeTiming
+    {
+        std::string name;
+        double minMs = 0.0;
+        double avgMs = 0.0;
+        double maxMs = 0.0;
+    };
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,59 @@
+#ifndef Jate_RenderThread_H
+#define Jate_RenderThread_H
+
+#include <jate/rendering/renderer.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace jate::rendering
+{
+    /// @brief Renders snapshots on a dedicated thread, so that the main thread can simulate frame N+1 while frame N is recorded and submitted.
+    ///        Holds at most one pending snapshot on top of the one being rendered : the main thread runs one frame ahead at most.
+    class RenderThread
+    {
+    public:
+        RenderThread(ARenderer* renderer);
+
+        /// @brief Renders the pending snapshot, if any, then joins the thread
+        ~RenderThread();
+
+        // No copy allowed
+        RenderThread(const RenderThread&) = delete;
+        RenderThread& operator=(const RenderThread&) = delete;
+
+        /// @brief Hands a snapshot over to the render thread. On success, the snapshot is swapped with an empty one
+        ///        which kept the capacity of a previous frame.
+        /// @param timeout Maximum time to wait for the render thread to take the previous snapshot
+        /// @return false if the render thread is still busy after the timeout, in which case the snapshot is left untouched
+        bool submit(RenderSnapshot& snapshot, std::chrono::milliseconds timeout);
+
+        /// @brief Blocks until every submitted snapshot has been rendered
+        void waitIdle();
+
+    private:
+        void run();
+
+        /// @brief Rethrows on the calling thread an exception raised by the renderer. Must be called with m_mutex locked.
+        void rethrowRenderError();
+
+        ARenderer* m_renderer;
+
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+
+        RenderSnapshot m_pendingSnapshot;       // Submitted, not taken by the render thread yet
+        RenderSnapshot m_renderedSnapshot;      // Only accessed by the render thread
+        bool m_hasPendingSnapshot = false;
+        bool m_isRendering = false;
+        bool m_stopRequested = false;
+        std::exception_ptr m_renderError;
+
+        std::thread m_thread;   // Declared last, so that it starts once every other member is initialized
+    };
+}
+
+#endif
\ No newline at end of file
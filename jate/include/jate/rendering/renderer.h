@@ -4,13 +4,16 @@
 #include <jate/window/window.h>
 
 #include <jate/rendering/data_structs.h>
+#include <jate/rendering/renderer_config.h>
+#include <jate/timing/frame_statistics.h>
 
 #include <jate/models/transform.h>
 
+#include <functional>
+#include <span>
+
 namespace jate::rendering
 {
-    using renderer_memory_slot_id = uint32_t;
-
     class ARenderer
     {
     public:
@@ -23,28 +26,122 @@ namespace jate::rendering
         virtual void beginFrame() = 0;
         virtual void endFrame() = 0;
 
+        /// @brief Renders a whole frame from a snapshot, then frees the slots it releases.
+        ///        Implementations must allow this to run on a dedicated render thread, while the main thread allocates and frees memory.
+        virtual void renderSnapshot(const RenderSnapshot& snapshot)
+        {
+            beginFrame();
+            for (const auto& drawCommand : snapshot.drawCommands)
+            {
+                drawIndexed(drawCommand.verticesSlot, drawCommand.indicesSlot, drawCommand.pushConstantData);
+            }
+            for (const auto& spriteCommand : snapshot.spriteCommands)
+            {
+                drawSprite(spriteCommand);
+            }
+            for (const auto& particleCommand : snapshot.particleCommands)
+            {
+                drawParticles(particleCommand);
+            }
+            endFrame();
+
+            for (auto slotId : snapshot.freedVertexSlots)
+            {
+                freeVertexData(slotId);
+            }
+            for (auto slotId : snapshot.freedIndexSlots)
+            {
+                freeIndexData(slotId);
+            }
+            for (auto particleSystemId : snapshot.freedParticleSystems)
+            {
+                destroyParticleSystem(particleSystemId);
+            }
+            for (auto textureId : snapshot.freedTextures)
+            {
+                freeTexture(textureId);
+            }
+        }
+
         /// @brief Allocates memory to store vertex data. This MUST be freed using the corresponding free() method.
-        /// @param vertices An array of vertex data to be stored in renderer memory
+        ///        Returns without waiting for the GPU : the data is uploaded with the next frame, before anything is drawn.
+        /// @param vertices An array of vertex data to be stored in renderer memory. It is copied once, straight into
+        ///        the staging memory : it can point into a memory mapped file (see assets::MeshAsset).
         /// @return The memory slot id of the allocated data
-        virtual renderer_memory_slot_id allocateVertexData(const std::vector<VertexData>& vertices) = 0;
+        virtual renderer_memory_slot_id allocateVertexData(std::span<const VertexData> vertices) = 0;
 
         /// @brief Frees vertex data at the given slotId
         virtual void freeVertexData(renderer_memory_slot_id slotId) = 0;
 
         /// @brief Allocates memory to store index data. This MUST be freed using the corresponding free() method.
-        /// @param indices An array of index data to be stored in renderer memory
+        /// @param indices An array of index data to be stored in renderer memory. Copied once, like vertices.
         /// @return the memory slot id of the allocated data
-        virtual renderer_memory_slot_id allocateIndexData(const std::vector<uint32_t>& indices) = 0;
+        virtual renderer_memory_slot_id allocateIndexData(std::span<const uint32_t> indices) = 0;
 
         /// @brief Frees index data at the given slotId
         virtual void freeIndexData(renderer_memory_slot_id slotId) = 0;
 
+        /// @brief Calls back once the vertex and index data allocated so far is on the GPU, i.e. once the frame uploading it is done.
+        ///        The callback runs on the thread rendering frames, with renderer resources locked : it must be short, and must not call the renderer.
+        virtual void onUploadsComplete(std::function<void ()> callback) = 0;
+
+        /// @brief Adds an RGBA8 image (sRGB encoded, tightly packed rows) to the texture atlas. The upload happens with the next frame :
+        ///        this returns without waiting for the GPU, and sprites using the texture can be drawn right away.
+        /// @return The texture id, to use in sprite draws. This MUST be freed using freeTexture().
+        virtual renderer_texture_id allocateTexture(uint32_t width, uint32_t height, const std::vector<uint8_t>& pixels) = 0;
+
+        /// @brief Releases the atlas space of a texture right away : snapshots waiting to be rendered must not draw it anymore.
+        ///        While the simulation runs, release textures through RenderSnapshot::freedTextures instead.
+        virtual void freeTexture(renderer_texture_id textureId) = 0;
+
+        /// @brief Records a sprite draw in the current frame. Same threading rules as drawIndexed().
+        ///        Sprites are drawn after meshes, back to front, with alpha blending.
+        virtual void drawSprite(const SpriteDrawCommand& spriteCommand) = 0;
+
+        /// @brief Allocates the GPU state of a particle system. Particles live on the GPU only : they are spawned,
+        ///        simulated and drawn without any per-particle work on the CPU. This MUST be destroyed using destroyParticleSystem().
+        virtual renderer_particle_system_id createParticleSystem(const ParticleEmitterSettings& settings) = 0;
+
+        /// @brief Releases a particle system, once the frames in flight are done with it
+        virtual void destroyParticleSystem(renderer_particle_system_id particleSystemId) = 0;
+
+        /// @brief Simulates a particle system over the time elapsed since the last frame, and draws it.
+        ///        Same threading rules as drawIndexed(). Particles are drawn last, with alpha blending.
+        virtual void drawParticles(const ParticleDrawCommand& particleCommand) = 0;
+
+        /// @brief Records a draw in the current frame. Must be called between beginFrame() and endFrame(), from the thread rendering frames.
         virtual void drawIndexed(renderer_memory_slot_id verticesSlotId, renderer_memory_slot_id indicesSlotId, const PushConstantData& pushConstantData) = 0;
 
+        /// @brief Reads back the last rendered frame. Waits for the GPU to finish that frame.
+        /// @param capture Filled with the frame pixels
+        /// @return Whether the frame could be read back (only supported in headless mode)
+        virtual bool captureLastFrame(FrameCapture& capture) = 0;
+
+        /// @brief Rolling GPU durations of the profiled scopes (whole frame, and each render pass).
+        ///        Compare the "frame" scope with the CPU frame time to know whether rendering is CPU or GPU bound.
+        virtual std::vector<GpuScopeTiming> getGpuTimings() const = 0;
+
+        /// @brief Takes effect at the next frame, by recreating the swap chain. Ignored in headless mode.
+        virtual void setPresentMode(PresentMode presentMode) = 0;
+        /// @brief Takes effect at the next frame, by recreating the swap chain. 0 means minimum supported + 1. Ignored in headless mode.
+        virtual void setSwapChainImageCount(uint32_t imageCount) = 0;
+        /// @brief Takes effect at the next frame. This waits for the GPU to be idle, so it should not be changed every frame.
+        virtual void setFramesInFlight(uint8_t framesInFlight) = 0;
+
+        inline const RendererConfig& getConfig() const { return m_config; }
+        inline bool isHeadless() const { return m_config.headless; }
+
+        /// @brief Fence wait and present times are recorded into the given statistics. Pass nullptr to stop recording.
+        inline void attachFrameStatistics(timing::FrameStatistics* frameStatistics) { m_frameStatistics = frameStatistics; }
+
     protected:
-        ARenderer(Window& window) : m_window(window) {}
+        /// @param window The window to render to, or nullptr in headless mode
+        ARenderer(Window* window, const RendererConfig& config) : m_window(window), m_config(config) {}
         
-        Window& m_window;
+        Window* m_window;
+        RendererConfig m_config;
+
+        timing::FrameStatistics* m_frameStatistics = nullptr;
     };
 }
 
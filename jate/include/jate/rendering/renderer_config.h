@@ -0,0 +1,53 @@
+#ifndef Jate_RendererConfig_H
+#define Jate_RendererConfig_H
+
+#include <jate/rendering/data_structs.h>
+
+#include <stdint.h>
+
+namespace jate::rendering
+{
+    enum class PresentMode
+    {
+        Fifo,           // VSync, never tears. Always supported, used as fallback.
+        FifoRelaxed,    // VSync, but tears instead of waiting when a frame is late
+        Mailbox,        // VSync without blocking : newest frame replaces the queued one. Low latency, high power usage.
+        Immediate       // No VSync, tears. Lowest latency.
+    };
+
+    struct RendererConfig
+    {
+        /// @brief Renders into offscreen images instead of a window swap chain. No display is required.
+        bool headless = false;
+
+        /// @brief Size of the offscreen images. Ignored when rendering to a window, which drives the size itself.
+        uint32_t width = 800;
+        uint32_t height = 600;
+
+        /// @brief Falls back to Fifo if the requested mode is not supported by the surface
+        PresentMode presentMode = PresentMode::Mailbox;
+
+        /// @brief Swap chain image count, clamped to what the surface supports. 0 means minimum supported + 1.
+        uint32_t swapChainImageCount = 0;
+
+        /// @brief Frames the CPU can record ahead of the GPU. 1 minimizes latency, more improves throughput.
+        uint8_t framesInFlight = 2;
+
+        /// @brief Renders without render pass and frame buffer objects when the device supports dynamic rendering
+        ///        (Vulkan 1.3, or VK_KHR_dynamic_rendering). Falls back to render passes otherwise.
+        bool preferDynamicRendering = true;
+
+        /// @brief Width and height of the texture atlas shared by every sprite, in texels
+        uint32_t textureAtlasSize = 2048;
+
+        /// @brief Sizes of the bindless descriptor arrays every texture and storage buffer is accessed through,
+        ///        clamped to the device limits. Running out of slots throws.
+        uint32_t maxBindlessTextures = 1024;
+        uint32_t maxBindlessStorageBuffers = 256;
+
+        /// @brief Layout of mesh vertices on the GPU. VertexLayout::compact() halves vertex bandwidth, at the cost of precision.
+        VertexLayout vertexLayout = {};
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,73 @@
+#ifndef Jate_VulkanBindlessDescriptors_H
+#define Jate_VulkanBindlessDescriptors_H
+
+#include <jate/rendering/vulkan/vulkan_device.h>
+
+#include <vector>
+
+namespace jate::rendering::vulkan
+{
+    /// @brief Index of a resource in the bindless descriptor arrays, passed to shaders through per-instance data or push constants
+    using bindless_index = uint32_t;
+
+    /// @brief A single descriptor set holding every sampled texture and storage buffer of the renderer, in two large arrays :
+    ///        binding 0 for combined image samplers, binding 1 for storage buffers.
+    ///        It is bound once per frame whatever the number of textures or objects on screen, and shaders index into it.
+    ///        Slots are written in place (update after bind), and are only reused once no frame in flight can reference them.
+    class VulkanBindlessDescriptors
+    {
+    public:
+        /// @param maxTextures Size of the texture array, clamped to the device limits
+        /// @param maxStorageBuffers Size of the storage buffer array, clamped to the device limits
+        VulkanBindlessDescriptors(VulkanDevice& device, uint32_t maxTextures, uint32_t maxStorageBuffers);
+        ~VulkanBindlessDescriptors();
+
+        // No copy allowed
+        VulkanBindlessDescriptors(const VulkanBindlessDescriptors&) = delete;
+        VulkanBindlessDescriptors& operator=(const VulkanBindlessDescriptors&) = delete;
+
+        /// @brief Writes the texture in a free slot of the texture array. Throws if the array is full.
+        /// @param imageView Must stay in VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL whenever it is sampled
+        bindless_index addTexture(VkImageView imageView, VkSampler sampler);
+        /// @brief The slot is reused once the frames in flight are done with it
+        void removeTexture(bindless_index index);
+
+        /// @brief Writes the buffer range in a free slot of the storage buffer array. Throws if the array is full.
+        bindless_index addStorageBuffer(VkBuffer buffer, VkDeviceSize offset = 0, VkDeviceSize range = VK_WHOLE_SIZE);
+        /// @brief The slot is reused once the frames in flight are done with it
+        void removeStorageBuffer(bindless_index index);
+
+        inline VkDescriptorSetLayout getDescriptorSetLayout() const { return m_descriptorSetLayout; }
+        inline VkDescriptorSet getDescriptorSet() const { return m_descriptorSet; }
+
+        static constexpr uint32_t ms_TEXTURES_BINDING = 0;
+        static constexpr uint32_t ms_STORAGE_BUFFERS_BINDING = 1;
+
+    private:
+        /// @brief Slots of one descriptor array. Never given back slots are allocated in order, freed ones are reused first.
+        struct SlotAllocator
+        {
+            uint32_t capacity = 0;
+            uint32_t nextUnusedSlot = 0;
+            std::vector<bindless_index> freeSlots;
+        };
+
+        void init_clampToDeviceLimits(uint32_t& maxTextures, uint32_t& maxStorageBuffers) const;
+        void init_createDescriptorSet(uint32_t maxTextures, uint32_t maxStorageBuffers);
+
+        static bindless_index allocateSlot(SlotAllocator& allocator, const char* arrayName);
+        /// @brief Gives the slot back through the deletion queue, so that pending submissions still read the old descriptor
+        void releaseSlotDeferred(SlotAllocator& allocator, bindless_index index);
+
+        VulkanDevice& m_device;
+
+        VkDescriptorSetLayout m_descriptorSetLayout = VK_NULL_HANDLE;
+        VkDescriptorPool m_descriptorPool = VK_NULL_HANDLE;
+        VkDescriptorSet m_descriptorSet = VK_NULL_HANDLE;
+
+        SlotAllocator m_textureSlots;
+        SlotAllocator m_storageBufferSlots;
+    };
+}
+
+#endif
\ No newline at end of file
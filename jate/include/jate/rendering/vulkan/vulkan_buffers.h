@@ -8,8 +8,21 @@
 #include <jate/rendering/vulkan/vulkan_device.h>
 #include <jate/rendering/data_structs.h>
 
+#include <functional>
+#include <span>
+
 namespace jate::rendering::vulkan
 {
+	/// @brief A copy from a filled staging buffer into a device local buffer, left for the owner of a frame to record.
+	///        The staging buffer is released by whoever records the copy.
+	struct VulkanBufferUpload
+	{
+		VkBuffer stagingBuffer;
+		VkDeviceMemory stagingMemory;
+		VkBuffer dstBuffer;
+		VkDeviceSize size;
+	};
+
 	class AVulkanBuffer
 	{
 	public:
@@ -25,43 +38,57 @@ namespace jate::rendering::vulkan
 	protected:
 		AVulkanBuffer(VulkanDevice& device, VkDeviceSize bufferOffset = 0);
 
-		void createStagingBuffer(VkBuffer& outBuffer, VkDeviceMemory& outBufferMemory, const void* bufferData, VkDeviceSize bufferSize);
+		/// @param fillData Writes the bufferSize bytes of the buffer to the mapped staging memory
+		void createStagingBuffer(VkBuffer& outBuffer, VkDeviceMemory& outBufferMemory, VkDeviceSize bufferSize, const std::function<void (void* hostData)>& fillData);
+		/// @brief Creates the device local buffer, filled through a staging buffer
+		/// @param fillData See createStagingBuffer()
+		/// @param deferredUpload If set, the copy is not submitted : it is returned here, to be recorded with a frame.
+		///        Otherwise the copy is submitted, and waited for.
+		void init_createDeviceLocalBuffer(VkDeviceSize bufferSize, VkBufferUsageFlags usage, VulkanBufferUpload* deferredUpload, const std::function<void (void* hostData)>& fillData);
 
 		VulkanDevice& m_device;
 		VkDeviceSize m_bufferOffset = 0;
-		VkBuffer m_buffer;
-		VkDeviceMemory m_bufferMemory;
+		VkBuffer m_buffer = VK_NULL_HANDLE;
+		VkDeviceMemory m_bufferMemory = VK_NULL_HANDLE;
 	};
 
     class VulkanVertexBuffer : public AVulkanBuffer
     {
     public:
-		VulkanVertexBuffer(VulkanDevice& device, const std::vector<VertexData>& vertices, VkDeviceSize bufferOffset = 0);
+		/// @param layout The vertices are converted to it while copied to the staging buffer
+		/// @param deferredUpload See AVulkanBuffer::init_createDeviceLocalBuffer()
+		VulkanVertexBuffer(VulkanDevice& device, std::span<const VertexData> vertices, const VertexLayout& layout = {}, VkDeviceSize bufferOffset = 0, VulkanBufferUpload* deferredUpload = nullptr);
 		virtual ~VulkanVertexBuffer();
 
 		inline uint32_t getVertexCount() const { return m_vertexCount; }
 
-		static std::vector<VkVertexInputBindingDescription> getVertexBindingDescriptions();
-		static std::vector<VkVertexInputAttributeDescription> getVertexAttributeDescriptions();
+		/// @brief Bytes per vertex : attributes are packed one after the other, position first
+		static uint32_t getVertexStride(const VertexLayout& layout);
+		static std::vector<VkVertexInputBindingDescription> getVertexBindingDescriptions(const VertexLayout& layout);
+		static std::vector<VkVertexInputAttributeDescription> getVertexAttributeDescriptions(const VertexLayout& layout);
 
 	private:
-		void init_createVertexBuffer(const std::vector<VertexData>& vertices);
+		void init_createVertexBuffer(std::span<const VertexData> vertices, const VertexLayout& layout, VulkanBufferUpload* deferredUpload);
 
 		uint32_t m_vertexCount;
     };
 
+	/// @brief Stored as 16 bit indices when they all fit, halving index bandwidth : most meshes have less than 65536 vertices
 	class VulkanIndexBuffer : public AVulkanBuffer
 	{
 	public:
-		VulkanIndexBuffer(VulkanDevice& device, const std::vector<uint32_t>& indices, VkDeviceSize bufferOffset = 0);
+		/// @param deferredUpload See AVulkanBuffer::init_createDeviceLocalBuffer()
+		VulkanIndexBuffer(VulkanDevice& device, std::span<const uint32_t> indices, VkDeviceSize bufferOffset = 0, VulkanBufferUpload* deferredUpload = nullptr);
 		virtual ~VulkanIndexBuffer();
 
 		inline uint32_t getIndexCount() const { return m_indexCount; }
+		inline VkIndexType getIndexType() const { return m_indexType; }
 
 	private:
-		void init_createIndexBuffer(const std::vector<uint32_t>& indices);
+		void init_createIndexBuffer(std::span<const uint32_t> indices, VulkanBufferUpload* deferredUpload);
 
 		uint32_t m_indexCount;
+		VkIndexType m_indexType = VK_INDEX_TYPE_UINT32;
 	};
 }
 
@@ -3,8 +3,12 @@
 
 #include <jate/rendering/vulkan/vulkan_device.h>
 #include <jate/rendering/vulkan/vulkan_swapchain.h>
+#include <jate/rendering/vulkan/vulkan_render_target.h>
 #include <jate/rendering/vulkan/vulkan_buffers.h>
 #include <jate/rendering/vulkan/vulkan_pipeline.h>
+#include <jate/rendering/vulkan/vulkan_compute_pipeline.h>
+#include <jate/rendering/vulkan/vulkan_gpu_profiler.h>
+#include <jate/rendering/vulkan/vulkan_timeline_semaphore.h>
 #include <jate/rendering/data_structs.h>
 
 #include <functional>
@@ -26,20 +30,56 @@ namespace jate::rendering::vulkan
         void startRecording();
         void endRecording();
 
-        void cmdStartRenderPass(const VulkanSwapChain& swapChain, uint32_t frameBufferIndex);
+        void cmdStartRenderPass(VkRenderPass renderPass, VkFramebuffer frameBuffer, VkExtent2D extent, const std::vector<VkClearValue>& clearValues);
         void cmdEndRenderPass();
 
+        /// @brief Dynamic rendering equivalent of cmdStartRenderPass(). The device must have dynamic rendering enabled.
+        void cmdBeginRendering(const VkRenderingInfo& renderingInfo);
+        void cmdEndRendering();
+
+        void cmdPipelineBarrier(VkPipelineStageFlags srcStages, VkPipelineStageFlags dstStages,
+            const std::vector<VkImageMemoryBarrier>& imageBarriers, const std::vector<VkBufferMemoryBarrier>& bufferBarriers = {});
+        /// @brief A global memory barrier, covering every resource : cheaper to record than one barrier per buffer
+        void cmdMemoryBarrier(VkPipelineStageFlags srcStages, VkPipelineStageFlags dstStages, VkAccessFlags srcAccess, VkAccessFlags dstAccess);
+
         void cmdBindPipeline(const VulkanPipeline& pipeline);
+        void cmdBindPipeline(const VulkanComputePipeline& pipeline);
         void cmdSetViewport(float x, float y, float width, float height, float minDepth = 0.0f, float maxDepth = 1.0f);
         void cmdSetScissor(VkOffset2D offset, VkExtent2D extent);
         
-        void cmdPushConstants(const PushConstantData& data, VkPipelineLayout pipelineLayout);
+        void cmdPushConstants(VkPipelineLayout pipelineLayout, VkShaderStageFlags stageFlags, uint32_t size, const void* data);
+        void cmdBindDescriptorSet(VkPipelineLayout pipelineLayout, VkDescriptorSet descriptorSet, uint32_t setIndex = 0,
+            VkPipelineBindPoint bindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS);
+        void cmdBindVertexBuffer(VkBuffer buffer, uint32_t binding = 0, VkDeviceSize offset = 0);
+        void cmdDraw(uint32_t vertexCount, uint32_t instanceCount = 1, uint32_t firstVertex = 0, uint32_t firstInstance = 0);
         void cmdDrawVertexBuffer(const VulkanVertexBuffer& vertexBuffer);
-        void cmdDrawIndexedVertexBuffer(const VulkanVertexBuffer& vertexBuffer, const VulkanIndexBuffer& indexBuffer);
+        /// @param firstInstance Instance index of the draw, e.g. to index per-object data in shaders
+        void cmdDrawIndexedVertexBuffer(const VulkanVertexBuffer& vertexBuffer, const VulkanIndexBuffer& indexBuffer, uint32_t firstInstance = 0);
+        /// @brief A single draw, whose VkDrawIndirectCommand is read from the buffer by the GPU
+        void cmdDrawIndirect(VkBuffer buffer, VkDeviceSize offset);
 
-        void cmdCopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size);
+        void cmdDispatch(uint32_t groupCountX, uint32_t groupCountY = 1, uint32_t groupCountZ = 1);
+        /// @brief The VkDispatchIndirectCommand is read from the buffer by the GPU
+        void cmdDispatchIndirect(VkBuffer buffer, VkDeviceSize offset);
 
-        void submit(VkSemaphore waitSemaphore = nullptr, VkSemaphore signalSemaphore = nullptr, VkFence fence = nullptr);
+        void cmdCopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size);
+        /// @brief Copies a color image, which must be in TRANSFER_SRC layout, into a tightly packed buffer readable by the host
+        void cmdCopyImageToBuffer(VkImage srcImage, VkExtent2D extent, VkBuffer dstBuffer);
+        /// @brief The destination image must be in TRANSFER_DST layout
+        void cmdCopyBufferToImage(VkBuffer srcBuffer, VkImage dstImage, const std::vector<VkBufferImageCopy>& regions);
+        /// @brief The source image must be in TRANSFER_SRC layout, and the destination in TRANSFER_DST. Both can be the same image.
+        void cmdBlitImage(VkImage srcImage, VkImage dstImage, const std::vector<VkImageBlit>& regions, VkFilter filter);
+
+        /// @brief Resets the profiler queries of the current frame. Must be recorded before any profile scope, outside of a render pass.
+        void cmdResetProfileQueries(VulkanGpuProfiler& profiler);
+        /// @brief Opens a named GPU timing scope. Scopes can be nested, and are closed in reverse order by cmdEndProfileScope().
+        void cmdBeginProfileScope(VulkanGpuProfiler& profiler, const std::string& name);
+        void cmdEndProfileScope(VulkanGpuProfiler& profiler);
+
+        /// @param timeline If set, signaled to its next value once the command buffer has completed
+        /// @return The timeline value to wait on, 0 if no timeline was given. Throws if the submission fails.
+        uint64_t submit(VkSemaphore waitSemaphore = nullptr, VkSemaphore signalSemaphore = nullptr, VulkanTimelineSemaphore* timeline = nullptr);
+        /// @brief Presents the given swap chain image. Throws a SwapChainOutOfDateException if the swap chain must be recreated.
         void present(const VulkanSwapChain& swapChain, uint32_t* frameBufferIndex, VkSemaphore waitSemaphore = nullptr);
 
     private:
@@ -47,6 +87,8 @@ namespace jate::rendering::vulkan
 
         std::function<void ()> m_onDeleteFn;
 
+        std::vector<uint32_t> m_openProfileScopes;
+
         VulkanDevice& m_device;
 
         Usage m_commandBufferUsage;
@@ -55,7 +97,7 @@ namespace jate::rendering::vulkan
     class VulkanCommandManager
     {
     public:
-        VulkanCommandManager(VulkanDevice& device, VulkanSwapChain& swapChain, uint8_t commandBuffersCount = 1);
+        VulkanCommandManager(VulkanDevice& device, uint8_t commandBuffersCount = 1);
         ~VulkanCommandManager();
 
         // No copy
@@ -71,7 +113,6 @@ namespace jate::rendering::vulkan
         void init_createCommandBuffers(uint8_t amount);
 
         VulkanDevice& m_device;
-        VulkanSwapChain& m_swapChain;
 
         VkCommandPool m_mainCommandPool;
         std::vector<VulkanCommandBuffer> m_mainCommandBuffers;
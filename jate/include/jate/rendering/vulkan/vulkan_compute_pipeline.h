@@ -0,0 +1,28 @@
+#ifndef Jate_VulkanComputePipeline_H
+#define Jate_VulkanComputePipeline_H
+
+#include <jate/rendering/vulkan/vulkan_device.h>
+
+namespace jate::rendering::vulkan
+{
+    /// @brief A pipeline made of a single compute shader
+    class VulkanComputePipeline
+    {
+    public:
+        /// @param compShaderModule, pipelineLayout Not owned by the pipeline
+        VulkanComputePipeline(VulkanDevice& device, VkShaderModule compShaderModule, VkPipelineLayout pipelineLayout, VkPipelineCache pipelineCache = VK_NULL_HANDLE);
+        ~VulkanComputePipeline();
+
+        // No copy allowed
+        VulkanComputePipeline(const VulkanComputePipeline&) = delete;
+        VulkanComputePipeline& operator=(const VulkanComputePipeline&) = delete;
+
+        inline VkPipeline getVkPipeline() const { return m_computePipeline; }
+
+    private:
+        VulkanDevice& m_device;
+        VkPipeline m_computePipeline = VK_NULL_HANDLE;
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,54 @@
+#ifndef Jate_VulkanDeletionQueue_H
+#define Jate_VulkanDeletionQueue_H
+
+#include <jate/rendering/vulkan/vulkan_timeline_semaphore.h>
+
+#include <deque>
+#include <functional>
+
+#include <stdint.h>
+
+namespace jate::rendering::vulkan
+{
+    /// @brief Defers the destruction of GPU resources until no submission can reference them anymore.
+    ///        Each deletion is tagged with the graphics timeline value of the next submission,
+    ///        and released once the timeline has reached that value.
+    class VulkanDeletionQueue
+    {
+    public:
+        /// @param timeline Signaled by every submission that may use the deleted resources
+        VulkanDeletionQueue(const VulkanTimelineSemaphore& timeline);
+        ~VulkanDeletionQueue();
+
+        // No copy allowed
+        VulkanDeletionQueue(const VulkanDeletionQueue&) = delete;
+        VulkanDeletionQueue& operator=(const VulkanDeletionQueue&) = delete;
+
+        /// @brief Schedules a deletion. It will run once the submission being recorded (or the next one,
+        ///        between two frames) has completed on the GPU.
+        void push(std::function<void ()> deleter);
+
+        /// @brief Runs the deletions whose submission has completed. Does not wait.
+        void collect();
+
+        /// @brief Runs every pending deletion. The device must be idle.
+        void flushAll();
+
+    private:
+        struct PendingDeletion
+        {
+            uint64_t timelineValue;
+            std::function<void ()> deleter;
+        };
+
+        /// @brief Runs deletions from the front, while the predicate holds
+        template <typename Predicate>
+        void flushWhile(Predicate predicate);
+
+        const VulkanTimelineSemaphore& m_timeline;
+
+        std::deque<PendingDeletion> m_pendingDeletions;   // Sorted by timeline value, since values only grow
+    };
+}
+
+#endif
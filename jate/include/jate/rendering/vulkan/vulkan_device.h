@@ -2,19 +2,24 @@
 #define Jate_VulkanDevice_H
 
 #include <jate/rendering/vulkan/vulkan_instance.h>
+#include <jate/rendering/vulkan/vulkan_timeline_semaphore.h>
 #include <jate/window/window.h>
 
 #include <optional>
 #include <memory>
+#include <functional>
 
 namespace jate::rendering::vulkan
 {
     class VulkanCommandManager;
+    class VulkanDeletionQueue;
     
     class VulkanDevice
     {
     public:
-        VulkanDevice(const VulkanInstance& instance, Window& window);
+        /// @param window The window to present to, or nullptr for a headless device (no surface, no swap chain support needed)
+        /// @param preferDynamicRendering Enables dynamic rendering if the device supports it, see isDynamicRenderingEnabled()
+        VulkanDevice(const VulkanInstance& instance, Window* window, bool preferDynamicRendering = true);
         ~VulkanDevice();
 
         // No copy allowed
@@ -30,12 +35,32 @@ namespace jate::rendering::vulkan
         };
 
         void attachCommandManager(VulkanCommandManager* commandManager);
+        void attachDeletionQueue(VulkanDeletionQueue* deletionQueue);
+
+        /// @brief Destroys the given buffer and frees its memory once no frame in flight can use it anymore.
+        ///        Falls back to an immediate destruction if no deletion queue is attached.
+        void destroyBufferDeferred(VkBuffer buffer, VkDeviceMemory bufferMemory);
+        /// @brief Runs the given deleter once no frame in flight can use what it releases.
+        ///        Runs it immediately if no deletion queue is attached.
+        void deferDeletion(std::function<void ()> deleter);
 
         inline VkDevice getVkDevice() const { return m_device; }
         inline VkPhysicalDevice getPhysicalDevice() const { return m_physicalDevice; }
         inline QueueFamilyIndices getQueueFamilyIndices() const { return m_queueFamilyIndices; }
         inline VkQueue getGraphicsQueue() const { return m_graphicsQueue; }
         inline VkQueue getPresentQueue() const { return m_presentQueue; }
+        inline bool isHeadless() const { return m_window == nullptr; }
+
+        /// @brief Signaled by every frame submission. Used for frame pacing and deferred deletions.
+        inline VulkanTimelineSemaphore& getGraphicsTimeline() { return *m_graphicsTimeline; }
+        /// @brief Signaled by every upload and read back submission
+        inline VulkanTimelineSemaphore& getTransferTimeline() { return *m_transferTimeline; }
+
+        /// @brief Whether rendering uses vkCmdBeginRendering (core in Vulkan 1.3, or VK_KHR_dynamic_rendering),
+        ///        with pipelines created against attachment formats, instead of render pass and frame buffer objects
+        inline bool isDynamicRenderingEnabled() const { return m_vkCmdBeginRendering != nullptr; }
+        inline PFN_vkCmdBeginRendering getVkCmdBeginRendering() const { return m_vkCmdBeginRendering; }
+        inline PFN_vkCmdEndRendering getVkCmdEndRendering() const { return m_vkCmdEndRendering; }
 
         // Buffer helper functions
         void createBuffer(
@@ -48,13 +73,21 @@ namespace jate::rendering::vulkan
         void copyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size);
 
         uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties);
+        /// @brief Same as findMemoryType(), without throwing when no memory type matches (e.g. lazily allocated memory on desktop GPUs)
+        std::optional<uint32_t> tryFindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties);
 
         VkFormat findSupportedFormat(const std::vector<VkFormat> &candidates, VkImageTiling tiling, VkFormatFeatureFlags features);
+        VkFormat findDepthFormat();
+
+        // Image helper functions
+        void createImageWithInfo(const VkImageCreateInfo &imageInfo, VkMemoryPropertyFlags properties, VkImage &image, VkDeviceMemory &imageMemory);
 
     private:
         // Init functions
         void init_pickPhysicalDevice();
+        void init_checkDynamicRenderingSupport();
         void init_createLogicalDevice();
+        void init_loadDynamicRenderingFunctions();
 
         /// @brief Assigns a score to a physical device.
         ///        A negative score means the device is not suitable for our use.
@@ -68,13 +101,16 @@ namespace jate::rendering::vulkan
         QueueFamilyIndices findQueueFamilies(VkPhysicalDevice device) const;
 
         bool checkDeviceExtensionSupport(VkPhysicalDevice device) const;
+        /// @brief Timeline semaphores are core since Vulkan 1.2, but still an optional feature there
+        bool checkTimelineSemaphoreSupport(VkPhysicalDevice device) const;
+        /// @brief Bindless descriptors need runtime sized, partially bound arrays, updated after being bound (core since Vulkan 1.2)
+        bool checkDescriptorIndexingSupport(VkPhysicalDevice device) const;
+        static bool isDeviceExtensionSupported(VkPhysicalDevice device, const char* extensionName);
 
-        const std::vector<const char*> m_deviceExtensions = {
-            VK_KHR_SWAPCHAIN_EXTENSION_NAME
-        };
+        std::vector<const char*> m_deviceExtensions;
 
         const VulkanInstance& m_instance;
-        Window& m_window;
+        Window* m_window;
 
         VkPhysicalDevice m_physicalDevice;
 
@@ -82,7 +118,23 @@ namespace jate::rendering::vulkan
 
         QueueFamilyIndices m_queueFamilyIndices;
 
-        VulkanCommandManager* m_commandManager;
+        // Dynamic rendering
+        enum class DynamicRenderingSupport
+        {
+            None,
+            Core,       // Vulkan 1.3
+            Extension   // VK_KHR_dynamic_rendering, on Vulkan 1.2
+        };
+        bool m_preferDynamicRendering;
+        DynamicRenderingSupport m_dynamicRenderingSupport = DynamicRenderingSupport::None;
+        PFN_vkCmdBeginRendering m_vkCmdBeginRendering = nullptr;
+        PFN_vkCmdEndRendering m_vkCmdEndRendering = nullptr;
+
+        std::unique_ptr<VulkanTimelineSemaphore> m_graphicsTimeline;
+        std::unique_ptr<VulkanTimelineSemaphore> m_transferTimeline;
+
+        VulkanCommandManager* m_commandManager = nullptr;
+        VulkanDeletionQueue* m_deletionQueue = nullptr;
 
         // Queues
         VkQueue m_graphicsQueue;
@@ -0,0 +1,82 @@
+#ifndef Jate_VulkanGpuProfiler_H
+#define Jate_VulkanGpuProfiler_H
+
+#include <jate/rendering/vulkan/vulkan_device.h>
+#include <jate/rendering/data_structs.h>
+#include <jate/utils/rolling_stats.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace jate::rendering::vulkan
+{
+    /// @brief Measures GPU durations of named scopes with timestamp queries.
+    ///        Each frame in flight owns its query pool, which is only read back once the fence of that frame
+    ///        has been waited on, so collecting results never stalls the CPU.
+    class VulkanGpuProfiler
+    {
+    public:
+        VulkanGpuProfiler(VulkanDevice& device, uint8_t framesInFlight, uint32_t maxScopesPerFrame = 32);
+        ~VulkanGpuProfiler();
+
+        // No copy allowed
+        VulkanGpuProfiler(const VulkanGpuProfiler&) = delete;
+        VulkanGpuProfiler& operator=(const VulkanGpuProfiler&) = delete;
+
+        /// @brief Whether the graphics queue supports timestamps. If not, every call is a no-op.
+        inline bool isSupported() const { return m_supported; }
+
+        /// @brief Reads back the timestamps of the last frame recorded in this frame in flight, and prepares it to be recorded again.
+        ///        Must be called after waiting on the fence of that frame in flight.
+        void beginFrame(uint8_t frameInFlight);
+
+        /// @brief Changes the amount of frames in flight. Pending results are dropped, but rolling timings are kept.
+        ///        The device must be idle.
+        void resize(uint8_t framesInFlight);
+
+        /// @brief Resets the queries of the current frame. Must be recorded outside of any render pass, before any scope.
+        void cmdResetQueries(VkCommandBuffer commandBuffer);
+
+        /// @return The id of the opened scope, to give back to cmdEndScope(), or ms_INVALID_SCOPE if the scope could not be opened
+        uint32_t cmdBeginScope(VkCommandBuffer commandBuffer, const std::string& name);
+        void cmdEndScope(VkCommandBuffer commandBuffer, uint32_t scopeId);
+
+        /// @brief Rolling timings of every scope seen so far, sorted by name
+        std::vector<GpuScopeTiming> getTimings() const;
+
+        static constexpr uint32_t ms_INVALID_SCOPE = UINT32_MAX;
+
+    private:
+        struct Scope
+        {
+            std::string name;
+            bool closed = false;
+        };
+
+        struct FrameQueries
+        {
+            VkQueryPool queryPool = VK_NULL_HANDLE;
+            std::vector<Scope> scopes;     // Scope i uses queries 2*i (begin) and 2*i+1 (end)
+        };
+
+        void init_createQueryPools();
+        void destroyQueryPools();
+
+        void collectResults(FrameQueries& frame);
+
+        VulkanDevice& m_device;
+
+        bool m_supported = false;
+        uint32_t m_maxScopesPerFrame;
+        double m_timestampPeriodNs = 1.0;
+        uint64_t m_timestampMask = UINT64_MAX;
+
+        std::vector<FrameQueries> m_frames;
+        uint8_t m_currentFrameInFlight = 0;
+
+        std::map<std::string, utils::RollingStats> m_scopeStats;
+    };
+}
+
+#endif
\ No newline at end of file
@@ -12,7 +12,8 @@ namespace jate::rendering::vulkan
     class VulkanInstance
     {
     public:
-        VulkanInstance(const std::string& appName);
+        /// @param headless If true, window system extensions are not requested, so no display is needed
+        VulkanInstance(const std::string& appName, bool headless = false);
         ~VulkanInstance();
 
         // Disable copy
@@ -20,6 +21,8 @@ namespace jate::rendering::vulkan
         VulkanInstance& operator=(const VulkanInstance&) = delete;
 
         VkInstance getVkInstance() const { return m_instance; }
+        /// @brief Highest api version usable with this instance. Devices may support less.
+        uint32_t getApiVersion() const { return m_apiVersion; }
 
     private:
         void setupValidationLayerDebugMessenger();
@@ -42,6 +45,11 @@ namespace jate::rendering::vulkan
         VkInstance m_instance;
         VkDebugUtilsMessengerEXT m_debugMessenger;
 
+        bool m_headless;
+
+        uint32_t m_apiVersion = VK_API_VERSION_1_0;
+        static constexpr uint32_t ms_MAX_API_VERSION = VK_API_VERSION_1_3;     // Newest version the engine knows how to use
+
         const std::vector<const char*> m_validationLayers = {
             "VK_LAYER_KHRONOS_validation"
         };
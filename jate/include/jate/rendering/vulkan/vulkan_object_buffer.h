@@ -0,0 +1,64 @@
+#ifndef Jate_VulkanObjectBuffer_H
+#define Jate_VulkanObjectBuffer_H
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+#include <jate/rendering/vulkan/vulkan_device.h>
+#include <jate/rendering/vulkan/vulkan_bindless_descriptors.h>
+
+#include <vector>
+
+namespace jate::rendering::vulkan
+{
+    /// @brief GPU layout of a drawn object, read by the mesh shader from a bindless storage buffer (std430)
+    struct ObjectData
+    {
+        glm::mat4 transform;
+    };
+
+    /// @brief Per-object data of every draw of a frame, indexed by the instance index of each draw.
+    ///        Each frame in flight has its own host visible storage buffer, persistently mapped, registered in the bindless
+    ///        storage buffer array, and grown (under a new slot) when a frame draws more objects than it can hold.
+    class VulkanObjectBuffer
+    {
+    public:
+        VulkanObjectBuffer(VulkanDevice& device, VulkanBindlessDescriptors& bindlessDescriptors, uint8_t framesInFlight);
+        ~VulkanObjectBuffer();
+
+        // No copy allowed
+        VulkanObjectBuffer(const VulkanObjectBuffer&) = delete;
+        VulkanObjectBuffer& operator=(const VulkanObjectBuffer&) = delete;
+
+        /// @brief Writes the objects to the frame storage buffer, in order : the object at index i is read with instance index i.
+        ///        The buffer must not be in use by the GPU anymore : the frame in flight must have been waited on.
+        void upload(uint8_t frameInFlight, const std::vector<ObjectData>& objects);
+
+        /// @brief Slot of the frame storage buffer in the bindless storage buffer array. Only valid after upload().
+        inline bindless_index getBindlessIndex(uint8_t frameInFlight) const { return m_frameBuffers[frameInFlight].bindlessIndex; }
+
+        /// @brief Rebuilds the storage buffers. The device must be idle.
+        void resize(uint8_t framesInFlight);
+
+    private:
+        struct FrameBuffer
+        {
+            VkBuffer buffer = VK_NULL_HANDLE;
+            VkDeviceMemory memory = VK_NULL_HANDLE;
+            void* mappedData = nullptr;
+            uint32_t capacity = 0;
+            bindless_index bindlessIndex = 0;
+        };
+
+        void releaseFrameBuffer(FrameBuffer& frameBuffer);
+
+        static constexpr uint32_t ms_MIN_CAPACITY = 256;
+
+        VulkanDevice& m_device;
+        VulkanBindlessDescriptors& m_bindlessDescriptors;
+        std::vector<FrameBuffer> m_frameBuffers;
+    };
+}
+
+#endif
\ No newline at end of file
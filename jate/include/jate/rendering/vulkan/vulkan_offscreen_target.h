@@ -0,0 +1,47 @@
+#ifndef Jate_VulkanOffscreenTarget_H
+#define Jate_VulkanOffscreenTarget_H
+
+#include <jate/rendering/vulkan/vulkan_device.h>
+#include <jate/rendering/vulkan/vulkan_render_target.h>
+
+#include <vector>
+
+namespace jate::rendering::vulkan
+{
+    /// @brief Render target made of plain device images, used instead of a swap chain in headless mode.
+    ///        Images can be used as transfer sources, so that frames can be read back.
+    class VulkanOffscreenTarget : public AVulkanRenderTarget
+    {
+    public:
+        VulkanOffscreenTarget(VulkanDevice& device, VkExtent2D extent, uint32_t imageCount);
+        ~VulkanOffscreenTarget();
+
+        // Disable copy
+        VulkanOffscreenTarget(const VulkanOffscreenTarget&) = delete;
+        VulkanOffscreenTarget& operator=(const VulkanOffscreenTarget&) = delete;
+
+        inline size_t getImageCount() const override { return m_colorImages.size(); }
+        inline VkFormat getImageFormat() const override { return ms_COLOR_FORMAT; }
+        inline VkExtent2D getExtent() const override { return m_extent; }
+        inline VkImage getImage(uint32_t imageIndex) const override { return m_colorImages[imageIndex]; }
+        inline VkImageView getImageView(uint32_t imageIndex) const override { return m_colorImageViews[imageIndex]; }
+
+    private:
+        // RGBA order makes read back pixels directly usable
+        static constexpr VkFormat ms_COLOR_FORMAT = VK_FORMAT_R8G8B8A8_SRGB;
+
+        // Init methods
+        void init_createColorResources(uint32_t imageCount);
+
+        VkImageView createImageView(VkImage image, VkFormat format, VkImageAspectFlags aspectMask) const;
+
+        VulkanDevice& m_device;
+        VkExtent2D m_extent;
+
+        std::vector<VkImage> m_colorImages;
+        std::vector<VkDeviceMemory> m_colorImageMemorys;
+        std::vector<VkImageView> m_colorImageViews;
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,115 @@
+#ifndef Jate_VulkanParticleSystem_H
+#define Jate_VulkanParticleSystem_H
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+#include <jate/rendering/vulkan/vulkan_device.h>
+#include <jate/rendering/vulkan/vulkan_command_manager.h>
+#include <jate/rendering/vulkan/vulkan_bindless_descriptors.h>
+#include <jate/rendering/data_structs.h>
+
+namespace jate::rendering::vulkan
+{
+    /// @brief GPU layout of the state buffer of a particle system : indirect arguments written by the GPU, and counters (std430)
+    struct ParticleSystemState
+    {
+        VkDispatchIndirectCommand emitArgs;
+        VkDispatchIndirectCommand simulateArgs;
+        VkDrawIndirectCommand drawArgs;     // Instance count : particles alive after the simulation, in the destination list
+        uint32_t deadCount;
+        uint32_t aliveCount;    // Particles in the source list, spawned ones included
+        uint32_t spawnCount;
+    };
+
+    /// @brief Push constants of every particle shader, compute and graphics. Fits the 128 bytes guaranteed by Vulkan.
+    struct ParticlePushConstants
+    {
+        glm::vec4 emitterPositionAndRadius;
+        glm::vec4 initialVelocityAndSpread;
+        glm::vec4 gravityAndDeltaTime;
+        glm::vec4 startColor;
+        glm::vec4 endColor;
+        glm::vec4 lifetimeAndSize;      // Min lifetime, max lifetime, start size, end size
+
+        // Bindless storage buffer slots
+        uint32_t positionsIndex;
+        uint32_t velocitiesIndex;
+        uint32_t sourceListIndex;
+        uint32_t destinationListIndex;
+        uint32_t deadListIndex;
+        uint32_t stateIndex;
+
+        uint32_t requestedSpawnCount;
+        uint32_t seed;
+    };
+
+    /// @brief The GPU state of a particle emitter. Particles are stored as structure of arrays (position and age, velocity and lifetime),
+    ///        and tracked by index lists : a dead list to spawn from, and two alive lists, simulated from one into the other every frame.
+    ///        Survivors are appended to the destination list, which compacts it, and its size is the instance count of the indirect draw.
+    ///        The CPU never reads any of it back : it only decides how many particles to spawn.
+    class VulkanParticleSystem
+    {
+    public:
+        VulkanParticleSystem(VulkanDevice& device, VulkanBindlessDescriptors& bindlessDescriptors, const ParticleEmitterSettings& settings);
+        /// @brief Frames in flight may still simulate or draw the system : the buffers are released once they are done
+        ~VulkanParticleSystem();
+
+        // No copy allowed
+        VulkanParticleSystem(const VulkanParticleSystem&) = delete;
+        VulkanParticleSystem& operator=(const VulkanParticleSystem&) = delete;
+
+        /// @brief Computes the frame parameters : spawned particles, swapped alive lists. Must be called once per frame, before recording.
+        void prepareFrame(const glm::vec3& emitterPosition, float deltaTime, uint32_t seed);
+
+        // Each step must be separated from the previous one by a compute to compute barrier. The compute pipeline of the step,
+        // and the bindless descriptor set, must be bound with a layout made for ParticlePushConstants.
+        /// @brief One invocation : fills the indirect arguments of the next steps
+        void cmdBegin(VulkanCommandBuffer& commandBuffer, VkPipelineLayout pipelineLayout) const;
+        /// @brief Pops spawned particles from the dead list, and appends them to the source list
+        void cmdEmit(VulkanCommandBuffer& commandBuffer, VkPipelineLayout pipelineLayout) const;
+        /// @brief Ages and moves the source list particles : dead ones go back to the dead list, the others to the destination list
+        void cmdSimulate(VulkanCommandBuffer& commandBuffer, VkPipelineLayout pipelineLayout) const;
+        /// @brief One instanced quad per particle of the destination list. The particle graphics pipeline must be bound.
+        void cmdDraw(VulkanCommandBuffer& commandBuffer, VkPipelineLayout pipelineLayout) const;
+
+        inline ParticleBlendMode getBlendMode() const { return m_settings.blendMode; }
+
+        static constexpr uint32_t ms_WORKGROUP_SIZE = 64;     // Must match the local size of the particle compute shaders
+
+    private:
+        struct StorageBuffer
+        {
+            VkBuffer buffer = VK_NULL_HANDLE;
+            VkDeviceMemory memory = VK_NULL_HANDLE;
+            bindless_index bindlessIndex = 0;
+        };
+
+        StorageBuffer createStorageBuffer(VkDeviceSize size, VkBufferUsageFlags extraUsage);
+        void releaseStorageBuffer(StorageBuffer& storageBuffer);
+        void uploadToBuffer(const StorageBuffer& storageBuffer, const void* data, VkDeviceSize size);
+
+        void init_createBuffers();
+        /// @brief Every particle starts dead
+        void init_uploadInitialState();
+
+        void cmdPushConstants(VulkanCommandBuffer& commandBuffer, VkPipelineLayout pipelineLayout) const;
+
+        VulkanDevice& m_device;
+        VulkanBindlessDescriptors& m_bindlessDescriptors;
+        ParticleEmitterSettings m_settings;
+
+        StorageBuffer m_positions;
+        StorageBuffer m_velocities;
+        StorageBuffer m_aliveLists[2];
+        StorageBuffer m_deadList;
+        StorageBuffer m_state;
+
+        uint32_t m_destinationList = 0;     // Alive list written by the last simulation, read by the next one
+        float m_spawnAccumulator = 0.f;     // Fraction of a particle left to spawn
+        ParticlePushConstants m_pushConstants{};
+    };
+}
+
+#endif
\ No newline at end of file
@@ -21,10 +21,21 @@ namespace jate::rendering::vulkan
             std::vector<VkDynamicState> dynamicStateEnables;
             VkPipelineDynamicStateCreateInfo dynamicStateInfo;
 
+            // Vertex input, VulkanVertexBuffer data by default
+            std::vector<VkVertexInputBindingDescription> bindingDescriptions;
+            std::vector<VkVertexInputAttributeDescription> attributeDescriptions;
+
             VkPipelineLayout pipelineLayout = nullptr;
             VkRenderPass renderPass = nullptr;
             uint32_t subpass = 0;
 
+            // Attachment formats, only used with dynamic rendering (when renderPass is null)
+            std::vector<VkFormat> colorAttachmentFormats;
+            VkFormat depthAttachmentFormat = VK_FORMAT_UNDEFINED;
+
+            // Specialization constants, given to both stages : constant_id i takes the i-th value (bool, int or float bits)
+            std::vector<uint32_t> specializationConstants;
+
             PipelineConfigInfo() = default;
             PipelineConfigInfo(const PipelineConfigInfo&) = delete;
             PipelineConfigInfo& operator=(const PipelineConfigInfo&) = delete;
@@ -32,7 +43,11 @@ namespace jate::rendering::vulkan
             static void defaultConfig(PipelineConfigInfo& conf);
         };
         
-        VulkanPipeline(VulkanDevice& device, const std::string& vertFilePath, const std::string& fragFilePath, const PipelineConfigInfo& config);
+        /// @param vertShaderModule, fragShaderModule Not owned by the pipeline, e.g. from a VulkanShaderCache
+        /// @param allowDerivatives Whether other pipelines can be created as derivatives of this one
+        /// @param basePipeline Creates a derivative of it, which drivers may build faster. It must allow derivatives.
+        VulkanPipeline(VulkanDevice& device, VkShaderModule vertShaderModule, VkShaderModule fragShaderModule, const PipelineConfigInfo& config,
+            VkPipelineCache pipelineCache = VK_NULL_HANDLE, bool allowDerivatives = false, VkPipeline basePipeline = VK_NULL_HANDLE);
         ~VulkanPipeline();
 
         // No copy allowed
@@ -42,16 +57,13 @@ namespace jate::rendering::vulkan
         inline VkPipeline getVkPipeline() const { return m_graphicsPipeline; }
 
     private:
-		static std::vector<char> readFile(const std::string& path);
-
-		void createGraphicsPipeline(const std::string& vertFilePath, const std::string& fragFilePath, const PipelineConfigInfo& config);
-		void createShaderModule(const std::vector<char>& shaderCode, VkShaderModule* shaderModule);
+		void createGraphicsPipeline(VkShaderModule vertShaderModule, VkShaderModule fragShaderModule, const PipelineConfigInfo& config, VkPipelineCache pipelineCache,
+			bool allowDerivatives, VkPipeline basePipeline);
 
 		// Variables
 
 		VulkanDevice& m_device; // The device should be loaded in memory as long as the pipeline exists
 		VkPipeline m_graphicsPipeline;
-		VkShaderModule m_vertShaderModule, m_fragShaderModule;
     };
 } 
 
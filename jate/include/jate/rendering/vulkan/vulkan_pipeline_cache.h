@@ -0,0 +1,62 @@
+#ifndef Jate_VulkanPipelineCache_H
+#define Jate_VulkanPipelineCache_H
+
+#include <jate/rendering/vulkan/vulkan_device.h>
+
+#include <string>
+#include <vector>
+
+namespace jate::rendering::vulkan
+{
+    /// @brief Wraps a VkPipelineCache that is loaded from disk at creation and written back on destruction.
+    ///        Cache data is only reused if it was produced by the same device and driver version.
+    class VulkanPipelineCache
+    {
+    public:
+        VulkanPipelineCache(VulkanDevice& device, const std::string& cacheFilePath);
+        ~VulkanPipelineCache();
+
+        // No copy allowed
+        VulkanPipelineCache(const VulkanPipelineCache&) = delete;
+        VulkanPipelineCache& operator=(const VulkanPipelineCache&) = delete;
+
+        inline VkPipelineCache getVkPipelineCache() const { return m_pipelineCache; }
+
+        /// @brief Writes the current content of the cache to disk.
+        /// @return Whether the cache could be written
+        bool save() const;
+
+    private:
+        // Header written in front of the Vulkan cache blob, used to validate the file before handing it to the driver
+        struct FileHeader
+        {
+            uint32_t magic;
+            uint32_t version;
+            uint32_t vendorID;
+            uint32_t deviceID;
+            uint32_t driverVersion;
+            uint8_t pipelineCacheUUID[VK_UUID_SIZE];
+            uint32_t padding;   // Explicit, so that no uninitialized byte is written to the file
+            uint64_t dataSize;
+        };
+
+        static constexpr uint32_t ms_FILE_MAGIC = 0x4A504343;  // "JPCC"
+        static constexpr uint32_t ms_FILE_VERSION = 1;
+
+        void init_createPipelineCache();
+
+        /// @brief Reads the cache file and checks it against the current device
+        /// @return The Vulkan cache blob, or an empty vector if the file is missing or stale
+        std::vector<char> loadCacheData() const;
+
+        FileHeader makeFileHeader() const;
+
+        VulkanDevice& m_device;
+        std::string m_cacheFilePath;
+
+        VkPhysicalDeviceProperties m_deviceProperties;
+        VkPipelineCache m_pipelineCache = VK_NULL_HANDLE;
+    };
+}
+
+#endif
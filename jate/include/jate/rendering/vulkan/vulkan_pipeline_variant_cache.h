@@ -0,0 +1,47 @@
+#ifndef Jate_VulkanPipelineVariantCache_H
+#define Jate_VulkanPipelineVariantCache_H
+
+#include <jate/rendering/vulkan/vulkan_device.h>
+#include <jate/rendering/vulkan/vulkan_pipeline.h>
+#include <jate/rendering/vulkan/vulkan_shader_cache.h>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace jate::rendering::vulkan
+{
+    /// @brief Graphics pipelines created on first use, and kept for the next ones.
+    ///        A variant is identified by its shaders and its whole configuration (blend and depth state, specialization constants...) :
+    ///        asking again for the same one is a lookup. Variants of the same shaders are created as derivatives of the first one.
+    class VulkanPipelineVariantCache
+    {
+    public:
+        /// @param shaderCache, pipelineCache Must outlive the variant cache
+        VulkanPipelineVariantCache(VulkanDevice& device, VulkanShaderCache& shaderCache, VkPipelineCache pipelineCache = VK_NULL_HANDLE);
+
+        // No copy allowed
+        VulkanPipelineVariantCache(const VulkanPipelineVariantCache&) = delete;
+        VulkanPipelineVariantCache& operator=(const VulkanPipelineVariantCache&) = delete;
+
+        /// @brief Creates the variant if it does not exist yet. Throws if it can't be created.
+        /// @return Valid until the cache is destroyed
+        /// @param vertShader, fragShader Names known by the shader cache, e.g. "simple.vert"
+        VulkanPipeline& getPipeline(const std::string& vertShader, const std::string& fragShader, const VulkanPipeline::PipelineConfigInfo& config);
+
+        inline size_t getVariantCount() const { return m_pipelines.size(); }
+
+    private:
+        /// @brief Every field of the configuration that ends up in the pipeline, as bytes
+        static std::string makeKey(const std::string& vertShader, const std::string& fragShader, const VulkanPipeline::PipelineConfigInfo& config);
+
+        VulkanDevice& m_device;
+        VulkanShaderCache& m_shaderCache;
+        VkPipelineCache m_pipelineCache;
+
+        std::unordered_map<std::string, std::unique_ptr<VulkanPipeline>> m_pipelines;
+        std::unordered_map<std::string, VkPipeline> m_basePipelines;     // First variant created for each pair of shaders
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,279 @@
+#ifndef Jate_VulkanRenderGraph_H
+#define Jate_VulkanRenderGraph_H
+
+#include <jate/rendering/vulkan/vulkan_device.h>
+#include <jate/rendering/vulkan/vulkan_command_manager.h>
+#include <jate/rendering/vulkan/vulkan_gpu_profiler.h>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace jate::rendering::vulkan
+{
+    struct RenderGraphImage
+    {
+        uint32_t index = UINT32_MAX;
+    };
+
+    struct RenderGraphBuffer
+    {
+        uint32_t index = UINT32_MAX;
+    };
+
+    /// @brief How a resource is accessed : its layout (images only), the pipeline stages using it, and the access types
+    struct RenderGraphResourceState
+    {
+        VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+        VkPipelineStageFlags stages = 0;
+        VkAccessFlags access = 0;
+    };
+
+    enum class RenderGraphPassType
+    {
+        Graphics,   // Runs inside a render pass built from its attachments
+        Compute,
+        Transfer
+    };
+
+    class VulkanRenderGraph;
+
+    /// @brief A node of the render graph. Declares the resources it uses, and records its commands in the execute function.
+    class VulkanRenderGraphPass
+    {
+    public:
+        using ExecuteFunction = std::function<void (VulkanCommandBuffer& commandBuffer)>;
+
+        // Attachments, for graphics passes. Every attachment must have the same extent.
+        void addColorAttachment(RenderGraphImage image, VkAttachmentLoadOp loadOp, VkClearColorValue clearColor = {});
+        void setDepthAttachment(RenderGraphImage image, VkAttachmentLoadOp loadOp, float clearDepth = 1.f);
+
+        void readImage(RenderGraphImage image, VkImageLayout layout, VkPipelineStageFlags stages, VkAccessFlags access);
+        void writeImage(RenderGraphImage image, VkImageLayout layout, VkPipelineStageFlags stages, VkAccessFlags access);
+        void readBuffer(RenderGraphBuffer buffer, VkPipelineStageFlags stages, VkAccessFlags access);
+        void writeBuffer(RenderGraphBuffer buffer, VkPipelineStageFlags stages, VkAccessFlags access);
+
+        /// @brief The pass is never culled, even if nothing reads what it writes (e.g. it writes to host visible memory)
+        inline void setHasSideEffects() { m_hasSideEffects = true; }
+
+        inline void setExecuteFunction(ExecuteFunction executeFunction) { m_executeFunction = std::move(executeFunction); }
+
+        inline const std::string& getName() const { return m_name; }
+        inline RenderGraphPassType getType() const { return m_type; }
+        inline bool isCulled() const { return m_culled; }
+
+        /// @brief Render pass built by VulkanRenderGraph::compile(), for graphics passes. Pipelines used in this pass must be compatible with it.
+        ///        VK_NULL_HANDLE with dynamic rendering : pipelines are then created against the attachment formats.
+        inline VkRenderPass getRenderPass() const { return m_renderPass; }
+        /// @brief Set by VulkanRenderGraph::compile()
+        inline const std::vector<VkFormat>& getColorAttachmentFormats() const { return m_colorAttachmentFormats; }
+        inline VkFormat getDepthAttachmentFormat() const { return m_depthAttachmentFormat; }
+
+    private:
+        friend class VulkanRenderGraph;
+
+        VulkanRenderGraphPass(std::string name, RenderGraphPassType type) : m_name(std::move(name)), m_type(type) {}
+
+        struct ResourceUse
+        {
+            bool isBuffer;
+            uint32_t index;
+            RenderGraphResourceState state;
+            bool write;
+        };
+
+        struct Attachment
+        {
+            uint32_t imageIndex;
+            VkAttachmentLoadOp loadOp;
+            VkAttachmentStoreOp storeOp = VK_ATTACHMENT_STORE_OP_STORE;     // Set by compile()
+            VkClearValue clearValue;
+        };
+
+        struct ImageBarrier
+        {
+            uint32_t imageIndex;
+            VkImageLayout oldLayout;
+            VkImageLayout newLayout;
+            VkAccessFlags srcAccess;
+            VkAccessFlags dstAccess;
+        };
+
+        struct BufferBarrier
+        {
+            uint32_t bufferIndex;
+            VkAccessFlags srcAccess;
+            VkAccessFlags dstAccess;
+        };
+
+        /// @brief Every barrier needed before a pass, recorded as a single vkCmdPipelineBarrier
+        struct BarrierBatch
+        {
+            VkPipelineStageFlags srcStages = 0;
+            VkPipelineStageFlags dstStages = 0;
+            std::vector<ImageBarrier> imageBarriers;
+            std::vector<BufferBarrier> bufferBarriers;
+
+            bool isEmpty() const { return srcStages == 0 && dstStages == 0; }
+        };
+
+        void addUse(bool isBuffer, uint32_t index, RenderGraphResourceState state, bool write);
+
+        std::string m_name;
+        RenderGraphPassType m_type;
+        bool m_hasSideEffects = false;
+        ExecuteFunction m_executeFunction;
+
+        std::vector<ResourceUse> m_uses;
+        std::vector<Attachment> m_colorAttachments;
+        std::optional<Attachment> m_depthAttachment;
+
+        // Compiled state
+        bool m_culled = false;
+        BarrierBatch m_barriers;
+        std::vector<VkFormat> m_colorAttachmentFormats;
+        VkFormat m_depthAttachmentFormat = VK_FORMAT_UNDEFINED;
+        VkRenderPass m_renderPass = VK_NULL_HANDLE;     // Render pass path only
+        std::map<std::vector<VkImageView>, VkFramebuffer> m_frameBuffers;     // Imported views change between frames
+    };
+
+    /// @brief Describes a frame as passes using images and buffers. Once compiled, the graph :
+    ///        - culls passes whose results are never used,
+    ///        - inserts one batched pipeline barrier before each pass, only for the resources that need one,
+    ///        - allocates transient images, sharing memory between images whose lifetimes do not overlap.
+    ///          Images only used as attachments of a single pass are created as transient attachments, backed by lazily
+    ///          allocated memory where the device supports it : tile based GPUs then keep them in tile memory only,
+    ///        - builds the render pass of each graphics pass, with store ops derived from later uses.
+    ///          With dynamic rendering, no render pass nor frame buffer is created : attachments are given when recording.
+    ///        Passes run in declaration order, so a pass must be added after the passes producing what it reads.
+    ///        A compiled graph is executed every frame, and rebuilt only when its resources change (e.g. on resize).
+    class VulkanRenderGraph
+    {
+    public:
+        VulkanRenderGraph(VulkanDevice& device);
+        ~VulkanRenderGraph();
+
+        // No copy allowed
+        VulkanRenderGraph(const VulkanRenderGraph&) = delete;
+        VulkanRenderGraph& operator=(const VulkanRenderGraph&) = delete;
+
+        /// @brief Declares an image owned outside of the graph. Its VkImage can change every frame, through setImportedImage().
+        /// @param initialState State of the image when the graph starts executing. Its stages are waited on before the first use.
+        /// @param finalState State the image is left in when the graph is done
+        RenderGraphImage importImage(const std::string& name, VkFormat format, VkExtent2D extent,
+            RenderGraphResourceState initialState, RenderGraphResourceState finalState);
+        void setImportedImage(RenderGraphImage image, VkImage vkImage, VkImageView vkImageView);
+
+        /// @brief Declares an image created by the graph, only valid during the frame. Its content does not survive between frames,
+        ///        so a single image is shared by every frame in flight.
+        RenderGraphImage createTransientImage(const std::string& name, VkFormat format, VkExtent2D extent);
+
+        RenderGraphBuffer importBuffer(const std::string& name, VkBuffer vkBuffer, RenderGraphResourceState initialState);
+        void setImportedBuffer(RenderGraphBuffer buffer, VkBuffer vkBuffer);
+
+        /// @brief The returned reference stays valid as long as the graph exists
+        VulkanRenderGraphPass& addPass(const std::string& name, RenderGraphPassType type);
+
+        /// @brief Must be called once every pass is declared, and before the first execute()
+        void compile();
+
+        /// @brief Records every pass that was not culled. Opens a GPU profiler scope per pass, if a profiler is given.
+        void execute(VulkanCommandBuffer& commandBuffer, VulkanGpuProfiler* profiler = nullptr);
+
+        inline size_t getCulledPassCount() const { return m_passes.size() - m_compiledPasses.size(); }
+
+        /// @brief Device memory used by transient images, with and without aliasing
+        inline VkDeviceSize getTransientMemorySize() const { return m_transientMemorySize; }
+        inline VkDeviceSize getUnaliasedTransientMemorySize() const { return m_unaliasedTransientMemorySize; }
+        /// @brief Part of the transient memory which is lazily allocated : the driver may never commit it
+        inline VkDeviceSize getLazilyAllocatedMemorySize() const { return m_lazilyAllocatedMemorySize; }
+
+    private:
+        struct ImageResource
+        {
+            std::string name;
+            VkFormat format;
+            VkExtent2D extent;
+            VkImageAspectFlags aspect;
+            bool imported;
+
+            RenderGraphResourceState initialState;     // Imported only
+            RenderGraphResourceState finalState;       // Imported only
+
+            VkImage image = VK_NULL_HANDLE;
+            VkImageView imageView = VK_NULL_HANDLE;
+
+            // Transient only
+            VkImageUsageFlags usage = 0;
+            size_t firstUse = SIZE_MAX;     // Index in m_compiledPasses
+            size_t lastUse = 0;
+            VkPipelineStageFlags usedStages = 0;
+            VkAccessFlags writeAccess = 0;
+            bool attachmentOnly = false;    // Only used as an attachment of a single pass : never loaded nor stored
+            int32_t memoryBlock = -1;
+        };
+
+        struct BufferResource
+        {
+            std::string name;
+            VkBuffer buffer;
+            RenderGraphResourceState initialState;
+        };
+
+        struct MemoryBlock
+        {
+            VkDeviceSize size = 0;
+            uint32_t memoryTypeBits = UINT32_MAX;
+            bool attachmentOnly = false;    // Lazily allocated memory can only back transient attachments
+            std::vector<uint32_t> images;   // Sorted by first use
+            VkDeviceMemory memory = VK_NULL_HANDLE;
+        };
+
+        /// @brief Synchronization state of a resource, while walking through the compiled passes
+        struct TrackedState
+        {
+            VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+            VkPipelineStageFlags writeStages = 0;
+            VkAccessFlags writeAccess = 0;
+            VkPipelineStageFlags readStages = 0;        // Reads since the last write
+            VkPipelineStageFlags visibleStages = 0;     // Stages the last write has been made visible to
+            VkAccessFlags visibleAccess = 0;
+        };
+
+        // Compilation steps
+        void compile_cullPasses();
+        void compile_computeTransientUsage();
+        void compile_allocateTransientImages();
+        void compile_computeBarriers();
+        void compile_createRenderPasses();
+
+        static void trackUse(TrackedState& tracked, const RenderGraphResourceState& use, bool write, bool isImage, VulkanRenderGraphPass::BarrierBatch& batch, uint32_t index);
+        void recordBarriers(VulkanCommandBuffer& commandBuffer, const VulkanRenderGraphPass::BarrierBatch& batch) const;
+        VkFramebuffer getFrameBuffer(VulkanRenderGraphPass& pass);
+        void beginGraphicsPass(VulkanCommandBuffer& commandBuffer, VulkanRenderGraphPass& pass);
+        void endGraphicsPass(VulkanCommandBuffer& commandBuffer) const;
+
+        void destroyResources();
+
+        VulkanDevice& m_device;
+        bool m_useDynamicRendering;
+
+        std::vector<std::unique_ptr<VulkanRenderGraphPass>> m_passes;
+        std::vector<VulkanRenderGraphPass*> m_compiledPasses;
+        std::vector<ImageResource> m_images;
+        std::vector<BufferResource> m_buffers;
+        std::vector<MemoryBlock> m_memoryBlocks;
+
+        VulkanRenderGraphPass::BarrierBatch m_finalBarriers;   // Moves imported images to their final state
+
+        VkDeviceSize m_transientMemorySize = 0;
+        VkDeviceSize m_unaliasedTransientMemorySize = 0;
+        VkDeviceSize m_lazilyAllocatedMemorySize = 0;
+        bool m_compiled = false;
+    };
+}
+
+#endif
\ No newline at end of file
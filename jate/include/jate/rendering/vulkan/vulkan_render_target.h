@@ -0,0 +1,27 @@
+#ifndef Jate_VulkanRenderTarget_H
+#define Jate_VulkanRenderTarget_H
+
+#include <jate/rendering/vulkan/vulkan_device.h>
+
+namespace jate::rendering::vulkan
+{
+    /// @brief A set of color images that frames can be rendered into, one of them per frame.
+    ///        Implemented by the window swap chain and by offscreen targets for headless rendering.
+    ///        Render passes and frame buffers are built by the render graph, which imports the current image.
+    class AVulkanRenderTarget
+    {
+    public:
+        virtual ~AVulkanRenderTarget() {}
+
+        virtual VkFormat getImageFormat() const = 0;
+        virtual VkExtent2D getExtent() const = 0;
+        virtual size_t getImageCount() const = 0;
+        virtual VkImage getImage(uint32_t imageIndex) const = 0;
+        virtual VkImageView getImageView(uint32_t imageIndex) const = 0;
+
+    protected:
+        AVulkanRenderTarget() = default;
+    };
+}
+
+#endif
\ No newline at end of file
@@ -6,10 +6,26 @@
 #include <jate/rendering/vulkan/vulkan_instance.h>
 #include <jate/rendering/vulkan/vulkan_device.h>
 #include <jate/rendering/vulkan/vulkan_swapchain.h>
+#include <jate/rendering/vulkan/vulkan_offscreen_target.h>
 #include <jate/rendering/vulkan/vulkan_pipeline.h>
+#include <jate/rendering/vulkan/vulkan_pipeline_cache.h>
+#include <jate/rendering/vulkan/vulkan_pipeline_variant_cache.h>
+#include <jate/rendering/vulkan/vulkan_shader_cache.h>
+#include <jate/rendering/vulkan/vulkan_shader_hot_reloader.h>
 #include <jate/rendering/vulkan/vulkan_command_manager.h>
-
+#include <jate/rendering/vulkan/vulkan_deletion_queue.h>
+#include <jate/rendering/vulkan/vulkan_gpu_profiler.h>
+#include <jate/rendering/vulkan/vulkan_render_graph.h>
+#include <jate/rendering/vulkan/vulkan_bindless_descriptors.h>
+#include <jate/rendering/vulkan/vulkan_object_buffer.h>
+#include <jate/rendering/vulkan/vulkan_texture_atlas.h>
+#include <jate/rendering/vulkan/vulkan_sprite_batch.h>
+#include <jate/rendering/vulkan/vulkan_particle_system.h>
+
+#include <array>
+#include <chrono>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 
 namespace jate::rendering::vulkan
@@ -17,52 +33,178 @@ namespace jate::rendering::vulkan
     class VulkanRenderer : public ARenderer
     {
     public:
-        VulkanRenderer(Window& window);
+        /// @param window The window to present to. Must be nullptr if, and only if, config.headless is set.
+        VulkanRenderer(Window* window, const RendererConfig& config = {});
         ~VulkanRenderer();
 
 
-        virtual renderer_memory_slot_id allocateVertexData(const std::vector<VertexData>& vertices) override;
+        virtual renderer_memory_slot_id allocateVertexData(std::span<const VertexData> vertices) override;
         virtual void freeVertexData(renderer_memory_slot_id slotId);
 
-        virtual renderer_memory_slot_id allocateIndexData(const std::vector<uint32_t>& indices) override;
+        virtual renderer_memory_slot_id allocateIndexData(std::span<const uint32_t> indices) override;
         virtual void freeIndexData(renderer_memory_slot_id slotId);
 
+        virtual void onUploadsComplete(std::function<void ()> callback) override;
+
         virtual void drawIndexed(renderer_memory_slot_id verticesSlotId, renderer_memory_slot_id indicesSlotId, const PushConstantData& pushConstantData) override;
 
+        virtual renderer_texture_id allocateTexture(uint32_t width, uint32_t height, const std::vector<uint8_t>& pixels) override;
+        virtual void freeTexture(renderer_texture_id textureId) override;
+        virtual void drawSprite(const SpriteDrawCommand& spriteCommand) override;
+
+        virtual renderer_particle_system_id createParticleSystem(const ParticleEmitterSettings& settings) override;
+        virtual void destroyParticleSystem(renderer_particle_system_id particleSystemId) override;
+        virtual void drawParticles(const ParticleDrawCommand& particleCommand) override;
+
+        virtual void renderSnapshot(const RenderSnapshot& snapshot) override;
+
+        virtual bool captureLastFrame(FrameCapture& capture) override;
+
+        virtual std::vector<GpuScopeTiming> getGpuTimings() const override;
+
+        virtual void setPresentMode(PresentMode presentMode) override;
+        virtual void setSwapChainImageCount(uint32_t imageCount) override;
+        virtual void setFramesInFlight(uint8_t framesInFlight) override;
+
     private:
-        void init_createSwapChain();
+        void init_createRenderTarget();
+        /// @brief Builds the frame graph for the current render target. Must be called again whenever the render target is recreated.
+        void init_createRenderGraph();
         void init_createCommandManager();
+        void init_createBindlessResources();
+        /// @brief The layout shared by every pipeline : the bindless set, and the frame push constants
         void init_createPipelineLayout();
+        void init_createSpriteResources();
+        /// @brief The particle pipeline layout, and the compute pipelines simulating particles
+        void init_createParticleResources();
+        void init_createParticleComputePipelines();
+        /// @brief Starts a new variant cache, against the attachments of the main pass, and creates the mesh and sprite pipelines
+        ///        and the particle pipelines in use
         void init_createPipeline();
+        /// @brief Default configuration, rendering to the attachments of the main pass
+        void fillMainPassPipelineConfig(VulkanPipeline::PipelineConfigInfo& config, VkPipelineLayout pipelineLayout) const;
+        /// @brief Created the first time a particle system uses the blend mode
+        VulkanPipeline& getParticlePipeline(ParticleBlendMode blendMode);
         void init_createSyncObjects();
-
-        void recreateSwapChain();
+        void destroySyncObjects();
+
+        /// @return false if the window is minimized : the swap chain is left untouched, and the frame must be skipped
+        bool recreateSwapChain();
+        /// @brief Rebuilds every per-frame-in-flight resource. Waits for the device to be idle.
+        void applyFramesInFlightChange();
+        /// @brief Replaces every graphics pipeline, e.g. after a color format change. The previous ones are destroyed once the frames
+        ///        using them are done, or kept if the new ones can't be created.
+        /// @return Whether the pipelines were replaced
+        bool rebuildGraphicsPipelines();
+        /// @brief Swaps in the shaders recompiled by the hot reloader, and rebuilds the pipelines using them.
+        ///        Previous pipelines are kept if the new ones can't be created.
+        void applyShaderReloads();
+
+        /// @brief Copies the vertex and index data allocated since the last frame, before the graph draws it
+        void recordPendingBufferUploads(VulkanCommandBuffer& commandBuffer);
+
+        /// @brief Spawns and simulates the particle systems of the frame, before the graph draws them.
+        ///        Each step is recorded for every system at once, so that systems share the barriers between steps.
+        void recordParticleSimulation(VulkanCommandBuffer& commandBuffer);
+
+        /// @brief The swap chain, or the offscreen target in headless mode
+        AVulkanRenderTarget& getRenderTarget() const;
 
         virtual void beginFrame() override;
         virtual void endFrame() override;
 
         VulkanInstance m_vulkanInstance;
         VulkanDevice m_vulkanDevice;
+        VulkanDeletionQueue m_deletionQueue;   // Declared right after the device, so that it is flushed after every other resource is released
         std::unique_ptr<VulkanSwapChain> m_vulkanSwapChain;
+        std::unique_ptr<VulkanOffscreenTarget> m_offscreenTarget;     // Replaces the swap chain in headless mode
         std::unique_ptr<VulkanCommandManager> m_vulkanCommandManager;
 
-        std::unique_ptr<VulkanPipeline> m_vulkanPipeline;
+        std::unique_ptr<VulkanRenderGraph> m_renderGraph;
+        RenderGraphImage m_colorTarget;     // The current render target image, imported every frame
+        VulkanRenderGraphPass* m_mainPass = nullptr;
+        std::vector<DrawCommand> m_frameDrawCommands;     // Recorded by the main pass, when the graph is executed
+        std::vector<ObjectData> m_frameObjects;     // One per draw command, uploaded to the object buffer before the graph is executed
+        std::vector<SpriteInstanceData> m_frameSpriteInstances;     // Uploaded to the sprite batch before the graph is executed
+
+        // Shared by every pipeline creation, persisted on disk between runs
+        VulkanPipelineCache m_vulkanPipelineCache;
+        // Shader modules are created once, and reused when pipelines are rebuilt for a new color format
+        VulkanShaderCache m_shaderCache;
+        std::unique_ptr<VulkanShaderHotReloader> m_shaderHotReloader;     // Only built with JATE_SHADER_HOT_RELOAD
+
+        VulkanGpuProfiler m_gpuProfiler;
+
+        // Bindless resources : the descriptor set is bound once per frame, shaders find their data through indices.
+        // Destroyed after the deletion queue is flushed, since deferred deletions give their slots back.
+        std::unique_ptr<VulkanBindlessDescriptors> m_bindlessDescriptors;
+        std::unique_ptr<VulkanObjectBuffer> m_objectBuffer;
+
+        /// @brief Pushed once per frame, for every pipeline
+        struct FramePushConstants
+        {
+            bindless_index objectBufferIndex;   // Storage buffer slot of the frame object data
+        };
+
+        // Every graphics pipeline, owned by the variant cache. Replaced as a whole when they must be rebuilt.
+        std::unique_ptr<VulkanPipelineVariantCache> m_pipelineVariants;
+        VulkanPipeline* m_vulkanPipeline = nullptr;
         VkPipelineLayout m_pipelineLayout;
-
-        // Sync objects
+        VkFormat m_pipelineColorFormat = VK_FORMAT_UNDEFINED;    // Color format of the render pass the current pipelines were built against
+
+        // Sprites : every texture lives in one atlas, and every sprite of a frame is drawn by a single instanced draw
+        std::unique_ptr<VulkanTextureAtlas> m_textureAtlas;
+        std::unique_ptr<VulkanSpriteBatch> m_spriteBatch;
+        VulkanPipeline* m_spritePipeline = nullptr;
+
+        // Particles : simulated by compute shaders at the start of the frame, drawn last in the main pass
+        VkPipelineLayout m_particlePipelineLayout;     // The bindless set, and ParticlePushConstants for every stage
+        std::unique_ptr<VulkanComputePipeline> m_particleBeginPipeline;
+        std::unique_ptr<VulkanComputePipeline> m_particleEmitPipeline;
+        std::unique_ptr<VulkanComputePipeline> m_particleSimulatePipeline;
+        std::array<VulkanPipeline*, 2> m_particlePipelines{};     // Per ParticleBlendMode, null until first used
+        std::unordered_map<renderer_particle_system_id, std::unique_ptr<VulkanParticleSystem>> m_particleSystems;
+        std::unordered_map<renderer_particle_system_id, glm::vec3> m_frameParticleEmitters;    // Emitter position of each system drawn this frame
+        std::vector<VulkanParticleSystem*> m_frameParticleSystems;     // Simulated, then drawn by the main pass
+        uint32_t m_particleSeed = 0;
+
+        // Time step of the particle simulation, measured between frames
+        std::chrono::steady_clock::time_point m_lastFrameStart = std::chrono::steady_clock::now();
+        float m_frameDeltaTime = 0.f;
+
+        // Sync objects. Acquire and present only accept binary semaphores : everything else uses the device graphics timeline.
         std::vector<VkSemaphore> m_imageAvailableSemaphores;
         std::vector<VkSemaphore> m_renderFinishedSemaphores;
-        std::vector<VkFence> m_inFlightFences;
+        std::vector<uint64_t> m_frameTimelineValues;    // Graphics timeline value signaled by the last submission of each frame in flight
 
         uint32_t m_currentImageIndex;
+        bool m_frameSkipped = false;    // Nothing is recorded nor submitted while the window is minimized
         VulkanCommandBuffer* m_currentFrameCommandBuffer = nullptr;
 
-        const uint8_t MAX_FRAMES_IN_FLIGHT = 2;
+        uint8_t m_framesInFlight;    // Currently in use, m_config holds the requested value
         uint8_t m_currentFrameInFlight = 0;
 
+        // Settings changed at runtime (or an out of date swap chain), applied at the start of the next frame
+        bool m_swapChainNeedsRecreation = false;
+        bool m_framesInFlightChanged = false;
+
+        // Last submitted frame, used for read back
+        bool m_hasSubmittedFrame = false;
+        uint64_t m_lastSubmittedTimelineValue = 0;
+        uint32_t m_lastSubmittedImageIndex = 0;
+
+        // Guards everything shared between the thread rendering frames and the thread allocating memory :
+        // memory slots, the deletion queue, the command pool, the graphics queue and runtime settings.
+        // Not held while waiting on the frame timeline, so that allocations are not delayed by the GPU.
+        mutable std::mutex m_resourceMutex;
+
         // Renderer memory slots
         std::unordered_map<renderer_memory_slot_id, std::unique_ptr<VulkanVertexBuffer>> m_vertexBufferSlots;
         std::unordered_map<renderer_memory_slot_id, std::unique_ptr<VulkanIndexBuffer>> m_indexBufferSlots;
+
+        // Slot buffers are filled by the next frame, allocations never wait for the GPU
+        std::vector<VulkanBufferUpload> m_pendingBufferUploads;
+        std::vector<std::function<void ()>> m_pendingUploadCallbacks;     // Run once the frame recording the pending uploads is done
     };
 }
 
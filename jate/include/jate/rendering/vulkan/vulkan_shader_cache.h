@@ -0,0 +1,59 @@
+#ifndef Jate_VulkanShaderCache_H
+#define Jate_VulkanShaderCache_H
+
+#include <jate/rendering/vulkan/vulkan_device.h>
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace jate::rendering::vulkan
+{
+    /// @brief Owns a VkShaderModule per shader, created the first time a pipeline asks for it.
+    ///        The SPIR-V code is embedded in the library at build time : no file is read at runtime.
+    class VulkanShaderCache
+    {
+    public:
+        /// @brief A shader of jate/shaders, compiled by glslc
+        struct EmbeddedShader
+        {
+            std::string_view name;      // Source file name, e.g. "simple.vert"
+            std::span<const uint32_t> code;
+        };
+
+        VulkanShaderCache(VulkanDevice& device);
+        ~VulkanShaderCache();
+
+        // No copy allowed
+        VulkanShaderCache(const VulkanShaderCache&) = delete;
+        VulkanShaderCache& operator=(const VulkanShaderCache&) = delete;
+
+        /// @brief Modules stay valid until the cache is destroyed, or the shader reloaded : pipelines rebuilt later reuse them.
+        ///        Throws if no shader has this name.
+        /// @param name Source file name, e.g. "simple.vert"
+        VkShaderModule getShaderModule(const std::string& name);
+
+        /// @brief Replaces the module of a shader with new code, e.g. recompiled by VulkanShaderHotReloader.
+        ///        Pipelines must be rebuilt to use it. Throws if the module can't be created : the previous one is kept.
+        ///        The previous module is also kept until commitReload() or revertReload() is called.
+        void reloadShader(const std::string& name, std::span<const uint32_t> code);
+        /// @brief Destroys the module replaced by reloadShader(), once the pipelines using the new one are built
+        void commitReload(const std::string& name);
+        /// @brief Puts back the module replaced by reloadShader(), e.g. when pipelines could not be built with the new one
+        void revertReload(const std::string& name);
+
+        /// @brief Defined by embedded_shaders.cpp, which is generated by CMake
+        static std::span<const EmbeddedShader> getEmbeddedShaders();
+
+    private:
+        VkShaderModule createShaderModule(const std::string& name, std::span<const uint32_t> code) const;
+
+        VulkanDevice& m_device;
+        std::unordered_map<std::string, VkShaderModule> m_shaderModules;
+        std::unordered_map<std::string, VkShaderModule> m_replacedModules;     // Until their reload is committed or reverted. VK_NULL_HANDLE if none was created yet.
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,79 @@
+#ifndef Jate_VulkanShaderHotReloader_H
+#define Jate_VulkanShaderHotReloader_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace jate::rendering::vulkan
+{
+    /// @brief Development tool : watches the shader sources, and recompiles the ones that change with glslc on a background thread.
+    ///        The renderer picks the results up at the start of a frame, and rebuilds the pipelines using them.
+    ///        Only enabled by the JATE_SHADER_HOT_RELOAD build option.
+    class VulkanShaderHotReloader
+    {
+    public:
+        struct CompiledShader
+        {
+            std::string name;       // Source file name, e.g. "simple.vert"
+            std::vector<uint32_t> code;
+        };
+
+        /// @param sourceDirectory Watched for changes, e.g. jate/shaders
+        /// @param glslcPath Run for every changed shader
+        VulkanShaderHotReloader(const std::string& sourceDirectory, const std::string& glslcPath);
+        ~VulkanShaderHotReloader();
+
+        // No copy allowed
+        VulkanShaderHotReloader(const VulkanShaderHotReloader&) = delete;
+        VulkanShaderHotReloader& operator=(const VulkanShaderHotReloader&) = delete;
+
+        /// @brief Shaders successfully recompiled since the last call. Can be called from any thread.
+        std::vector<CompiledShader> takeCompiledShaders();
+
+    private:
+        void watchLoop();
+
+        /// @brief Blocks until source files change, or the reloader stops
+        /// @return Names of the changed files, empty once stopping
+        std::vector<std::string> waitForChanges();
+
+        /// @brief Changed shaders, and every shader including a changed .glsl file
+        std::vector<std::string> findShadersToCompile(const std::vector<std::string>& changedFiles) const;
+
+        /// @return Empty if glslc failed : its diagnostics are already printed
+        std::optional<CompiledShader> compile(const std::string& name) const;
+
+        static bool isShaderSource(const std::filesystem::path& path);
+
+        // Time left to the editor to finish writing, before a changed file is compiled
+        static constexpr std::chrono::milliseconds ms_SETTLE_DELAY{100};
+        // How often the stop flag (and, without inotify, the source files) are checked
+        static constexpr std::chrono::milliseconds ms_POLL_INTERVAL{250};
+
+        std::filesystem::path m_sourceDirectory;
+        std::filesystem::path m_outputDirectory;     // Compiled SPIR-V, read back right away
+        std::string m_glslcPath;
+
+#ifdef __linux__
+        int m_inotifyFd = -1;
+#else
+        std::unordered_map<std::string, std::filesystem::file_time_type> m_writeTimes;
+#endif
+
+        std::mutex m_mutex;
+        std::vector<CompiledShader> m_compiledShaders;
+
+        std::atomic<bool> m_stopping = false;
+        std::thread m_thread;
+    };
+}
+
+#endif
\ No newline at end of file
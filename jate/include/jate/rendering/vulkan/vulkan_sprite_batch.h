@@ -0,0 +1,70 @@
+#ifndef Jate_VulkanSpriteBatch_H
+#define Jate_VulkanSpriteBatch_H
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+#include <jate/rendering/vulkan/vulkan_device.h>
+#include <jate/rendering/vulkan/vulkan_command_manager.h>
+
+#include <vector>
+
+namespace jate::rendering::vulkan
+{
+    /// @brief GPU layout of a sprite, read by the sprite shader as per-instance vertex attributes
+    struct SpriteInstanceData
+    {
+        glm::mat4 transform;
+        glm::vec4 uvRect;   // Min u, min v, max u, max v
+        glm::vec4 color;
+        uint32_t textureIndex;  // Slot of the sampled texture in the bindless texture array
+    };
+
+    /// @brief Draws every sprite of a frame as instances of a single quad. Each frame in flight has its own
+    ///        host visible instance buffer, persistently mapped, and grown when a frame has more sprites than it can hold.
+    class VulkanSpriteBatch
+    {
+    public:
+        VulkanSpriteBatch(VulkanDevice& device, uint8_t framesInFlight);
+        ~VulkanSpriteBatch();
+
+        // No copy allowed
+        VulkanSpriteBatch(const VulkanSpriteBatch&) = delete;
+        VulkanSpriteBatch& operator=(const VulkanSpriteBatch&) = delete;
+
+        /// @brief Sorts the sprites back to front, since they are alpha blended, and writes them to the frame instance buffer.
+        ///        The buffer must not be in use by the GPU anymore : the frame in flight must have been waited on.
+        void upload(uint8_t frameInFlight, std::vector<SpriteInstanceData>& instances);
+
+        /// @brief Records one instanced draw for every sprite uploaded for the frame. The sprite pipeline must be bound.
+        void cmdDraw(VulkanCommandBuffer& commandBuffer, uint8_t frameInFlight) const;
+
+        inline uint32_t getInstanceCount(uint8_t frameInFlight) const { return m_instanceBuffers[frameInFlight].count; }
+
+        /// @brief Rebuilds the instance buffers. The device must be idle.
+        void resize(uint8_t framesInFlight);
+
+        static std::vector<VkVertexInputBindingDescription> getBindingDescriptions();
+        static std::vector<VkVertexInputAttributeDescription> getAttributeDescriptions();
+
+    private:
+        struct InstanceBuffer
+        {
+            VkBuffer buffer = VK_NULL_HANDLE;
+            VkDeviceMemory memory = VK_NULL_HANDLE;
+            void* mappedData = nullptr;
+            uint32_t capacity = 0;
+            uint32_t count = 0;
+        };
+
+        void releaseInstanceBuffer(InstanceBuffer& instanceBuffer);
+
+        static constexpr uint32_t ms_MIN_CAPACITY = 256;
+
+        VulkanDevice& m_device;
+        std::vector<InstanceBuffer> m_instanceBuffers;
+    };
+}
+
+#endif
\ No newline at end of file
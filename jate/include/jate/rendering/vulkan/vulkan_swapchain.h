@@ -3,16 +3,21 @@
 
 #include <jate/window/window.h>
 #include <jate/rendering/vulkan/vulkan_device.h>
+#include <jate/rendering/vulkan/vulkan_render_target.h>
 
 #include <spdlog/spdlog.h>
 #include <memory>
 
 namespace jate::rendering::vulkan
 {
-    class VulkanSwapChain
+    class VulkanSwapChain : public AVulkanRenderTarget
     {
     public:
-        VulkanSwapChain(Window& window, VulkanDevice& device, std::unique_ptr<VulkanSwapChain> previousSwapChain = nullptr);
+        /// @param preferredPresentMode Used if supported, FIFO otherwise
+        /// @param preferredImageCount Clamped to the surface limits. 0 means minimum supported + 1.
+        /// @param previousSwapChain The swap chain being replaced, if any. It is not destroyed : the caller must keep it alive
+        ///        until frames using it are done.
+        VulkanSwapChain(Window& window, VulkanDevice& device, VkPresentModeKHR preferredPresentMode, uint32_t preferredImageCount, VulkanSwapChain* previousSwapChain = nullptr);
         ~VulkanSwapChain();
 
         // Disable copy
@@ -27,19 +32,12 @@ namespace jate::rendering::vulkan
 
         inline VkSwapchainKHR getVkSwapchain() const { return m_swapChain; }
         inline SwapChainSupportDetails getSwapChainSupport() const { return m_swapChainSupport; }
-        inline size_t getImageCount() const { return m_swapChainImages.size(); }
-        inline VkRenderPass getRenderPass() const { return m_renderPass; }
-        inline VkExtent2D getExtent() const { return m_swapExtent; }
-        inline VkFramebuffer getFrameBuffer(uint32_t frameBufferIndex) const
-        {
-            if (frameBufferIndex >= m_frameBuffers.size())
-            {
-                spdlog::error("Invalid index, trying to access framebuffer {}, but swap chain only has {} framebuffers.", frameBufferIndex, m_frameBuffers.size());
-                return nullptr;
-            }
-
-            return m_frameBuffers[frameBufferIndex];
-        }
+        inline size_t getImageCount() const override { return m_swapChainImages.size(); }
+        inline VkFormat getImageFormat() const override { return m_surfaceFormat.format; }
+        inline VkExtent2D getExtent() const override { return m_swapExtent; }
+        inline VkPresentModeKHR getPresentMode() const { return m_presentMode; }
+        inline VkImage getImage(uint32_t imageIndex) const override { return m_swapChainImages[imageIndex]; }
+        inline VkImageView getImageView(uint32_t imageIndex) const override { return m_swapChainImageViews[imageIndex]; }
 
         uint32_t acquireNextImage(VkSemaphore signalSemaphore);
 
@@ -54,12 +52,6 @@ namespace jate::rendering::vulkan
         //   must be called after the various "choose" methods
         void init_createSwapChain();
         void init_createImageViews();
-        void init_createRenderPass();
-        void init_createDepthResources();
-        void init_createFrameBuffers();
-
-        VkFormat findDepthFormat() const;
-        void createImageWithInfo(const VkImageCreateInfo &imageInfo, VkMemoryPropertyFlags properties, VkImage &image, VkDeviceMemory &imageMemory) const;
 
         Window& m_window;
         VulkanDevice& m_device;
@@ -67,6 +59,8 @@ namespace jate::rendering::vulkan
         SwapChainSupportDetails m_swapChainSupport;
 
         VkSurfaceFormatKHR m_surfaceFormat;
+        VkPresentModeKHR m_preferredPresentMode;
+        uint32_t m_preferredImageCount;
         VkPresentModeKHR m_presentMode;
         VkExtent2D m_swapExtent;
 
@@ -75,15 +69,7 @@ namespace jate::rendering::vulkan
         std::vector<VkImage> m_swapChainImages;
         std::vector<VkImageView> m_swapChainImageViews;
 
-        std::vector<VkImage> m_depthImages;
-        std::vector<VkDeviceMemory> m_depthImageMemorys;
-        std::vector<VkImageView> m_depthImageViews;
-
-        VkRenderPass m_renderPass;
-
-        std::vector<VkFramebuffer> m_frameBuffers;
-
-        std::unique_ptr<VulkanSwapChain> m_oldSwapChain;    // Only available at initialisation
+        VulkanSwapChain* m_oldSwapChain = nullptr;    // Only available at initialisation
     };
 }
 
@@ -0,0 +1,90 @@
+#ifndef Jate_VulkanTextureAtlas_H
+#define Jate_VulkanTextureAtlas_H
+
+#include <jate/rendering/vulkan/vulkan_device.h>
+#include <jate/rendering/vulkan/vulkan_command_manager.h>
+#include <jate/rendering/vulkan/vulkan_bindless_descriptors.h>
+#include <jate/rendering/atlas_packer.h>
+#include <jate/rendering/data_structs.h>
+
+#include <unordered_map>
+#include <vector>
+
+namespace jate::rendering::vulkan
+{
+    /// @brief A single mipmapped image holding every sprite texture, sampled through one slot of the bindless texture array.
+    ///        Textures are packed into shelves, and uploaded in the frame command buffer : adding one never waits for the GPU.
+    ///        Every texture is stored in a cell aligned on the smallest mip level, with a border of repeated edge texels,
+    ///        so that neither filtering nor mip generation mixes the colors of neighbouring textures.
+    class VulkanTextureAtlas
+    {
+    public:
+        VulkanTextureAtlas(VulkanDevice& device, VulkanBindlessDescriptors& bindlessDescriptors, uint32_t size);
+        ~VulkanTextureAtlas();
+
+        // No copy allowed
+        VulkanTextureAtlas(const VulkanTextureAtlas&) = delete;
+        VulkanTextureAtlas& operator=(const VulkanTextureAtlas&) = delete;
+
+        /// @brief Packs the texture and queues its upload. Throws if the atlas has no space left for it.
+        /// @param pixels Tightly packed RGBA8 rows
+        renderer_texture_id addTexture(uint32_t width, uint32_t height, const std::vector<uint8_t>& pixels);
+        /// @brief The space is reused right away : the upload barrier of a later frame waits for the frames still sampling it
+        void removeTexture(renderer_texture_id textureId);
+
+        /// @param uvRect Filled with the texture rectangle, in normalized coordinates (min u, min v, max u, max v)
+        /// @return false if the texture does not exist
+        bool getUvRect(renderer_texture_id textureId, glm::vec4& uvRect) const;
+
+        /// @brief Copies the queued textures into the atlas and regenerates the mip levels they cover.
+        ///        Must be recorded every frame before the atlas is sampled, outside of any render pass :
+        ///        the first call also moves the atlas to the layout it is sampled in.
+        void recordPendingUploads(VulkanCommandBuffer& commandBuffer);
+
+        /// @brief Slot of the atlas in the bindless texture array
+        inline bindless_index getBindlessIndex() const { return m_bindlessIndex; }
+
+    private:
+        struct Texture
+        {
+            AtlasRegion cell;       // Allocated region, including the border and the alignment padding
+            AtlasRegion content;    // Region holding the texture itself
+        };
+
+        struct PendingUpload
+        {
+            AtlasRegion cell;
+            std::vector<uint8_t> pixels;    // Padded to the cell size
+        };
+
+        void init_createImage();
+        void init_createSampler();
+
+        VkImageMemoryBarrier createImageBarrier(uint32_t baseMipLevel, uint32_t levelCount,
+            VkImageLayout oldLayout, VkImageLayout newLayout, VkAccessFlags srcAccess, VkAccessFlags dstAccess) const;
+
+        static constexpr VkFormat ms_FORMAT = VK_FORMAT_R8G8B8A8_SRGB;
+        static constexpr uint32_t ms_MAX_MIP_LEVELS = 5;
+        static constexpr uint32_t ms_BORDER = 1;     // Texels repeated around each texture, for bilinear filtering
+
+        VulkanDevice& m_device;
+        VulkanBindlessDescriptors& m_bindlessDescriptors;
+        uint32_t m_size;
+        uint32_t m_mipLevels = 1;
+
+        VkImage m_image = VK_NULL_HANDLE;
+        VkDeviceMemory m_imageMemory = VK_NULL_HANDLE;
+        VkImageView m_imageView = VK_NULL_HANDLE;
+        VkSampler m_sampler = VK_NULL_HANDLE;
+        bool m_layoutInitialized = false;
+
+        bindless_index m_bindlessIndex = 0;
+
+        ShelfAtlasPacker m_packer;
+        std::unordered_map<renderer_texture_id, Texture> m_textures;
+        renderer_texture_id m_nextTextureId = 0;
+        std::vector<PendingUpload> m_pendingUploads;
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,48 @@
+#ifndef Jate_VulkanTimelineSemaphore_H
+#define Jate_VulkanTimelineSemaphore_H
+
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+#include <atomic>
+#include <stdint.h>
+
+namespace jate::rendering::vulkan
+{
+    /// @brief A monotonically increasing GPU counter. Each submission signals the next value,
+    ///        so a single semaphore tells which of all past submissions have completed.
+    ///        Replaces one fence per submission, and can be waited on by other queues as well as by the host.
+    class VulkanTimelineSemaphore
+    {
+    public:
+        VulkanTimelineSemaphore(VkDevice device);
+        ~VulkanTimelineSemaphore();
+
+        // No copy allowed
+        VulkanTimelineSemaphore(const VulkanTimelineSemaphore&) = delete;
+        VulkanTimelineSemaphore& operator=(const VulkanTimelineSemaphore&) = delete;
+
+        inline VkSemaphore getVkSemaphore() const { return m_semaphore; }
+
+        /// @brief The value the next submission must signal. Values must be signaled in order.
+        inline uint64_t getNextSignalValue() const { return m_lastAllocatedValue + 1; }
+        /// @brief Reserves the next value, once a submission signaling it has succeeded
+        inline void advanceSignalValue() { m_lastAllocatedValue++; }
+        /// @brief The value signaled by the last submission, once it completes
+        inline uint64_t getLastAllocatedValue() const { return m_lastAllocatedValue; }
+
+        /// @brief Every submission that signals this value or a lower one has completed
+        uint64_t getCompletedValue() const;
+
+        /// @return false if the timeout expired before the value was reached
+        bool wait(uint64_t value, uint64_t timeout = UINT64_MAX) const;
+
+    private:
+        VkDevice m_device;
+        VkSemaphore m_semaphore = VK_NULL_HANDLE;
+
+        std::atomic<uint64_t> m_lastAllocatedValue = 0;
+    };
+}
+
+#endif
\ No newline at end of file
@@ -12,14 +12,16 @@ namespace jate::systems
     class RenderSystem : public ASystem
     {
     public:
-        RenderSystem(rendering::ARenderer* renderer);
+        /// @param snapshot Filled with this frame's draws at each tick, and with the memory to release when units are removed
+        RenderSystem(rendering::ARenderer* renderer, rendering::RenderSnapshot* snapshot);
 
         virtual void onComponentAdded(components::AComponent* component) override;
         virtual void onComponentRemoved(components::AComponent* component) override;
-        virtual void tick() override;
+        virtual void tick(float interpolationAlpha) override;
     
     private:
         rendering::ARenderer* m_renderer;
+        rendering::RenderSnapshot* m_snapshot;
 
         std::unordered_map<uint32_t, components::ARenderUnit*> m_renderUnitComponents;
     };
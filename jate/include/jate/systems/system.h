@@ -2,20 +2,39 @@
 #define Jate_System_H
 
 #include <jate/components/component.h>
+#include <jate/input/input_event.h>
+
+#include <stdint.h>
 
 namespace jate::systems
 {
-    enum SystemEnum
+    // Fixed underlying type : user systems take every id past the listed ones
+    enum SystemEnum : uint32_t
     {
-        RENDER_SYSTEM
+        RENDER_SYSTEM,
+
+        // Systems added with World::addSystem() get ids from here
+        FIRST_USER_SYSTEM
     };
 
     class ASystem
     {
     public:
+        virtual ~ASystem(){}
+
         virtual void onComponentAdded(components::AComponent* component) = 0;
         virtual void onComponentRemoved(components::AComponent* component) = 0;
-        virtual void tick() = 0;
+
+        /// @brief Called at the start of a simulation step, for each input event received during that step, in order.
+        virtual void onInputEvent(const input::InputEvent& event) {}
+
+        /// @brief Simulation phase. Called at a fixed rate, zero or several times per rendered frame.
+        /// @param fixedDeltaTime Duration of a simulation step, in seconds
+        virtual void fixedTick(double fixedDeltaTime) {}
+
+        /// @brief Render phase. Called once per rendered frame.
+        /// @param interpolationAlpha Position of the rendered frame between the two last simulation steps, in [0, 1]
+        virtual void tick(float interpolationAlpha) {}
     };
 }
 
@@ -0,0 +1,45 @@
+#ifndef Jate_FramePacer_H
+#define Jate_FramePacer_H
+
+#include <chrono>
+#include <functional>
+
+namespace jate::timing
+{
+    /// @brief Caps the frame rate by waiting until the next frame is due.
+    ///        Sleeps most of the remaining time, then spins for the last part, since OS sleeps overshoot by up to a few milliseconds.
+    class FramePacer
+    {
+    public:
+        using clock = std::chrono::steady_clock;
+
+        /// @param targetFrameRate Frames per second. 0 disables pacing.
+        FramePacer(double targetFrameRate = 0.0);
+
+        void setTargetFrameRate(double targetFrameRate);
+        inline double getTargetFrameRate() const { return m_targetFrameRate; }
+        inline bool isEnabled() const { return m_targetFrameRate > 0.0; }
+
+        /// @brief Time left before a sleep is considered too imprecise, and busy-waiting takes over.
+        ///        Higher values are more precise, lower values use less CPU.
+        inline void setSpinThreshold(std::chrono::microseconds spinThreshold) { m_spinThreshold = spinThreshold; }
+
+        /// @brief Replaces the sleep used for the coarse part of the wait, e.g. to process window events while waiting.
+        ///        The function may return early : it is called again until the spin threshold is reached.
+        inline void setWaitFunction(std::function<void (clock::duration)> waitFunction) { m_waitFunction = std::move(waitFunction); }
+
+        /// @brief Blocks until the next frame should start. Call once per frame, at the start of the frame.
+        void waitForNextFrame();
+
+    private:
+        double m_targetFrameRate = 0.0;
+        clock::duration m_framePeriod{};
+        std::chrono::microseconds m_spinThreshold{1500};
+        std::function<void (clock::duration)> m_waitFunction;
+
+        clock::time_point m_nextFrameTime{};
+        bool m_hasNextFrameTime = false;
+    };
+}
+
+#endif
\ No newline at end of file
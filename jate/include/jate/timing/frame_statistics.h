@@ -0,0 +1,82 @@
+#ifndef Jate_FrameStatistics_H
+#define Jate_FrameStatistics_H
+
+#include <array>
+#include <mutex>
+#include <vector>
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace jate::timing
+{
+    /// @brief Histogram of durations with fixed-width buckets, cheap enough to be fed every frame
+    class TimingHistogram
+    {
+    public:
+        /// @param bucketWidthMs Resolution of the percentiles
+        /// @param maxMs Durations above this value are only counted in an overflow bucket
+        TimingHistogram(double bucketWidthMs = 0.05, double maxMs = 100.0);
+
+        void addSample(double durationMs);
+        void reset();
+
+        /// @param percentile In [0, 100]
+        /// @return Upper bound of the bucket holding this percentile, in milliseconds (0 if no sample)
+        double getPercentile(double percentile) const;
+
+        inline uint64_t getSampleCount() const { return m_sampleCount; }
+        inline double getMax() const { return m_maxMs; }
+        inline double getAverage() const { return m_sampleCount > 0 ? m_sumMs / static_cast<double>(m_sampleCount) : 0.0; }
+
+    private:
+        double m_bucketWidthMs;
+        std::vector<uint64_t> m_buckets;    // Last bucket is the overflow bucket
+
+        uint64_t m_sampleCount = 0;
+        double m_sumMs = 0.0;
+        double m_maxMs = 0.0;
+    };
+
+    enum class FrameMetric
+    {
+        CpuFrame,       // Time spent producing a frame on the CPU, fence wait included, pacing excluded
+        FrameInterval,  // Time between the start of two consecutive frames, pacing included
+        FenceWait,      // Time blocked waiting for a frame in flight to be released by the GPU
+        Present,        // Time spent in the present call
+
+        Count
+    };
+
+    struct FrameMetricSummary
+    {
+        uint64_t sampleCount = 0;
+        double averageMs = 0.0;
+        double p50Ms = 0.0;
+        double p95Ms = 0.0;
+        double p99Ms = 0.0;
+        double maxMs = 0.0;
+    };
+
+    /// @brief Collects per-frame timings, fed by the application main loop and by the renderer.
+    ///        Recording and summaries are thread safe, since the renderer may run on its own thread.
+    class FrameStatistics
+    {
+    public:
+        void record(FrameMetric metric, double durationMs);
+
+        FrameMetricSummary getSummary(FrameMetric metric) const;
+
+        /// @brief Not synchronized : only use while nothing is being recorded
+        inline const TimingHistogram& getHistogram(FrameMetric metric) const { return m_histograms[static_cast<size_t>(metric)]; }
+
+        /// @brief Clears every histogram, e.g. after changing settings to measure them separately
+        void reset();
+
+    private:
+        mutable std::mutex m_mutex;
+        std::array<TimingHistogram, static_cast<size_t>(FrameMetric::Count)> m_histograms;
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,52 @@
+#ifndef Jate_RollingStats_H
+#define Jate_RollingStats_H
+
+#include <vector>
+#include <algorithm>
+#include <limits>
+
+#include <stddef.h>
+
+namespace jate::utils
+{
+    /// @brief Min / average / max over the last N samples
+    class RollingStats
+    {
+    public:
+        RollingStats(size_t windowSize = 120) : m_samples(windowSize > 0 ? windowSize : 1, 0.0) {}
+
+        void addSample(double value)
+        {
+            m_sum -= m_samples[m_nextSample];
+            m_samples[m_nextSample] = value;
+            m_sum += value;
+
+            m_nextSample = (m_nextSample + 1) % m_samples.size();
+            m_sampleCount = std::min(m_sampleCount + 1, m_samples.size());
+        }
+
+        inline size_t getSampleCount() const { return m_sampleCount; }
+        inline double getAverage() const { return m_sampleCount > 0 ? m_sum / static_cast<double>(m_sampleCount) : 0.0; }
+
+        double getMin() const
+        {
+            if (m_sampleCount == 0) return 0.0;
+            return *std::min_element(m_samples.begin(), m_samples.begin() + m_sampleCount);
+        }
+
+        double getMax() const
+        {
+            if (m_sampleCount == 0) return 0.0;
+            return *std::max_element(m_samples.begin(), m_samples.begin() + m_sampleCount);
+        }
+
+    private:
+        // Ring buffer : only the first m_sampleCount elements are valid until the window has been filled once
+        std::vector<double> m_samples;
+        size_t m_nextSample = 0;
+        size_t m_sampleCount = 0;
+        double m_sum = 0.0;
+    };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,70 @@
+#ifndef Jate_SpscQueue_H
+#define Jate_SpscQueue_H
+
+#include <atomic>
+#include <vector>
+
+#include <stddef.h>
+
+namespace jate::utils
+{
+    /// @brief Bounded lock-free queue, for exactly one producer thread and one consumer thread.
+    ///        The capacity is rounded up to a power of two.
+    template<typename T>
+    class SpscQueue
+    {
+    public:
+        SpscQueue(size_t capacity)
+        {
+            size_t roundedCapacity = 1;
+            while (roundedCapacity < capacity)
+            {
+                roundedCapacity <<= 1;
+            }
+            m_items.resize(roundedCapacity);
+            m_mask = roundedCapacity - 1;
+        }
+
+        // No copy allowed
+        SpscQueue(const SpscQueue&) = delete;
+        SpscQueue& operator=(const SpscQueue&) = delete;
+
+        /// @brief Producer side
+        /// @return false if the queue is full, in which case the item is dropped
+        bool tryPush(const T& item)
+        {
+            size_t tail = m_tail.load(std::memory_order_relaxed);
+            if (tail - m_head.load(std::memory_order_acquire) > m_mask)
+                return false;
+
+            m_items[tail & m_mask] = item;
+            m_tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        /// @brief Consumer side
+        /// @return false if the queue is empty
+        bool tryPop(T& item)
+        {
+            size_t head = m_head.load(std::memory_order_relaxed);
+            if (head == m_tail.load(std::memory_order_acquire))
+                return false;
+
+            item = m_items[head & m_mask];
+            m_head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        inline size_t getCapacity() const { return m_items.size(); }
+
+    private:
+        std::vector<T> m_items;
+        size_t m_mask;
+
+        // On separate cache lines, so that the producer and the consumer do not invalidate each other's
+        alignas(64) std::atomic<size_t> m_head = 0;     // Next item to pop, written by the consumer
+        alignas(64) std::atomic<size_t> m_tail = 0;     // Next slot to push to, written by the producer
+    };
+}
+
+#endif
\ No newline at end of file
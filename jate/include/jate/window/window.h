@@ -5,7 +5,10 @@
 #include <GLFW/glfw3.h>
 
 #include <jate/rendering/vulkan/vulkan_instance.h>
+#include <jate/input/input_event.h>
+#include <jate/utils/spsc_queue.h>
 
+#include <atomic>
 #include <string>
 
 namespace jate
@@ -30,20 +33,45 @@ namespace jate
         inline void resetFrameBufferResizedFlag() { m_frameBufferResized = false; }
         inline bool hasBeenResized() const { return m_frameBufferResized; }
 
+        // Frame buffer size, as last reported by GLFW events. Unlike glfwGetFramebufferSize, these can be read from any thread.
+        inline uint32_t getFrameBufferWidth() const { return m_frameBufferWidth; }
+        inline uint32_t getFrameBufferHeight() const { return m_frameBufferHeight; }
+        inline bool isMinimized() const { return m_frameBufferWidth == 0 || m_frameBufferHeight == 0; }
+
+        /// @brief Events received by GLFW callbacks, while polling or waiting for events. Only one thread may pop from it.
+        inline utils::SpscQueue<input::InputEvent>& getInputEvents() { return m_inputEvents; }
+
+        /// @brief Amount of events lost because the queue was full, i.e. not consumed fast enough
+        inline uint64_t getDroppedInputEventCount() const { return m_droppedInputEventCount; }
+
     private:
         uint16_t m_width, m_height;
         std::string m_name;
-        bool m_frameBufferResized = false;
+        // Written by GLFW callbacks on the main thread, read by the renderer which may run on another thread
+        std::atomic<bool> m_frameBufferResized = false;
+        std::atomic<uint32_t> m_frameBufferWidth = 0;
+        std::atomic<uint32_t> m_frameBufferHeight = 0;
 
         GLFWwindow* m_glfwWindow;
 
+        static constexpr size_t ms_INPUT_EVENT_QUEUE_CAPACITY = 1024;
+        utils::SpscQueue<input::InputEvent> m_inputEvents{ms_INPUT_EVENT_QUEUE_CAPACITY};
+        uint64_t m_droppedInputEventCount = 0;
+
         VkInstance m_vkInstance;
         VkSurfaceKHR m_vkSurface;
 
         // Init functions
         void init_createWindow();
 
+        void pushInputEvent(const input::InputEvent& event);
+
         static void frameBufferResizedCallback(GLFWwindow* glfwWindow, int width, int height);
+        static void keyCallback(GLFWwindow* glfwWindow, int key, int scancode, int action, int mods);
+        static void charCallback(GLFWwindow* glfwWindow, unsigned int codepoint);
+        static void mouseButtonCallback(GLFWwindow* glfwWindow, int button, int action, int mods);
+        static void cursorPosCallback(GLFWwindow* glfwWindow, double x, double y);
+        static void scrollCallback(GLFWwindow* glfwWindow, double xOffset, double yOffset);
     };
     
 } // namespace jate
@@ -0,0 +1,20 @@
+#version 450
+
+layout (location = 0) in vec4 inColor;
+layout (location = 1) in vec2 inCorner;     // -1 to 1 across the quad
+
+layout (location = 0) out vec4 outColor;
+
+// Set by the pipeline variant : additive particles are weighted by their alpha here, and added as is by the blend stage
+layout (constant_id = 0) const bool PREMULTIPLY_ALPHA = false;
+
+void main()
+{
+    // Round particle, fading towards its edge
+    float falloff = 1.0 - dot(inCorner, inCorner);
+    if (falloff <= 0.0)
+        discard;
+
+    float alpha = inColor.a * falloff;
+    outColor = PREMULTIPLY_ALPHA ? vec4(inColor.rgb * alpha, alpha) : vec4(inColor.rgb, alpha);
+}
\ No newline at end of file
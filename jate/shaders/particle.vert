@@ -0,0 +1,30 @@
+#version 450
+#extension GL_GOOGLE_include_directive : require
+
+#define PARTICLE_BUFFER_ACCESS readonly
+#include "particles.glsl"
+
+layout (location = 0) out vec4 outColor;
+layout (location = 1) out vec2 outCorner;
+
+// Two triangles of a unit quad centered on the origin, generated from the vertex index : no vertex buffer needed
+const vec2 corners[6] = vec2[](
+    vec2(-0.5, -0.5), vec2(0.5, -0.5), vec2(0.5, 0.5),
+    vec2(0.5, 0.5), vec2(-0.5, 0.5), vec2(-0.5, -0.5)
+);
+
+void main()
+{
+    // One instance per particle of the destination list, written by the simulation
+    uint particle = uintBuffers[push.destinationListIndex].values[gl_InstanceIndex];
+    vec4 position = vec4Buffers[push.positionsIndex].values[particle];
+    float lifetime = vec4Buffers[push.velocitiesIndex].values[particle].w;
+
+    float progress = clamp(position.w / lifetime, 0.0, 1.0);
+    float size = mix(push.lifetimeAndSize.z, push.lifetimeAndSize.w, progress);
+    vec2 corner = corners[gl_VertexIndex];
+
+    gl_Position = vec4(position.xyz + vec3(corner * size, 0.0), 1.0);
+    outColor = mix(push.startColor, push.endColor, progress);
+    outCorner = corner * 2.0;
+}
\ No newline at end of file
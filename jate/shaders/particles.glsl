@@ -0,0 +1,52 @@
+// Shared by the particle shaders. Must match ParticlePushConstants and ParticleSystemState in vulkan_particle_system.h
+
+#extension GL_EXT_nonuniform_qualifier : require
+
+layout (push_constant) uniform Push
+{
+    vec4 emitterPositionAndRadius;
+    vec4 initialVelocityAndSpread;
+    vec4 gravityAndDeltaTime;
+    vec4 startColor;
+    vec4 endColor;
+    vec4 lifetimeAndSize;       // Min lifetime, max lifetime, start size, end size
+
+    // Bindless storage buffer slots
+    uint positionsIndex;        // xyz : position, w : age
+    uint velocitiesIndex;       // xyz : velocity, w : lifetime
+    uint sourceListIndex;
+    uint destinationListIndex;
+    uint deadListIndex;
+    uint stateIndex;
+
+    uint requestedSpawnCount;
+    uint seed;
+} push;
+
+// Graphics stages define it as readonly : writes from them need extra device features
+#ifndef PARTICLE_BUFFER_ACCESS
+#define PARTICLE_BUFFER_ACCESS
+#endif
+
+// Every particle buffer lives in the bindless storage buffer array, viewed with the type it holds
+layout (std430, set = 0, binding = 1) PARTICLE_BUFFER_ACCESS buffer Vec4Buffer
+{
+    vec4 values[];
+} vec4Buffers[];
+
+layout (std430, set = 0, binding = 1) PARTICLE_BUFFER_ACCESS buffer UintBuffer
+{
+    uint values[];
+} uintBuffers[];
+
+layout (std430, set = 0, binding = 1) PARTICLE_BUFFER_ACCESS buffer StateBuffer
+{
+    uint emitArgs[3];
+    uint simulateArgs[3];
+    uint drawArgs[4];       // Vertex count, instance count, first vertex, first instance
+    uint deadCount;
+    uint aliveCount;
+    uint spawnCount;
+} stateBuffers[];
+
+#define PARTICLE_WORKGROUP_SIZE 64      // Must match VulkanParticleSystem::ms_WORKGROUP_SIZE
\ No newline at end of file
@@ -1,19 +1,34 @@
 #version 450
 //#extension GL_KHR_vulkan_glsl : enable
+#extension GL_EXT_nonuniform_qualifier : require
 
 layout (location = 0) in vec3 position;
 layout (location = 1) in vec3 color;
 
 layout (location = 0) out vec3 outColor;
 
-layout (push_constant) uniform Push
+struct ObjectData
 {
     mat4 transform;
+};
+
+// Bindless storage buffer array : the object data of each frame lives in one of its slots
+layout (std430, set = 0, binding = 1) readonly buffer ObjectBuffer
+{
+    ObjectData objects[];
+} objectBuffers[];
+
+layout (push_constant) uniform Push
+{
+    uint objectBufferIndex;
 } push;
 
 void main()
 {
-    gl_Position = vec4(push.transform * vec4(position, 1.0));
+    // Each draw uses its object index as instance index
+    ObjectData object = objectBuffers[push.objectBufferIndex].objects[gl_InstanceIndex];
+
+    gl_Position = vec4(object.transform * vec4(position, 1.0));
     //gl_Position = vec4(position, 1.0);
     outColor = color;
 }
\ No newline at end of file
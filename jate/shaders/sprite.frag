@@ -0,0 +1,17 @@
+#version 450
+#extension GL_EXT_nonuniform_qualifier : require
+
+layout (location = 0) in vec2 inUv;
+layout (location = 1) in vec4 inColor;
+layout (location = 2) flat in uint inTextureIndex;
+
+layout (location = 0) out vec4 outColor;
+
+// Bindless texture array, shared by every pipeline
+layout (set = 0, binding = 0) uniform sampler2D textures[];
+
+void main()
+{
+    // The index comes from the instance : it may differ between the invocations of a draw
+    outColor = texture(textures[nonuniformEXT(inTextureIndex)], inUv) * inColor;
+}
\ No newline at end of file
@@ -0,0 +1,31 @@
+#version 450
+
+// Per instance : one sprite
+layout (location = 0) in vec4 transformColumn0;
+layout (location = 1) in vec4 transformColumn1;
+layout (location = 2) in vec4 transformColumn2;
+layout (location = 3) in vec4 transformColumn3;
+layout (location = 4) in vec4 uvRect;      // Min u, min v, max u, max v
+layout (location = 5) in vec4 color;
+layout (location = 6) in uint textureIndex;     // Slot in the bindless texture array
+
+layout (location = 0) out vec2 outUv;
+layout (location = 1) out vec4 outColor;
+layout (location = 2) flat out uint outTextureIndex;
+
+// Two triangles of a unit quad centered on the origin, generated from the vertex index : no vertex buffer needed
+const vec2 corners[6] = vec2[](
+    vec2(-0.5, -0.5), vec2(0.5, -0.5), vec2(0.5, 0.5),
+    vec2(0.5, 0.5), vec2(-0.5, 0.5), vec2(-0.5, -0.5)
+);
+
+void main()
+{
+    vec2 corner = corners[gl_VertexIndex];
+    mat4 transform = mat4(transformColumn0, transformColumn1, transformColumn2, transformColumn3);
+
+    gl_Position = transform * vec4(corner, 0.0, 1.0);
+    outUv = mix(uvRect.xy, uvRect.zw, corner + 0.5);
+    outColor = color;
+    outTextureIndex = textureIndex;
+}
\ No newline at end of file
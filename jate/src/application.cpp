@@ -2,15 +2,42 @@
 
 #include <jate/rendering/vulkan/vulkan_renderer.h>
 #include <jate/systems/render_system.h>
+#include <jate/profiling/cpu_profiler.h>
 
 #include <spdlog/spdlog.h>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include <span>
 
 namespace jate
 {
-    Application::Application() 
-        : m_window("My window", 800, 600)
+    Application::Application(const ApplicationConfig& config)
+        : m_config(config), m_framePacer(config.targetFrameRate)
     {
-        m_renderer = std::make_unique<rendering::vulkan::VulkanRenderer>(m_window);
+        if (!m_config.headless)
+        {
+            m_window = std::make_unique<Window>(m_config.name, m_config.width, m_config.height);
+
+            // Process window events while waiting for the next frame, so that they are timestamped when they happen
+            m_framePacer.setWaitFunction([](timing::FramePacer::clock::duration waitDuration) {
+                glfwWaitEventsTimeout(std::chrono::duration<double>(waitDuration).count());
+            });
+        }
+
+        rendering::RendererConfig rendererConfig = m_config.renderer;
+        rendererConfig.headless = m_config.headless;
+        rendererConfig.width = m_config.width;
+        rendererConfig.height = m_config.height;
+
+        m_renderer = std::make_unique<rendering::vulkan::VulkanRenderer>(m_window.get(), rendererConfig);
+        m_renderer->attachFrameStatistics(&m_frameStatistics);
+        m_assetManager = std::make_unique<assets::AssetManager>(m_renderer.get());
+
+        if (m_config.useRenderThread)
+        {
+            m_renderThread = std::make_unique<rendering::RenderThread>(m_renderer.get());
+        }
     }
 
     Application::~Application()
@@ -32,17 +59,200 @@ namespace jate
         }
 
         m_running = true;
+        m_frameCount = 0;
+        m_fixedStepAccumulator = 0.0;
+
+        using clock = std::chrono::steady_clock;
+        using milliseconds = std::chrono::duration<double, std::milli>;
+
+        bool hasPreviousFrame = false;
+        clock::time_point previousFrameStart;
 
         // Main loop
-        while (!m_window.shouldClose())
+        while (!shouldStop())
+        {
+            {
+                JATE_PROFILE_SCOPE("FramePacing");
+                m_framePacer.waitForNextFrame();
+            }
+
+            clock::time_point frameStart = clock::now();
+            double frameDeltaTime = 0.0;
+            if (hasPreviousFrame)
+            {
+                frameDeltaTime = std::chrono::duration<double>(frameStart - previousFrameStart).count();
+                m_frameStatistics.record(timing::FrameMetric::FrameInterval, milliseconds(frameStart - previousFrameStart).count());
+            }
+            previousFrameStart = frameStart;
+            hasPreviousFrame = true;
+
+            {
+                JATE_PROFILE_SCOPE("Frame");
+
+                if (m_window != nullptr)
+                {
+                    JATE_PROFILE_SCOPE("PollEvents");
+                    glfwPollEvents();
+                }
+
+                if (m_window != nullptr && m_window->isMinimized())
+                {
+                    // Nothing can be presented : sleep until the window is restored, without running the simulation.
+                    // The timeout lets the loop notice a close request.
+                    glfwWaitEventsTimeout(ms_MINIMIZED_WAIT_TIMEOUT);
+                    discardInputEvents();
+                    hasPreviousFrame = false;
+                    continue;
+                }
+
+                collectInputEvents();
+
+                // Assets finished in the background become visible to the simulation at the start of a frame
+                m_assetManager->update(m_world->getRenderSnapshot());
+
+                // Simulation does not touch the GPU : run it before waiting for the frame fence
+                float interpolationAlpha = runFixedSteps(frameDeltaTime, frameStart);
+
+                m_world->tickSystems(interpolationAlpha);
+
+                renderFrame();
+                m_frameCount++;
+            }
+
+            m_frameStatistics.record(timing::FrameMetric::CpuFrame, milliseconds(clock::now() - frameStart).count());
+
+            handleProfileCapture();
+        }
+
+        if (m_renderThread != nullptr)
+        {
+            m_renderThread->waitIdle();
+        }
+
+        m_running = false;
+    }
+
+    void Application::renderFrame()
+    {
+        rendering::RenderSnapshot& snapshot = m_world->getRenderSnapshot();
+
+        if (m_renderThread == nullptr)
+        {
+            m_renderer->renderSnapshot(snapshot);
+            snapshot.clear();
+            return;
+        }
+
+        // Keep processing window events while the render thread is busy, so that the window stays responsive
+        while (!m_renderThread->submit(snapshot, ms_RENDER_THREAD_SUBMIT_TIMEOUT))
+        {
+            if (m_window != nullptr)
+            {
+                glfwPollEvents();
+            }
+        }
+    }
+
+    void Application::collectInputEvents()
+    {
+        if (m_window == nullptr)
+            return;
+
+        input::InputEvent event;
+        while (m_window->getInputEvents().tryPop(event))
         {
-            glfwPollEvents();
-            m_renderer->beginFrame();
+            m_pendingInputEvents.push_back(event);
+        }
+    }
 
-            // Tick systems
-            m_world->tickSystems();
+    void Application::discardInputEvents()
+    {
+        if (m_window == nullptr)
+            return;
 
-            m_renderer->endFrame();
+        // Also keeps the window queue from filling up, and dropping the events received after restoring
+        input::InputEvent event;
+        while (m_window->getInputEvents().tryPop(event))
+        {
         }
     }
+
+    float Application::runFixedSteps(double frameDeltaTime, std::chrono::steady_clock::time_point frameStart)
+    {
+        JATE_PROFILE_SCOPE("FixedSteps");
+
+        const double fixedTimeStep = m_config.fixedTimeStep;
+        if (fixedTimeStep <= 0.0)
+        {
+            spdlog::error("Fixed time step must be positive, simulation is stopped");
+            return 1.f;
+        }
+
+        // The first frame always runs a step, so that systems see a simulated state before anything is rendered
+        if (m_fixedStepCount == 0)
+        {
+            m_fixedStepAccumulator = fixedTimeStep;
+        }
+        else
+        {
+            m_fixedStepAccumulator += frameDeltaTime;
+        }
+
+        // Real time matching the start of the first step of this frame
+        auto stepEnd = frameStart - std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(m_fixedStepAccumulator));
+        auto stepDuration = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(fixedTimeStep));
+
+        uint32_t stepCount = 0;
+        while (m_fixedStepAccumulator >= fixedTimeStep && stepCount < m_config.maxFixedStepsPerFrame)
+        {
+            stepEnd += stepDuration;
+
+            // Events are queued in the order they are received, so the ones belonging to this step are at the front
+            auto stepEventsEnd = std::find_if(m_pendingInputEvents.begin(), m_pendingInputEvents.end(),
+                [stepEnd](const input::InputEvent& event) { return event.timestamp > stepEnd; });
+            size_t stepEventCount = static_cast<size_t>(stepEventsEnd - m_pendingInputEvents.begin());
+
+            m_world->fixedTickSystems(fixedTimeStep, std::span<const input::InputEvent>(m_pendingInputEvents.data(), stepEventCount));
+            m_pendingInputEvents.erase(m_pendingInputEvents.begin(), m_pendingInputEvents.begin() + stepEventCount);
+
+            m_fixedStepAccumulator -= fixedTimeStep;
+            m_fixedStepCount++;
+            stepCount++;
+        }
+
+        if (m_fixedStepAccumulator >= fixedTimeStep)
+        {
+            // Could not catch up : drop the late time, the simulation runs slower than real time for this frame
+            m_fixedStepAccumulator = std::fmod(m_fixedStepAccumulator, fixedTimeStep);
+        }
+
+        return static_cast<float>(m_fixedStepAccumulator / fixedTimeStep);
+    }
+
+    void Application::handleProfileCapture()
+    {
+        #ifdef JATE_ENABLE_PROFILING
+        bool captureRequested = m_config.profileCaptureFrame > 0 && m_frameCount == m_config.profileCaptureFrame;
+
+        if (m_window != nullptr)
+        {
+            bool captureKeyDown = glfwGetKey(m_window->getWindowPtr(), ms_PROFILE_CAPTURE_KEY) == GLFW_PRESS;
+            captureRequested |= captureKeyDown && !m_profileCaptureKeyWasDown;
+            m_profileCaptureKeyWasDown = captureKeyDown;
+        }
+
+        if (captureRequested)
+        {
+            profiling::CpuProfiler::get().exportChromeTrace(m_config.profileCapturePath);
+        }
+        #endif
+    }
+
+    bool Application::shouldStop() const
+    {
+        if (m_config.maxFrameCount > 0 && m_frameCount >= m_config.maxFrameCount)
+            return true;
+
+        return m_window != nullptr && m_window->shouldClose();
+    }
 }
\ No newline at end of file
@@ -0,0 +1,397 @@
+#include <jate/assets/asset_manager.h>
+
+#include <jate/profiling/cpu_profiler.h>
+
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace jate::assets
+{
+    bool AssetManager::QueuedLoad::operator<(const QueuedLoad& other) const
+    {
+        // std::priority_queue pops the greatest element : higher priority first, then lower sequence
+        if (priority != other.priority)
+            return priority < other.priority;
+
+        return sequence > other.sequence;
+    }
+
+    AssetManager::AssetManager(rendering::ARenderer* renderer, uint32_t workerCount)
+        : m_renderer(renderer), m_uploadCompletions(std::make_shared<UploadCompletions>())
+    {
+        workerCount = std::max(workerCount, 1u);
+        for (uint32_t i = 0; i < workerCount; i++)
+        {
+            m_workers.emplace_back(&AssetManager::workerLoop, this);
+        }
+    }
+
+    AssetManager::~AssetManager()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_queueCondition.notify_all();
+
+        for (auto& worker : m_workers)
+        {
+            worker.join();
+        }
+
+        // Upload callbacks still pending in the renderer hold a weak reference : they do nothing once the manager is gone.
+        // No snapshot is rendered anymore : the memory is freed right away.
+        for (const auto& [id, record] : m_records)
+        {
+            if (record.meshSlots.has_value())
+            {
+                m_slotsToFree.push_back(record.meshSlots.value());
+            }
+        }
+        for (const auto& slots : m_slotsToFree)
+        {
+            m_renderer->freeVertexData(slots.verticesSlot);
+            m_renderer->freeIndexData(slots.indicesSlot);
+        }
+    }
+
+    AssetHandle<MappedFile> AssetManager::loadFile(const std::string& path, AssetPriority priority,
+        const std::vector<asset_id>& dependencies, completion_callback onComplete)
+    {
+        return {requestLoad(AssetType::File, path, priority, dependencies, std::move(onComplete))};
+    }
+
+    AssetHandle<MeshAsset> AssetManager::loadMesh(const std::string& path, AssetPriority priority,
+        const std::vector<asset_id>& dependencies, completion_callback onComplete)
+    {
+        return {requestLoad(AssetType::Mesh, path, priority, dependencies, std::move(onComplete))};
+    }
+
+    asset_id AssetManager::requestLoad(AssetType type, const std::string& path, AssetPriority priority,
+        const std::vector<asset_id>& dependencies, completion_callback onComplete)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        asset_id id = m_nextId++;
+        AssetRecord& record = m_records[id];
+        record.type = type;
+        record.priority = priority;
+        record.path = path;
+        record.onComplete = std::move(onComplete);
+
+        std::optional<AssetState> failedState;
+        for (asset_id dependency : dependencies)
+        {
+            auto dependencyIt = m_records.find(dependency);
+            if (dependencyIt == m_records.end())
+            {
+                spdlog::error("[Asset Manager] Loading {} with dependency {}, but it is not loaded", path, dependency);
+                failedState = AssetState::Failed;
+                continue;
+            }
+
+            AssetRecord& dependencyRecord = dependencyIt->second;
+            if (dependencyRecord.state == AssetState::Failed || dependencyRecord.state == AssetState::Cancelled)
+            {
+                failedState = dependencyRecord.state;
+            }
+            else if (dependencyRecord.state != AssetState::Ready)
+            {
+                dependencyRecord.dependents.push_back(id);
+                record.pendingDependencies++;
+            }
+        }
+
+        if (failedState.has_value())
+        {
+            finish(id, failedState.value());
+        }
+        else if (record.pendingDependencies == 0)
+        {
+            enqueue(id, record);
+        }
+
+        return id;
+    }
+
+    void AssetManager::enqueue(asset_id id, AssetRecord& record)
+    {
+        record.state = AssetState::Queued;
+        m_queue.push({record.priority, m_nextSequence++, id});
+        m_queueCondition.notify_one();
+    }
+
+    void AssetManager::finish(asset_id id, AssetState state)
+    {
+        AssetRecord& record = m_records.at(id);
+        record.state = state;
+        m_completed.push_back(id);
+
+        std::vector<asset_id> dependents = std::move(record.dependents);
+        record.dependents.clear();
+        for (asset_id dependent : dependents)
+        {
+            auto dependentIt = m_records.find(dependent);
+            if (dependentIt == m_records.end() || dependentIt->second.state != AssetState::Waiting)
+                continue;
+
+            if (state != AssetState::Ready)
+            {
+                // A dependent can't load without this asset
+                finish(dependent, state);
+            }
+            else if (--dependentIt->second.pendingDependencies == 0)
+            {
+                enqueue(dependent, dependentIt->second);
+            }
+        }
+    }
+
+    void AssetManager::workerLoop()
+    {
+        while (true)
+        {
+            asset_id id;
+            AssetType type;
+            std::string path;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_queueCondition.wait(lock, [this]() { return m_stopping || !m_queue.empty(); });
+                if (m_stopping)
+                    return;
+
+                id = m_queue.top().id;
+                m_queue.pop();
+
+                // Cancelled or released while queued
+                auto recordIt = m_records.find(id);
+                if (recordIt == m_records.end() || recordIt->second.state != AssetState::Queued)
+                    continue;
+
+                recordIt->second.state = AssetState::Loading;
+                type = recordIt->second.type;
+                path = recordIt->second.path;
+            }
+
+            load(id, type, path);
+        }
+    }
+
+    void AssetManager::load(asset_id id, AssetType type, const std::string& path)
+    {
+        JATE_PROFILE_SCOPE("AssetManager::load");
+
+        std::shared_ptr<const void> data;
+        std::optional<MeshSlots> meshSlots;
+        try
+        {
+            if (type == AssetType::File)
+            {
+                data = std::make_shared<const MappedFile>(path);
+            }
+            else
+            {
+                // Copied once, from the mapping into staging memory. The GPU copy is recorded by the next frame.
+                auto mesh = std::make_shared<const MeshAsset>(path);
+                rendering::renderer_memory_slot_id verticesSlot = m_renderer->allocateVertexData(mesh->getVertices());
+                try
+                {
+                    meshSlots = MeshSlots{verticesSlot, m_renderer->allocateIndexData(mesh->getIndices())};
+                }
+                catch (...)
+                {
+                    // Nothing references the vertices yet : they can be freed right away
+                    m_renderer->freeVertexData(verticesSlot);
+                    throw;
+                }
+                data = std::move(mesh);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            spdlog::error("[Asset Manager] Could not load {} : {}", path, e.what());
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto recordIt = m_records.find(id);
+        if (recordIt == m_records.end() || recordIt->second.state != AssetState::Loading)
+        {
+            // Cancelled or released while loading : the result is dropped
+            if (meshSlots.has_value())
+            {
+                m_slotsToFree.push_back(meshSlots.value());
+            }
+            return;
+        }
+
+        if (data == nullptr)
+        {
+            finish(id, AssetState::Failed);
+            return;
+        }
+
+        AssetRecord& record = recordIt->second;
+        record.data = std::move(data);
+        record.meshSlots = meshSlots;
+
+        if (type != AssetType::Mesh)
+        {
+            finish(id, AssetState::Ready);
+            return;
+        }
+
+        // The renderer never calls back into the manager while holding its own lock : holding m_mutex here is safe
+        record.state = AssetState::Uploading;
+        std::weak_ptr<UploadCompletions> uploadCompletions = m_uploadCompletions;
+        m_renderer->onUploadsComplete([uploadCompletions, id]() {
+            if (std::shared_ptr<UploadCompletions> completions = uploadCompletions.lock())
+            {
+                std::lock_guard<std::mutex> completionsLock(completions->mutex);
+                completions->ids.push_back(id);
+            }
+        });
+    }
+
+    void AssetManager::cancel(asset_id id)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto recordIt = m_records.find(id);
+        if (recordIt == m_records.end())
+            return;
+
+        AssetRecord& record = recordIt->second;
+        switch (record.state)
+        {
+            case AssetState::Waiting:
+            case AssetState::Queued:
+            case AssetState::Loading:
+                // Queued loads are skipped by workers, running ones are dropped once done
+                finish(id, AssetState::Cancelled);
+                break;
+            case AssetState::Uploading:
+                // Freeing slots before their upload is recorded is fine : their buffers are released after the frame that would use them
+                m_slotsToFree.push_back(record.meshSlots.value());
+                record.meshSlots.reset();
+                record.data = nullptr;
+                finish(id, AssetState::Cancelled);
+                break;
+            default:
+                break;
+        }
+    }
+
+    void AssetManager::release(asset_id id)
+    {
+        cancel(id);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto recordIt = m_records.find(id);
+        if (recordIt == m_records.end())
+            return;
+
+        if (recordIt->second.meshSlots.has_value())
+        {
+            m_slotsToFree.push_back(recordIt->second.meshSlots.value());
+        }
+        m_records.erase(recordIt);
+    }
+
+    void AssetManager::update(rendering::RenderSnapshot& snapshot)
+    {
+        JATE_PROFILE_SCOPE("AssetManager::update");
+
+        std::vector<asset_id> uploaded;
+        {
+            std::lock_guard<std::mutex> lock(m_uploadCompletions->mutex);
+            uploaded.swap(m_uploadCompletions->ids);
+        }
+
+        std::vector<std::pair<completion_callback, std::pair<asset_id, AssetState>>> callbacks;
+        std::vector<MeshSlots> slotsToFree;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            for (asset_id id : uploaded)
+            {
+                // Cancelled or released assets were already handled
+                auto recordIt = m_records.find(id);
+                if (recordIt != m_records.end() && recordIt->second.state == AssetState::Uploading)
+                {
+                    finish(id, AssetState::Ready);
+                }
+            }
+
+            for (asset_id id : m_completed)
+            {
+                auto recordIt = m_records.find(id);
+                if (recordIt != m_records.end() && recordIt->second.onComplete)
+                {
+                    callbacks.push_back({recordIt->second.onComplete, {id, recordIt->second.state}});
+                }
+            }
+            m_completed.clear();
+            slotsToFree.swap(m_slotsToFree);
+        }
+
+        // Freed once the snapshot is rendered : snapshots queued before it may still draw these meshes
+        for (const auto& slots : slotsToFree)
+        {
+            snapshot.freedVertexSlots.push_back(slots.verticesSlot);
+            snapshot.freedIndexSlots.push_back(slots.indicesSlot);
+        }
+
+        // Outside of the lock : callbacks may load, cancel or release assets
+        for (const auto& [callback, completion] : callbacks)
+        {
+            callback(completion.first, completion.second);
+        }
+    }
+
+    AssetState AssetManager::getState(asset_id id) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto recordIt = m_records.find(id);
+        if (recordIt == m_records.end())
+            return AssetState::Cancelled;
+
+        return recordIt->second.state;
+    }
+
+    std::shared_ptr<const MappedFile> AssetManager::getFile(AssetHandle<MappedFile> handle) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto recordIt = m_records.find(handle.id);
+        if (recordIt == m_records.end() || recordIt->second.state != AssetState::Ready || recordIt->second.type != AssetType::File)
+            return nullptr;
+
+        return std::static_pointer_cast<const MappedFile>(recordIt->second.data);
+    }
+
+    std::shared_ptr<const MeshAsset> AssetManager::getMesh(AssetHandle<MeshAsset> handle) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto recordIt = m_records.find(handle.id);
+        if (recordIt == m_records.end() || recordIt->second.state != AssetState::Ready || recordIt->second.type != AssetType::Mesh)
+            return nullptr;
+
+        return std::static_pointer_cast<const MeshAsset>(recordIt->second.data);
+    }
+
+    std::optional<MeshSlots> AssetManager::getMeshSlots(AssetHandle<MeshAsset> handle) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto recordIt = m_records.find(handle.id);
+        if (recordIt == m_records.end() || recordIt->second.state != AssetState::Ready)
+            return std::nullopt;
+
+        return recordIt->second.meshSlots;
+    }
+}
\ No newline at end of file
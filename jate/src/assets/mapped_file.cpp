@@ -0,0 +1,91 @@
+#include <jate/assets/mapped_file.h>
+
+#include <stdexcept>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace jate::assets
+{
+#ifdef _WIN32
+    MappedFile::MappedFile(const std::string& path)
+        : m_path(path)
+    {
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            throw std::runtime_error("[Mapped File] Could not open " + path);
+        }
+        m_fileHandle = file;
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+        {
+            CloseHandle(file);
+            throw std::runtime_error("[Mapped File] Could not map " + path + " : empty file");
+        }
+        m_size = static_cast<size_t>(fileSize.QuadPart);
+
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        void* data = mapping != nullptr ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (data == nullptr)
+        {
+            if (mapping != nullptr) CloseHandle(mapping);
+            CloseHandle(file);
+            throw std::runtime_error("[Mapped File] Could not map " + path);
+        }
+        m_mappingHandle = mapping;
+        m_data = static_cast<const std::byte*>(data);
+    }
+
+    MappedFile::~MappedFile()
+    {
+        UnmapViewOfFile(m_data);
+        CloseHandle(static_cast<HANDLE>(m_mappingHandle));
+        CloseHandle(static_cast<HANDLE>(m_fileHandle));
+    }
+#else
+    MappedFile::MappedFile(const std::string& path)
+        : m_path(path)
+    {
+        int fileDescriptor = open(path.c_str(), O_RDONLY);
+        if (fileDescriptor < 0)
+        {
+            throw std::runtime_error("[Mapped File] Could not open " + path);
+        }
+
+        struct stat fileStatus;
+        if (fstat(fileDescriptor, &fileStatus) != 0 || fileStatus.st_size == 0)
+        {
+            close(fileDescriptor);
+            throw std::runtime_error("[Mapped File] Could not map " + path + " : empty file");
+        }
+        m_size = static_cast<size_t>(fileStatus.st_size);
+
+        // The mapping keeps its own reference to the file
+        void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+        close(fileDescriptor);
+        if (data == MAP_FAILED)
+        {
+            throw std::runtime_error("[Mapped File] Could not map " + path);
+        }
+
+        // Assets are read once, front to back : let the OS read ahead (advice values are not flags, hence two calls)
+        madvise(data, m_size, MADV_SEQUENTIAL);
+        madvise(data, m_size, MADV_WILLNEED);
+        m_data = static_cast<const std::byte*>(data);
+    }
+
+    MappedFile::~MappedFile()
+    {
+        munmap(const_cast<std::byte*>(m_data), m_size);
+    }
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,159 @@
+#include <jate/assets/mesh_asset.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace jate::assets
+{
+    static_assert(sizeof(MeshFileHeader) == 16, "MeshFileHeader is part of the file format");
+    static_assert(sizeof(MeshFileSection) == 24, "MeshFileSection is part of the file format");
+    static_assert(sizeof(MeshBounds) == 24, "MeshBounds is part of the file format");
+
+    static uint64_t alignSectionOffset(uint64_t offset)
+    {
+        return (offset + MeshAsset::ms_SECTION_ALIGNMENT - 1) & ~(MeshAsset::ms_SECTION_ALIGNMENT - 1);
+    }
+
+    MeshAsset::MeshAsset(const std::string& path)
+        : m_file(path)
+    {
+        if (m_file.getSize() < sizeof(MeshFileHeader))
+        {
+            throw std::runtime_error("[Mesh Asset] " + path + " is too small to be a mesh file");
+        }
+
+        const MeshFileHeader* header = reinterpret_cast<const MeshFileHeader*>(m_file.getData());
+        if (memcmp(header->magic, ms_MAGIC, sizeof(ms_MAGIC)) != 0)
+        {
+            throw std::runtime_error("[Mesh Asset] " + path + " is not a mesh file");
+        }
+        if (header->version != ms_VERSION || header->vertexStride != sizeof(rendering::VertexData))
+        {
+            throw std::runtime_error("[Mesh Asset] " + path + " was written for another version : convert it again");
+        }
+        if (sizeof(MeshFileHeader) + sizeof(MeshFileSection) * static_cast<uint64_t>(header->sectionCount) > m_file.getSize())
+        {
+            throw std::runtime_error("[Mesh Asset] " + path + " is truncated");
+        }
+
+        m_vertices = getSection<rendering::VertexData>(MeshSectionType::Vertices);
+        m_indices = getSection<uint32_t>(MeshSectionType::Indices);
+        if (m_vertices.size() < 3 || m_indices.size() < 3)
+        {
+            throw std::runtime_error("[Mesh Asset] " + path + " has no triangle");
+        }
+
+        // Indices go straight to the GPU, which does not check them : an index out of the vertices would read past the vertex buffer
+        size_t vertexCount = m_vertices.size();
+        if (m_indices.size() % 3 != 0 || std::any_of(m_indices.begin(), m_indices.end(), [vertexCount](uint32_t index) { return index >= vertexCount; }))
+        {
+            throw std::runtime_error("[Mesh Asset] " + path + " has an invalid index");
+        }
+
+        // Bounds are optional : files written without them get them computed here
+        std::span<const MeshBounds> bounds = getSection<MeshBounds>(MeshSectionType::Bounds);
+        m_bounds = bounds.empty() ? computeBounds(m_vertices) : bounds.front();
+    }
+
+    template <typename T>
+    std::span<const T> MeshAsset::getSection(MeshSectionType type) const
+    {
+        const MeshFileHeader* header = reinterpret_cast<const MeshFileHeader*>(m_file.getData());
+        const MeshFileSection* sections = reinterpret_cast<const MeshFileSection*>(m_file.getData() + sizeof(MeshFileHeader));
+
+        for (uint32_t i = 0; i < header->sectionCount; i++)
+        {
+            const MeshFileSection& section = sections[i];
+            if (section.type != type)
+                continue;
+
+            // Offsets are aligned, so the data is correctly aligned for T once mapped (mappings start on a page boundary)
+            if (section.offset % ms_SECTION_ALIGNMENT != 0 || section.size % sizeof(T) != 0 ||
+                section.offset > m_file.getSize() || section.size > m_file.getSize() - section.offset)
+            {
+                throw std::runtime_error("[Mesh Asset] " + m_file.getPath() + " has an invalid section");
+            }
+
+            const T* data = reinterpret_cast<const T*>(m_file.getData() + section.offset);
+            return {data, static_cast<size_t>(section.size / sizeof(T))};
+        }
+
+        return {};
+    }
+
+    void MeshAsset::write(const std::string& path, std::span<const rendering::VertexData> vertices, std::span<const uint32_t> indices)
+    {
+        MeshBounds bounds = computeBounds(vertices);
+
+        struct SectionSource
+        {
+            MeshSectionType type;
+            const void* data;
+            uint64_t size;
+        };
+        const SectionSource sources[] = {
+            {MeshSectionType::Vertices, vertices.data(), vertices.size_bytes()},
+            {MeshSectionType::Indices, indices.data(), indices.size_bytes()},
+            {MeshSectionType::Bounds, &bounds, sizeof(bounds)},
+        };
+        constexpr uint32_t sectionCount = static_cast<uint32_t>(std::size(sources));
+
+        MeshFileHeader header{};
+        memcpy(header.magic, ms_MAGIC, sizeof(ms_MAGIC));
+        header.version = ms_VERSION;
+        header.vertexStride = sizeof(rendering::VertexData);
+        header.sectionCount = sectionCount;
+
+        MeshFileSection sections[sectionCount]{};
+        uint64_t offset = alignSectionOffset(sizeof(MeshFileHeader) + sizeof(sections));
+        for (uint32_t i = 0; i < sectionCount; i++)
+        {
+            sections[i].type = sources[i].type;
+            sections[i].offset = offset;
+            sections[i].size = sources[i].size;
+            offset = alignSectionOffset(offset + sources[i].size);
+        }
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            throw std::runtime_error("[Mesh Asset] Could not open " + path + " for writing");
+        }
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(sections), sizeof(sections));
+
+        const char padding[ms_SECTION_ALIGNMENT] = {};
+        uint64_t writtenSize = sizeof(header) + sizeof(sections);
+        for (uint32_t i = 0; i < sectionCount; i++)
+        {
+            file.write(padding, static_cast<std::streamsize>(sections[i].offset - writtenSize));
+            file.write(static_cast<const char*>(sources[i].data), static_cast<std::streamsize>(sources[i].size));
+            writtenSize = sections[i].offset + sections[i].size;
+        }
+
+        if (!file)
+        {
+            throw std::runtime_error("[Mesh Asset] Could not write " + path);
+        }
+    }
+
+    MeshBounds MeshAsset::computeBounds(std::span<const rendering::VertexData> vertices)
+    {
+        if (vertices.empty())
+            return {glm::vec3(0.f), glm::vec3(0.f)};
+
+        MeshBounds bounds {glm::vec3(std::numeric_limits<float>::max()), glm::vec3(std::numeric_limits<float>::lowest())};
+        for (const auto& vertex : vertices)
+        {
+            bounds.min = glm::min(bounds.min, vertex.position);
+            bounds.max = glm::max(bounds.max, vertex.position);
+        }
+        return bounds;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+#include <jate/components/render_units/mesh_render_unit.h>
+
+#include <jate/models/entity.h>
+
+namespace jate::components
+{
+    void AMeshRenderUnit::draw(rendering::ARenderer* renderer, rendering::RenderSnapshot& snapshot, float interpolationAlpha)
+    {
+        if (!m_initialized)
+        {
+            initialize(renderer);
+        }
+
+        rendering::DrawCommand& drawCommand = snapshot.drawCommands.emplace_back();
+        drawCommand.verticesSlot = m_allocatedData.verticesSlot;
+        drawCommand.indicesSlot = m_allocatedData.indicesSlot;
+        drawCommand.pushConstantData.transform = m_entity->getInterpolatedTransform(interpolationAlpha).getMatrix();
+    }
+
+    void AMeshRenderUnit::initialize(rendering::ARenderer* renderer)
+    {
+        m_allocatedData = allocateRenderingData(renderer);
+        m_initialized = true;
+    }
+
+    void AMeshRenderUnit::free(rendering::RenderSnapshot& snapshot)
+    {
+        if (!m_initialized)
+            return;
+
+        snapshot.freedVertexSlots.push_back(m_allocatedData.verticesSlot);
+        snapshot.freedIndexSlots.push_back(m_allocatedData.indicesSlot);
+        m_initialized = false;
+    }
+}
\ No newline at end of file
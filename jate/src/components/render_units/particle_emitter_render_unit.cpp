@@ -0,0 +1,39 @@
+#include <jate/components/render_units/particle_emitter_render_unit.h>
+
+#include <jate/models/entity.h>
+
+namespace jate::components
+{
+    void ParticleEmitterRenderUnit::setSettings(const rendering::ParticleEmitterSettings& settings)
+    {
+        m_settings = settings;
+    }
+
+    void ParticleEmitterRenderUnit::setOffset(const glm::vec3& offset)
+    {
+        m_offset = offset;
+    }
+
+    void ParticleEmitterRenderUnit::draw(rendering::ARenderer* renderer, rendering::RenderSnapshot& snapshot, float interpolationAlpha)
+    {
+        if (!m_particleSystem.has_value())
+        {
+            m_particleSystem = renderer->createParticleSystem(m_settings);
+        }
+
+        glm::vec4 emitterPosition = m_entity->getInterpolatedTransform(interpolationAlpha).getMatrix() * glm::vec4(m_offset, 1.f);
+
+        rendering::ParticleDrawCommand& particleCommand = snapshot.particleCommands.emplace_back();
+        particleCommand.particleSystem = m_particleSystem.value();
+        particleCommand.emitterPosition = {emitterPosition.x, emitterPosition.y, emitterPosition.z};
+    }
+
+    void ParticleEmitterRenderUnit::free(rendering::RenderSnapshot& snapshot)
+    {
+        if (!m_particleSystem.has_value())
+            return;
+
+        snapshot.freedParticleSystems.push_back(m_particleSystem.value());
+        m_particleSystem.reset();
+    }
+}
\ No newline at end of file
@@ -12,7 +12,7 @@ namespace jate::components
         m_height = height;
     }
 
-    ARenderUnit::AllocatedRenderingData Rect2DRenderUnit::allocateRenderingData(rendering::ARenderer* renderer) const
+    AMeshRenderUnit::AllocatedRenderingData Rect2DRenderUnit::allocateRenderingData(rendering::ARenderer* renderer) const
     {
         glm::vec3 color = {1.f, 1.f, 1.f};
         float posZ = m_entity->getTransform().position.z;
@@ -0,0 +1,43 @@
+#include <jate/components/render_units/sprite_render_unit.h>
+
+#include <jate/models/entity.h>
+
+namespace jate::components
+{
+    void SpriteRenderUnit::setTexture(rendering::renderer_texture_id textureId)
+    {
+        m_texture = textureId;
+    }
+
+    void SpriteRenderUnit::setRect(float centerX, float centerY, float width, float height)
+    {
+        m_centerX = centerX;
+        m_centerY = centerY;
+        m_width = width;
+        m_height = height;
+    }
+
+    void SpriteRenderUnit::setColor(const glm::vec4& color)
+    {
+        m_color = color;
+    }
+
+    void SpriteRenderUnit::draw(rendering::ARenderer* renderer, rendering::RenderSnapshot& snapshot, float interpolationAlpha)
+    {
+        if (!m_texture.has_value())
+            return;
+
+        // The unit quad is scaled to the rectangle, then moved with the entity
+        glm::mat4 rectMatrix{
+            {m_width, 0.f, 0.f, 0.f},
+            {0.f, m_height, 0.f, 0.f},
+            {0.f, 0.f, 1.f, 0.f},
+            {m_centerX, m_centerY, 0.f, 1.f}
+        };
+
+        rendering::SpriteDrawCommand& spriteCommand = snapshot.spriteCommands.emplace_back();
+        spriteCommand.texture = m_texture.value();
+        spriteCommand.transform = m_entity->getInterpolatedTransform(interpolationAlpha).getMatrix() * rectMatrix;
+        spriteCommand.color = m_color;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,24 @@
+#include <jate/components/render_units/static_mesh_render_unit.h>
+
+#include <stdexcept>
+
+namespace jate::components
+{
+    void StaticMeshRenderUnit::setMesh(std::shared_ptr<const assets::MeshAsset> mesh)
+    {
+        m_mesh = std::move(mesh);
+    }
+
+    AMeshRenderUnit::AllocatedRenderingData StaticMeshRenderUnit::allocateRenderingData(rendering::ARenderer* renderer) const
+    {
+        if (m_mesh == nullptr)
+        {
+            throw std::runtime_error("[Static Mesh Render Unit] Drawn without a mesh");
+        }
+
+        return {
+            .verticesSlot = renderer->allocateVertexData(m_mesh->getVertices()),
+            .indicesSlot = renderer->allocateIndexData(m_mesh->getIndices())
+        };
+    }
+}
\ No newline at end of file
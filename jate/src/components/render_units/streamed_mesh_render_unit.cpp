@@ -0,0 +1,28 @@
+#include <jate/components/render_units/streamed_mesh_render_unit.h>
+
+#include <jate/models/entity.h>
+
+namespace jate::components
+{
+    void StreamedMeshRenderUnit::setMesh(assets::AssetManager* assetManager, assets::AssetHandle<assets::MeshAsset> mesh)
+    {
+        m_assetManager = assetManager;
+        m_mesh = mesh;
+    }
+
+    void StreamedMeshRenderUnit::draw(rendering::ARenderer* renderer, rendering::RenderSnapshot& snapshot, float interpolationAlpha)
+    {
+        if (m_assetManager == nullptr)
+            return;
+
+        // Asked every frame rather than cached : the mesh stops being drawn as soon as it is released
+        std::optional<assets::MeshSlots> meshSlots = m_assetManager->getMeshSlots(m_mesh);
+        if (!meshSlots.has_value())
+            return;
+
+        rendering::DrawCommand& drawCommand = snapshot.drawCommands.emplace_back();
+        drawCommand.verticesSlot = meshSlots->verticesSlot;
+        drawCommand.indicesSlot = meshSlots->indicesSlot;
+        drawCommand.pushConstantData.transform = m_entity->getInterpolatedTransform(interpolationAlpha).getMatrix();
+    }
+}
\ No newline at end of file
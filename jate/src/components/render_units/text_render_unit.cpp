@@ -0,0 +1,75 @@
+#include <jate/components/render_units/text_render_unit.h>
+
+#include <jate/models/entity.h>
+
+namespace jate::components
+{
+    void TextRenderUnit::setFont(std::shared_ptr<rendering::BitmapFont> font)
+    {
+        m_font = std::move(font);
+        m_layout = nullptr;
+    }
+
+    void TextRenderUnit::setText(const std::string& text)
+    {
+        if (text == m_text)
+            return;
+
+        m_text = text;
+        m_layout = nullptr;
+    }
+
+    void TextRenderUnit::setPosition(float x, float y)
+    {
+        m_x = x;
+        m_y = y;
+    }
+
+    void TextRenderUnit::setGlyphSize(float width, float height)
+    {
+        m_glyphWidth = width;
+        m_glyphHeight = height;
+    }
+
+    void TextRenderUnit::setColor(const glm::vec4& color)
+    {
+        m_color = color;
+    }
+
+    void TextRenderUnit::free(rendering::RenderSnapshot& snapshot)
+    {
+        // Fonts only held by units are released through the snapshot : queued snapshots may still draw their glyphs
+        if (m_font != nullptr && m_font.use_count() == 1)
+        {
+            m_font->release(snapshot);
+        }
+        m_layout = nullptr;
+    }
+
+    void TextRenderUnit::draw(rendering::ARenderer* renderer, rendering::RenderSnapshot& snapshot, float interpolationAlpha)
+    {
+        if (m_font == nullptr || m_text.empty())
+            return;
+
+        if (m_layout == nullptr)
+        {
+            m_font->upload(renderer);
+            m_layout = m_font->layout(m_text);
+        }
+
+        // Glyphs only differ by their translation : the scaled entity axes are computed once,
+        // and each glyph transform is entityMatrix * translate(cellCenter) * scale(glyphSize), expanded
+        glm::mat4 entityMatrix = m_entity->getInterpolatedTransform(interpolationAlpha).getMatrix();
+        glm::vec4 xAxis = entityMatrix[0] * m_glyphWidth;
+        glm::vec4 yAxis = entityMatrix[1] * m_glyphHeight;
+        glm::vec4 origin = entityMatrix * glm::vec4(m_x + m_glyphWidth * 0.5f, m_y + m_glyphHeight * 0.5f, 0.f, 1.f);
+
+        for (const auto& glyph : m_layout->glyphs)
+        {
+            rendering::SpriteDrawCommand& spriteCommand = snapshot.spriteCommands.emplace_back();
+            spriteCommand.texture = glyph.texture;
+            spriteCommand.transform = glm::mat4(xAxis, yAxis, entityMatrix[2], origin + xAxis * glyph.offset.x + yAxis * glyph.offset.y);
+            spriteCommand.color = m_color;
+        }
+    }
+}
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include <jate/models/world.h>
 
 #include <jate/systems/render_system.h>
+#include <jate/profiling/cpu_profiler.h>
 
 namespace jate::models
 {
@@ -11,7 +12,7 @@ namespace jate::models
 
     void World::init_registerSystems()
     {
-        m_systems.emplace(systems::SystemEnum::RENDER_SYSTEM, std::make_unique<systems::RenderSystem>(m_renderer));
+        m_systems.emplace(systems::SystemEnum::RENDER_SYSTEM, std::make_unique<systems::RenderSystem>(m_renderer, &m_renderSnapshot));
     }
 
     Entity* World::spawnEntity()
@@ -20,11 +21,41 @@ namespace jate::models
         return spawnedEntity;
     }
 
-    void jate::models::World::tickSystems()
+    void World::despawnEntity(Entity* entity)
     {
+        std::erase_if(m_entities, [entity](const std::unique_ptr<Entity>& e) { return e.get() == entity; });
+    }
+
+    void World::fixedTickSystems(double fixedDeltaTime, std::span<const input::InputEvent> inputEvents)
+    {
+        JATE_PROFILE_FUNCTION();
+
+        for (const auto& entity : m_entities)
+        {
+            entity->savePreviousTransform();
+        }
+
+        for (const auto& event : inputEvents)
+        {
+            for (const auto& system : m_systems)
+            {
+                system.second->onInputEvent(event);
+            }
+        }
+
+        for (const auto& system : m_systems)
+        {
+            system.second->fixedTick(fixedDeltaTime);
+        }
+    }
+
+    void World::tickSystems(float interpolationAlpha)
+    {
+        JATE_PROFILE_FUNCTION();
+
         for (const auto& system : m_systems)
         {
-            system.second->tick();
+            system.second->tick(interpolationAlpha);
         }
     }
 
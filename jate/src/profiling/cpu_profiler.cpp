@@ -0,0 +1,155 @@
+#include <jate/profiling/cpu_profiler.h>
+
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+
+namespace jate::profiling
+{
+    namespace
+    {
+        uint64_t steadyClockNs()
+        {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+        void writeJsonEscaped(std::ofstream& file, const char* str)
+        {
+            for (const char* c = str; *c != '\0'; c++)
+            {
+                if (*c == '"' || *c == '\\')
+                    file << '\\';
+                file << *c;
+            }
+        }
+    }
+
+    CpuProfiler& CpuProfiler::get()
+    {
+        static CpuProfiler s_profiler;
+        return s_profiler;
+    }
+
+    CpuProfiler::CpuProfiler() : m_startTicks(steadyClockNs())
+    {
+    }
+
+    uint64_t CpuProfiler::now() const
+    {
+        return steadyClockNs() - m_startTicks;
+    }
+
+    CpuProfiler::ThreadBuffer& CpuProfiler::getThreadBuffer()
+    {
+        thread_local ThreadBuffer* t_buffer = nullptr;
+        if (t_buffer != nullptr)
+            return *t_buffer;
+
+        std::lock_guard<std::mutex> lock(m_threadBuffersMutex);
+
+        auto buffer = std::make_unique<ThreadBuffer>();
+        buffer->threadId = static_cast<uint32_t>(m_threadBuffers.size());
+        buffer->events.resize(ms_EVENTS_PER_THREAD);
+
+        t_buffer = m_threadBuffers.emplace_back(std::move(buffer)).get();
+        return *t_buffer;
+    }
+
+    void CpuProfiler::recordZone(const char* name, uint64_t startNs, uint64_t endNs)
+    {
+        ThreadBuffer& buffer = getThreadBuffer();
+
+        // Sequence lock : an export copying this slot meanwhile sees that its write started, and drops it.
+        // Fields go through atomic_ref, so that the concurrent copy is not a data race.
+        uint64_t index = buffer.recordedCount.load(std::memory_order_relaxed);
+        buffer.startedCount.store(index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        ProfileZoneEvent& event = buffer.events[index % buffer.events.size()];
+        std::atomic_ref<const char*>(event.name).store(name, std::memory_order_relaxed);
+        std::atomic_ref<uint64_t>(event.startNs).store(startNs, std::memory_order_relaxed);
+        std::atomic_ref<uint64_t>(event.endNs).store(endNs, std::memory_order_relaxed);
+
+        buffer.recordedCount.store(index + 1, std::memory_order_release);
+    }
+
+    bool CpuProfiler::exportChromeTrace(const std::string& path)
+    {
+        std::ofstream file(path, std::ios::trunc);
+        if (!file.is_open())
+        {
+            spdlog::error("Failed to open {} to export CPU profile", path);
+            return false;
+        }
+
+        file << std::fixed << std::setprecision(3);
+        file << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+        // Snapshot every buffer first. Recording threads are never blocked : they keep writing while their buffer is copied.
+        std::vector<std::pair<uint32_t, std::vector<ProfileZoneEvent>>> threadEvents;
+        {
+            std::lock_guard<std::mutex> lock(m_threadBuffersMutex);
+            for (const auto& buffer : m_threadBuffers)
+            {
+                uint64_t capacity = buffer->events.size();
+                uint64_t end = buffer->recordedCount.load(std::memory_order_acquire);
+                uint64_t begin = end > capacity ? end - capacity : 0;
+
+                std::vector<ProfileZoneEvent> events;
+                events.reserve(static_cast<size_t>(end - begin));
+                for (uint64_t index = begin; index < end; index++)
+                {
+                    ProfileZoneEvent& event = buffer->events[index % capacity];
+                    events.push_back({
+                        std::atomic_ref<const char*>(event.name).load(std::memory_order_relaxed),
+                        std::atomic_ref<uint64_t>(event.startNs).load(std::memory_order_relaxed),
+                        std::atomic_ref<uint64_t>(event.endNs).load(std::memory_order_relaxed)
+                    });
+                }
+
+                // Zones whose slot was rewritten during the copy may be torn : the oldest ones are dropped
+                std::atomic_thread_fence(std::memory_order_acquire);
+                uint64_t started = buffer->startedCount.load(std::memory_order_relaxed);
+                uint64_t firstIntact = started > capacity ? started - capacity : 0;
+                if (firstIntact > begin)
+                {
+                    events.erase(events.begin(), events.begin() + static_cast<ptrdiff_t>(std::min(firstIntact - begin, end - begin)));
+                }
+
+                threadEvents.emplace_back(buffer->threadId, std::move(events));
+            }
+        }
+
+        bool firstEvent = true;
+        size_t eventCount = 0;
+        for (const auto& [threadId, events] : threadEvents)
+        {
+            for (const auto& event : events)
+            {
+                if (!firstEvent) file << ",";
+                firstEvent = false;
+
+                // Chrome trace timestamps are in microseconds
+                file << "\n{\"name\":\"";
+                writeJsonEscaped(file, event.name);
+                file << "\",\"cat\":\"jate\",\"ph\":\"X\",\"pid\":1,\"tid\":" << threadId
+                     << ",\"ts\":" << static_cast<double>(event.startNs) / 1000.0
+                     << ",\"dur\":" << static_cast<double>(event.endNs - event.startNs) / 1000.0 << "}";
+                eventCount++;
+            }
+        }
+
+        file << "\n]}\n";
+        if (!file)
+        {
+            spdlog::error("Failed to write CPU profile to {}", path);
+            return false;
+        }
+
+        spdlog::info("Exported {} CPU profile zones to {}", eventCount, path);
+        return true;
+    }
+}
\ No newline at end of file
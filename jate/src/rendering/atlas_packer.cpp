@@ -0,0 +1,129 @@
+#include <jate/rendering/atlas_packer.h>
+
+#include <algorithm>
+
+namespace jate::rendering
+{
+    ShelfAtlasPacker::ShelfAtlasPacker(uint32_t width, uint32_t height, uint32_t alignment)
+        : m_width(width), m_height(height), m_alignment(std::max<uint32_t>(alignment, 1))
+    {
+    }
+
+    uint32_t ShelfAtlasPacker::align(uint32_t value) const
+    {
+        return (std::max<uint32_t>(value, 1) + m_alignment - 1) / m_alignment * m_alignment;
+    }
+
+    std::optional<AtlasRegion> ShelfAtlasPacker::allocate(uint32_t width, uint32_t height)
+    {
+        width = align(width);
+        height = align(height);
+        if (width > m_width || height > m_height)
+            return std::nullopt;
+
+        auto fitsIn = [width, height](const Shelf& shelf) {
+            return shelf.height >= height && std::any_of(shelf.freeSpans.begin(), shelf.freeSpans.end(),
+                [width](const FreeSpan& span) { return span.width >= width; });
+        };
+
+        // Smallest shelf the rectangle fits in, as long as it does not waste more than half of its height
+        Shelf* bestShelf = nullptr;
+        for (auto& shelf : m_shelves)
+        {
+            if (shelf.height > height + height / 2 || !fitsIn(shelf))
+                continue;
+            if (bestShelf == nullptr || shelf.height < bestShelf->height)
+                bestShelf = &shelf;
+        }
+
+        if (bestShelf == nullptr && m_nextShelfY + height <= m_height)
+        {
+            m_shelves.push_back({m_nextShelfY, height, {{0, m_width}}});
+            m_nextShelfY += height;
+            bestShelf = &m_shelves.back();
+        }
+
+        // The atlas is almost full : any shelf will do, whatever the wasted height
+        if (bestShelf == nullptr)
+        {
+            for (auto& shelf : m_shelves)
+            {
+                if (!fitsIn(shelf))
+                    continue;
+                if (bestShelf == nullptr || shelf.height < bestShelf->height)
+                    bestShelf = &shelf;
+            }
+        }
+
+        if (bestShelf == nullptr)
+            return std::nullopt;
+
+        std::optional<uint32_t> x = takeSpan(*bestShelf, width);
+        m_usedArea += static_cast<uint64_t>(width) * height;
+        return AtlasRegion{x.value(), bestShelf->y, width, height};
+    }
+
+    std::optional<uint32_t> ShelfAtlasPacker::takeSpan(Shelf& shelf, uint32_t width)
+    {
+        // Best fit : the smallest span, so that wide spans stay available for wide rectangles
+        auto bestSpan = shelf.freeSpans.end();
+        for (auto spanIt = shelf.freeSpans.begin(); spanIt != shelf.freeSpans.end(); spanIt++)
+        {
+            if (spanIt->width >= width && (bestSpan == shelf.freeSpans.end() || spanIt->width < bestSpan->width))
+                bestSpan = spanIt;
+        }
+
+        if (bestSpan == shelf.freeSpans.end())
+            return std::nullopt;
+
+        uint32_t x = bestSpan->x;
+        bestSpan->x += width;
+        bestSpan->width -= width;
+        if (bestSpan->width == 0)
+            shelf.freeSpans.erase(bestSpan);
+
+        return x;
+    }
+
+    void ShelfAtlasPacker::free(const AtlasRegion& region)
+    {
+        auto shelfIt = std::find_if(m_shelves.begin(), m_shelves.end(), [&region](const Shelf& shelf) { return shelf.y == region.y; });
+        if (shelfIt == m_shelves.end())
+            return;
+
+        m_usedArea -= static_cast<uint64_t>(region.width) * region.height;
+
+        // Give the span back, merged with its free neighbours
+        auto& spans = shelfIt->freeSpans;
+        auto nextIt = std::find_if(spans.begin(), spans.end(), [&region](const FreeSpan& span) { return span.x > region.x; });
+        auto spanIt = spans.insert(nextIt, {region.x, region.width});
+
+        auto followingIt = spanIt + 1;
+        if (followingIt != spans.end() && spanIt->x + spanIt->width == followingIt->x)
+        {
+            spanIt->width += followingIt->width;
+            spanIt = spans.erase(followingIt) - 1;
+        }
+        if (spanIt != spans.begin())
+        {
+            auto previousIt = spanIt - 1;
+            if (previousIt->x + previousIt->width == spanIt->x)
+            {
+                previousIt->width += spanIt->width;
+                spans.erase(spanIt);
+            }
+        }
+
+        // Empty shelves at the end go back to the unused space, where shelves of any height can be opened
+        while (!m_shelves.empty())
+        {
+            const Shelf& lastShelf = m_shelves.back();
+            bool isEmpty = lastShelf.freeSpans.size() == 1 && lastShelf.freeSpans.front().width == m_width;
+            if (!isEmpty)
+                break;
+
+            m_nextShelfY = lastShelf.y;
+            m_shelves.pop_back();
+        }
+    }
+}
\ No newline at end of file
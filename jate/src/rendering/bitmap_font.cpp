@@ -0,0 +1,223 @@
+#include <jate/rendering/bitmap_font.h>
+
+#include <jate/rendering/renderer.h>
+
+#include <algorithm>
+
+namespace jate::rendering
+{
+    // Printable ASCII, from ' ' to '~'. One byte per row, top row first, least significant bit on the left.
+    // Public domain font8x8 "basic" set, derived from the IBM PC BIOS font.
+    static constexpr uint8_t s_fontData[][BitmapFont::ms_GLYPH_SIZE] = {
+        {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // ' '
+        {0x18, 0x3C, 0x3C, 0x18, 0x18, 0x00, 0x18, 0x00},  // '!'
+        {0x36, 0x36, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // '"'
+        {0x36, 0x36, 0x7F, 0x36, 0x7F, 0x36, 0x36, 0x00},  // '#'
+        {0x0C, 0x3E, 0x03, 0x1E, 0x30, 0x1F, 0x0C, 0x00},  // '$'
+        {0x00, 0x63, 0x33, 0x18, 0x0C, 0x66, 0x63, 0x00},  // '%'
+        {0x1C, 0x36, 0x1C, 0x6E, 0x3B, 0x33, 0x6E, 0x00},  // '&'
+        {0x06, 0x06, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00},  // '''
+        {0x18, 0x0C, 0x06, 0x06, 0x06, 0x0C, 0x18, 0x00},  // '('
+        {0x06, 0x0C, 0x18, 0x18, 0x18, 0x0C, 0x06, 0x00},  // ')'
+        {0x00, 0x66, 0x3C, 0xFF, 0x3C, 0x66, 0x00, 0x00},  // '*'
+        {0x00, 0x0C, 0x0C, 0x3F, 0x0C, 0x0C, 0x00, 0x00},  // '+'
+        {0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C, 0x06},  // ','
+        {0x00, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x00},  // '-'
+        {0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C, 0x00},  // '.'
+        {0x60, 0x30, 0x18, 0x0C, 0x06, 0x03, 0x01, 0x00},  // '/'
+        {0x3E, 0x63, 0x73, 0x7B, 0x6F, 0x67, 0x3E, 0x00},  // '0'
+        {0x0C, 0x0E, 0x0C, 0x0C, 0x0C, 0x0C, 0x3F, 0x00},  // '1'
+        {0x1E, 0x33, 0x30, 0x1C, 0x06, 0x33, 0x3F, 0x00},  // '2'
+        {0x1E, 0x33, 0x30, 0x1C, 0x30, 0x33, 0x1E, 0x00},  // '3'
+        {0x38, 0x3C, 0x36, 0x33, 0x7F, 0x30, 0x78, 0x00},  // '4'
+        {0x3F, 0x03, 0x1F, 0x30, 0x30, 0x33, 0x1E, 0x00},  // '5'
+        {0x1C, 0x06, 0x03, 0x1F, 0x33, 0x33, 0x1E, 0x00},  // '6'
+        {0x3F, 0x33, 0x30, 0x18, 0x0C, 0x0C, 0x0C, 0x00},  // '7'
+        {0x1E, 0x33, 0x33, 0x1E, 0x33, 0x33, 0x1E, 0x00},  // '8'
+        {0x1E, 0x33, 0x33, 0x3E, 0x30, 0x18, 0x0E, 0x00},  // '9'
+        {0x00, 0x0C, 0x0C, 0x00, 0x00, 0x0C, 0x0C, 0x00},  // ':'
+        {0x00, 0x0C, 0x0C, 0x00, 0x00, 0x0C, 0x0C, 0x06},  // ';'
+        {0x18, 0x0C, 0x06, 0x03, 0x06, 0x0C, 0x18, 0x00},  // '<'
+        {0x00, 0x00, 0x3F, 0x00, 0x00, 0x3F, 0x00, 0x00},  // '='
+        {0x06, 0x0C, 0x18, 0x30, 0x18, 0x0C, 0x06, 0x00},  // '>'
+        {0x1E, 0x33, 0x30, 0x18, 0x0C, 0x00, 0x0C, 0x00},  // '?'
+        {0x3E, 0x63, 0x7B, 0x7B, 0x7B, 0x03, 0x1E, 0x00},  // '@'
+        {0x0C, 0x1E, 0x33, 0x33, 0x3F, 0x33, 0x33, 0x00},  // 'A'
+        {0x3F, 0x66, 0x66, 0x3E, 0x66, 0x66, 0x3F, 0x00},  // 'B'
+        {0x3C, 0x66, 0x03, 0x03, 0x03, 0x66, 0x3C, 0x00},  // 'C'
+        {0x1F, 0x36, 0x66, 0x66, 0x66, 0x36, 0x1F, 0x00},  // 'D'
+        {0x7F, 0x46, 0x16, 0x1E, 0x16, 0x46, 0x7F, 0x00},  // 'E'
+        {0x7F, 0x46, 0x16, 0x1E, 0x16, 0x06, 0x0F, 0x00},  // 'F'
+        {0x3C, 0x66, 0x03, 0x03, 0x73, 0x66, 0x7C, 0x00},  // 'G'
+        {0x33, 0x33, 0x33, 0x3F, 0x33, 0x33, 0x33, 0x00},  // 'H'
+        {0x1E, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x1E, 0x00},  // 'I'
+        {0x78, 0x30, 0x30, 0x30, 0x33, 0x33, 0x1E, 0x00},  // 'J'
+        {0x67, 0x66, 0x36, 0x1E, 0x36, 0x66, 0x67, 0x00},  // 'K'
+        {0x0F, 0x06, 0x06, 0x06, 0x46, 0x66, 0x7F, 0x00},  // 'L'
+        {0x63, 0x77, 0x7F, 0x7F, 0x6B, 0x63, 0x63, 0x00},  // 'M'
+        {0x63, 0x67, 0x6F, 0x7B, 0x73, 0x63, 0x63, 0x00},  // 'N'
+        {0x1C, 0x36, 0x63, 0x63, 0x63, 0x36, 0x1C, 0x00},  // 'O'
+        {0x3F, 0x66, 0x66, 0x3E, 0x06, 0x06, 0x0F, 0x00},  // 'P'
+        {0x1E, 0x33, 0x33, 0x33, 0x3B, 0x1E, 0x38, 0x00},  // 'Q'
+        {0x3F, 0x66, 0x66, 0x3E, 0x36, 0x66, 0x67, 0x00},  // 'R'
+        {0x1E, 0x33, 0x07, 0x0E, 0x38, 0x33, 0x1E, 0x00},  // 'S'
+        {0x3F, 0x2D, 0x0C, 0x0C, 0x0C, 0x0C, 0x1E, 0x00},  // 'T'
+        {0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x3F, 0x00},  // 'U'
+        {0x33, 0x33, 0x33, 0x33, 0x33, 0x1E, 0x0C, 0x00},  // 'V'
+        {0x63, 0x63, 0x63, 0x6B, 0x7F, 0x77, 0x63, 0x00},  // 'W'
+        {0x63, 0x63, 0x36, 0x1C, 0x1C, 0x36, 0x63, 0x00},  // 'X'
+        {0x33, 0x33, 0x33, 0x1E, 0x0C, 0x0C, 0x1E, 0x00},  // 'Y'
+        {0x7F, 0x63, 0x31, 0x18, 0x4C, 0x66, 0x7F, 0x00},  // 'Z'
+        {0x1E, 0x06, 0x06, 0x06, 0x06, 0x06, 0x1E, 0x00},  // '['
+        {0x03, 0x06, 0x0C, 0x18, 0x30, 0x60, 0x40, 0x00},  // '\'
+        {0x1E, 0x18, 0x18, 0x18, 0x18, 0x18, 0x1E, 0x00},  // ']'
+        {0x08, 0x1C, 0x36, 0x63, 0x00, 0x00, 0x00, 0x00},  // '^'
+        {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF},  // '_'
+        {0x0C, 0x0C, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00},  // '`'
+        {0x00, 0x00, 0x1E, 0x30, 0x3E, 0x33, 0x6E, 0x00},  // 'a'
+        {0x07, 0x06, 0x06, 0x3E, 0x66, 0x66, 0x3B, 0x00},  // 'b'
+        {0x00, 0x00, 0x1E, 0x33, 0x03, 0x33, 0x1E, 0x00},  // 'c'
+        {0x38, 0x30, 0x30, 0x3E, 0x33, 0x33, 0x6E, 0x00},  // 'd'
+        {0x00, 0x00, 0x1E, 0x33, 0x3F, 0x03, 0x1E, 0x00},  // 'e'
+        {0x1C, 0x36, 0x06, 0x0F, 0x06, 0x06, 0x0F, 0x00},  // 'f'
+        {0x00, 0x00, 0x6E, 0x33, 0x33, 0x3E, 0x30, 0x1F},  // 'g'
+        {0x07, 0x06, 0x36, 0x6E, 0x66, 0x66, 0x67, 0x00},  // 'h'
+        {0x0C, 0x00, 0x0E, 0x0C, 0x0C, 0x0C, 0x1E, 0x00},  // 'i'
+        {0x30, 0x00, 0x30, 0x30, 0x30, 0x33, 0x33, 0x1E},  // 'j'
+        {0x07, 0x06, 0x66, 0x36, 0x1E, 0x36, 0x67, 0x00},  // 'k'
+        {0x0E, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x1E, 0x00},  // 'l'
+        {0x00, 0x00, 0x33, 0x7F, 0x7F, 0x6B, 0x63, 0x00},  // 'm'
+        {0x00, 0x00, 0x1F, 0x33, 0x33, 0x33, 0x33, 0x00},  // 'n'
+        {0x00, 0x00, 0x1E, 0x33, 0x33, 0x33, 0x1E, 0x00},  // 'o'
+        {0x00, 0x00, 0x3B, 0x66, 0x66, 0x3E, 0x06, 0x0F},  // 'p'
+        {0x00, 0x00, 0x6E, 0x33, 0x33, 0x3E, 0x30, 0x78},  // 'q'
+        {0x00, 0x00, 0x3B, 0x6E, 0x66, 0x06, 0x0F, 0x00},  // 'r'
+        {0x00, 0x00, 0x3E, 0x03, 0x1E, 0x30, 0x1F, 0x00},  // 's'
+        {0x08, 0x0C, 0x3E, 0x0C, 0x0C, 0x2C, 0x18, 0x00},  // 't'
+        {0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x6E, 0x00},  // 'u'
+        {0x00, 0x00, 0x33, 0x33, 0x33, 0x1E, 0x0C, 0x00},  // 'v'
+        {0x00, 0x00, 0x63, 0x6B, 0x7F, 0x7F, 0x36, 0x00},  // 'w'
+        {0x00, 0x00, 0x63, 0x36, 0x1C, 0x36, 0x63, 0x00},  // 'x'
+        {0x00, 0x00, 0x33, 0x33, 0x33, 0x3E, 0x30, 0x1F},  // 'y'
+        {0x00, 0x00, 0x3F, 0x19, 0x0C, 0x26, 0x3F, 0x00},  // 'z'
+        {0x38, 0x0C, 0x0C, 0x07, 0x0C, 0x0C, 0x38, 0x00},  // '{'
+        {0x18, 0x18, 0x18, 0x00, 0x18, 0x18, 0x18, 0x00},  // '|'
+        {0x07, 0x0C, 0x0C, 0x38, 0x0C, 0x0C, 0x07, 0x00},  // '}'
+        {0x6E, 0x3B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // '~'
+    };
+
+    static_assert(std::size(s_fontData) == BitmapFont::ms_LAST_CHARACTER - BitmapFont::ms_FIRST_CHARACTER + 1, "One glyph per printable ASCII character");
+
+    BitmapFont::BitmapFont(uint32_t glyphScale, size_t layoutCacheCapacity)
+        : m_glyphScale(std::max<uint32_t>(glyphScale, 1)), m_layoutCacheCapacity(std::max<size_t>(layoutCacheCapacity, 1))
+    {
+    }
+
+    BitmapFont::~BitmapFont()
+    {
+        if (m_renderer == nullptr)
+            return;
+
+        for (renderer_texture_id texture : m_glyphTextures)
+        {
+            m_renderer->freeTexture(texture);
+        }
+    }
+
+    void BitmapFont::upload(ARenderer* renderer)
+    {
+        std::lock_guard<std::mutex> lock(m_cacheMutex);
+        if (m_renderer != nullptr)
+            return;
+
+        // Coverage as alpha over white, so that the sprite color gives the text color
+        uint32_t textureSize = ms_GLYPH_SIZE * m_glyphScale;
+        std::vector<uint8_t> pixels(static_cast<size_t>(textureSize) * textureSize * 4);
+        for (size_t glyphIndex = 0; glyphIndex < m_glyphTextures.size(); glyphIndex++)
+        {
+            for (uint32_t y = 0; y < textureSize; y++)
+            {
+                uint8_t row = s_fontData[glyphIndex][y / m_glyphScale];
+                for (uint32_t x = 0; x < textureSize; x++)
+                {
+                    bool covered = (row >> (x / m_glyphScale)) & 1;
+                    uint8_t* pixel = &pixels[(static_cast<size_t>(y) * textureSize + x) * 4];
+                    pixel[0] = pixel[1] = pixel[2] = 255;
+                    pixel[3] = covered ? 255 : 0;
+                }
+            }
+            m_glyphTextures[glyphIndex] = renderer->allocateTexture(textureSize, textureSize, pixels);
+        }
+
+        m_renderer = renderer;
+    }
+
+    void BitmapFont::release(RenderSnapshot& snapshot)
+    {
+        std::lock_guard<std::mutex> lock(m_cacheMutex);
+        if (m_renderer == nullptr)
+            return;
+
+        snapshot.freedTextures.insert(snapshot.freedTextures.end(), m_glyphTextures.begin(), m_glyphTextures.end());
+        m_renderer = nullptr;
+
+        // Cached layouts reference the released textures
+        m_cachedLayouts.clear();
+        m_lruLayouts.clear();
+    }
+
+    std::shared_ptr<const TextLayout> BitmapFont::layout(const std::string& text)
+    {
+        std::lock_guard<std::mutex> lock(m_cacheMutex);
+
+        auto cachedIt = m_cachedLayouts.find(text);
+        if (cachedIt != m_cachedLayouts.end())
+        {
+            m_lruLayouts.splice(m_lruLayouts.begin(), m_lruLayouts, cachedIt->second);
+            return cachedIt->second->second;
+        }
+
+        // Shared with the units drawing it : evicting it from the cache does not invalidate their copy
+        std::shared_ptr<const TextLayout> textLayout = buildLayout(text);
+        m_lruLayouts.emplace_front(text, textLayout);
+        m_cachedLayouts[text] = m_lruLayouts.begin();
+
+        if (m_lruLayouts.size() > m_layoutCacheCapacity)
+        {
+            m_cachedLayouts.erase(m_lruLayouts.back().first);
+            m_lruLayouts.pop_back();
+        }
+
+        return textLayout;
+    }
+
+    std::shared_ptr<const TextLayout> BitmapFont::buildLayout(const std::string& text) const
+    {
+        auto textLayout = std::make_shared<TextLayout>();
+        textLayout->glyphs.reserve(text.size());
+
+        float column = 0.f;
+        float line = 0.f;
+        for (char character : text)
+        {
+            if (character == '\n')
+            {
+                column = 0.f;
+                line += 1.f;
+                continue;
+            }
+
+            if (character < ms_FIRST_CHARACTER || character > ms_LAST_CHARACTER)
+                character = '?';
+
+            if (character != ' ')
+                textLayout->glyphs.push_back({m_glyphTextures[character - ms_FIRST_CHARACTER], {column, line}});
+
+            column += 1.f;
+            textLayout->width = std::max(textLayout->width, column);
+        }
+
+        textLayout->height = text.empty() ? 0.f : line + 1.f;
+        return textLayout;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,103 @@
+#include <jate/rendering/render_thread.h>
+
+#include <jate/profiling/cpu_profiler.h>
+
+#include <spdlog/spdlog.h>
+#include <utility>
+
+namespace jate::rendering
+{
+    RenderThread::RenderThread(ARenderer* renderer)
+        : m_renderer(renderer), m_thread(&RenderThread::run, this)
+    {
+    }
+
+    RenderThread::~RenderThread()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopRequested = true;
+        }
+        m_condition.notify_all();
+
+        m_thread.join();
+    }
+
+    bool RenderThread::submit(RenderSnapshot& snapshot, std::chrono::milliseconds timeout)
+    {
+        JATE_PROFILE_SCOPE("RenderThread::submit");
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (!m_condition.wait_for(lock, timeout, [this]() { return !m_hasPendingSnapshot || m_renderError; }))
+        {
+            return false;
+        }
+        rethrowRenderError();
+
+        // The previous pending snapshot has been swapped with the one rendered before it : it is no longer used
+        std::swap(m_pendingSnapshot, snapshot);
+        m_hasPendingSnapshot = true;
+        lock.unlock();
+        m_condition.notify_all();
+
+        snapshot.clear();
+        return true;
+    }
+
+    void RenderThread::waitIdle()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condition.wait(lock, [this]() { return (!m_hasPendingSnapshot && !m_isRendering) || m_renderError; });
+        rethrowRenderError();
+    }
+
+    void RenderThread::rethrowRenderError()
+    {
+        if (m_renderError)
+        {
+            std::exception_ptr renderError = std::exchange(m_renderError, nullptr);
+            std::rethrow_exception(renderError);
+        }
+    }
+
+    void RenderThread::run()
+    {
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_condition.wait(lock, [this]() { return m_hasPendingSnapshot || m_stopRequested; });
+
+                // Stop only once the last submitted snapshot has been rendered
+                if (!m_hasPendingSnapshot)
+                    break;
+
+                std::swap(m_pendingSnapshot, m_renderedSnapshot);
+                m_hasPendingSnapshot = false;
+                m_isRendering = true;
+            }
+            m_condition.notify_all();
+
+            std::exception_ptr renderError;
+            try
+            {
+                m_renderer->renderSnapshot(m_renderedSnapshot);
+            }
+            catch (const std::exception& e)
+            {
+                spdlog::critical("Render thread : {}", e.what());
+                renderError = std::current_exception();
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_isRendering = false;
+                if (renderError)
+                {
+                    m_renderError = renderError;
+                }
+            }
+            m_condition.notify_all();
+        }
+    }
+}
\ No newline at end of file
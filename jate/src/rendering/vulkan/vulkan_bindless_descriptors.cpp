@@ -0,0 +1,200 @@
+#include <jate/rendering/vulkan/vulkan_bindless_descriptors.h>
+
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <array>
+#include <string>
+
+namespace jate::rendering::vulkan
+{
+    VulkanBindlessDescriptors::VulkanBindlessDescriptors(VulkanDevice& device, uint32_t maxTextures, uint32_t maxStorageBuffers)
+        : m_device(device)
+    {
+        init_clampToDeviceLimits(maxTextures, maxStorageBuffers);
+        init_createDescriptorSet(maxTextures, maxStorageBuffers);
+
+        m_textureSlots.capacity = maxTextures;
+        m_storageBufferSlots.capacity = maxStorageBuffers;
+    }
+
+    VulkanBindlessDescriptors::~VulkanBindlessDescriptors()
+    {
+        VkDevice device = m_device.getVkDevice();
+
+        vkDestroyDescriptorPool(device, m_descriptorPool, nullptr);     // Frees the descriptor set as well
+        vkDestroyDescriptorSetLayout(device, m_descriptorSetLayout, nullptr);
+    }
+
+    void VulkanBindlessDescriptors::init_clampToDeviceLimits(uint32_t& maxTextures, uint32_t& maxStorageBuffers) const
+    {
+        VkPhysicalDeviceDescriptorIndexingProperties descriptorIndexingProperties{};
+        descriptorIndexingProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES;
+
+        VkPhysicalDeviceProperties2 deviceProperties{};
+        deviceProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+        deviceProperties.pNext = &descriptorIndexingProperties;
+        vkGetPhysicalDeviceProperties2(m_device.getPhysicalDevice(), &deviceProperties);
+
+        // Every binding is visible to every stage : the per-stage limits apply to the whole arrays
+        uint32_t textureLimit = std::min(descriptorIndexingProperties.maxPerStageDescriptorUpdateAfterBindSampledImages,
+            descriptorIndexingProperties.maxDescriptorSetUpdateAfterBindSampledImages);
+        uint32_t storageBufferLimit = std::min(descriptorIndexingProperties.maxPerStageDescriptorUpdateAfterBindStorageBuffers,
+            descriptorIndexingProperties.maxDescriptorSetUpdateAfterBindStorageBuffers);
+
+        if (maxTextures > textureLimit || maxStorageBuffers > storageBufferLimit)
+        {
+            spdlog::warn("[Bindless Descriptors] Requested {} textures and {} storage buffers, the device limits are {} and {}",
+                maxTextures, maxStorageBuffers, textureLimit, storageBufferLimit);
+        }
+
+        maxTextures = std::max<uint32_t>(std::min(maxTextures, textureLimit), 1);
+        maxStorageBuffers = std::max<uint32_t>(std::min(maxStorageBuffers, storageBufferLimit), 1);
+    }
+
+    void VulkanBindlessDescriptors::init_createDescriptorSet(uint32_t maxTextures, uint32_t maxStorageBuffers)
+    {
+        VkDevice device = m_device.getVkDevice();
+
+        std::array<VkDescriptorSetLayoutBinding, 2> bindings{};
+        bindings[0].binding = ms_TEXTURES_BINDING;
+        bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        bindings[0].descriptorCount = maxTextures;
+        bindings[0].stageFlags = VK_SHADER_STAGE_ALL;
+        bindings[0].pImmutableSamplers = nullptr;
+
+        bindings[1].binding = ms_STORAGE_BUFFERS_BINDING;
+        bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        bindings[1].descriptorCount = maxStorageBuffers;
+        bindings[1].stageFlags = VK_SHADER_STAGE_ALL;
+        bindings[1].pImmutableSamplers = nullptr;
+
+        // Unused slots are never written, and slots are written while the set is bound by frames in flight
+        const VkDescriptorBindingFlags bindingFlag = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT
+            | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT
+            | VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT;
+        std::array<VkDescriptorBindingFlags, 2> bindingFlags = {bindingFlag, bindingFlag};
+
+        VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo{};
+        bindingFlagsInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+        bindingFlagsInfo.bindingCount = static_cast<uint32_t>(bindingFlags.size());
+        bindingFlagsInfo.pBindingFlags = bindingFlags.data();
+
+        VkDescriptorSetLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+        layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+        layoutInfo.pBindings = bindings.data();
+        layoutInfo.pNext = &bindingFlagsInfo;
+
+        if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &m_descriptorSetLayout) != VK_SUCCESS)
+        {
+            throw std::runtime_error("[Bindless Descriptors] Failed to create descriptor set layout");
+        }
+
+        std::array<VkDescriptorPoolSize, 2> poolSizes{};
+        poolSizes[0].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        poolSizes[0].descriptorCount = maxTextures;
+        poolSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        poolSizes[1].descriptorCount = maxStorageBuffers;
+
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+        poolInfo.maxSets = 1;
+        poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+        poolInfo.pPoolSizes = poolSizes.data();
+
+        if (vkCreateDescriptorPool(device, &poolInfo, nullptr, &m_descriptorPool) != VK_SUCCESS)
+        {
+            throw std::runtime_error("[Bindless Descriptors] Failed to create descriptor pool");
+        }
+
+        VkDescriptorSetAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorPool = m_descriptorPool;
+        allocInfo.descriptorSetCount = 1;
+        allocInfo.pSetLayouts = &m_descriptorSetLayout;
+
+        if (vkAllocateDescriptorSets(device, &allocInfo, &m_descriptorSet) != VK_SUCCESS)
+        {
+            throw std::runtime_error("[Bindless Descriptors] Failed to allocate descriptor set");
+        }
+    }
+
+    bindless_index VulkanBindlessDescriptors::allocateSlot(SlotAllocator& allocator, const char* arrayName)
+    {
+        if (!allocator.freeSlots.empty())
+        {
+            bindless_index index = allocator.freeSlots.back();
+            allocator.freeSlots.pop_back();
+            return index;
+        }
+
+        if (allocator.nextUnusedSlot >= allocator.capacity)
+        {
+            throw std::runtime_error("[Bindless Descriptors] No slot left in the " + std::string(arrayName) + " array (" + std::to_string(allocator.capacity) + " slots)");
+        }
+
+        return allocator.nextUnusedSlot++;
+    }
+
+    void VulkanBindlessDescriptors::releaseSlotDeferred(SlotAllocator& allocator, bindless_index index)
+    {
+        // The deletion queue is flushed before this object is destroyed, the allocator outlives the deleter
+        m_device.deferDeletion([&allocator, index]() { allocator.freeSlots.push_back(index); });
+    }
+
+    bindless_index VulkanBindlessDescriptors::addTexture(VkImageView imageView, VkSampler sampler)
+    {
+        bindless_index index = allocateSlot(m_textureSlots, "texture");
+
+        VkDescriptorImageInfo imageInfo{};
+        imageInfo.sampler = sampler;
+        imageInfo.imageView = imageView;
+        imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+        VkWriteDescriptorSet write{};
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet = m_descriptorSet;
+        write.dstBinding = ms_TEXTURES_BINDING;
+        write.dstArrayElement = index;
+        write.descriptorCount = 1;
+        write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        write.pImageInfo = &imageInfo;
+
+        vkUpdateDescriptorSets(m_device.getVkDevice(), 1, &write, 0, nullptr);
+        return index;
+    }
+
+    void VulkanBindlessDescriptors::removeTexture(bindless_index index)
+    {
+        releaseSlotDeferred(m_textureSlots, index);
+    }
+
+    bindless_index VulkanBindlessDescriptors::addStorageBuffer(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range)
+    {
+        bindless_index index = allocateSlot(m_storageBufferSlots, "storage buffer");
+
+        VkDescriptorBufferInfo bufferInfo{};
+        bufferInfo.buffer = buffer;
+        bufferInfo.offset = offset;
+        bufferInfo.range = range;
+
+        VkWriteDescriptorSet write{};
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet = m_descriptorSet;
+        write.dstBinding = ms_STORAGE_BUFFERS_BINDING;
+        write.dstArrayElement = index;
+        write.descriptorCount = 1;
+        write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        write.pBufferInfo = &bufferInfo;
+
+        vkUpdateDescriptorSets(m_device.getVkDevice(), 1, &write, 0, nullptr);
+        return index;
+    }
+
+    void VulkanBindlessDescriptors::removeStorageBuffer(bindless_index index)
+    {
+        releaseSlotDeferred(m_storageBufferSlots, index);
+    }
+}
\ No newline at end of file
@@ -1,5 +1,12 @@
 #include <jate/rendering/vulkan/vulkan_buffers.h>
 
+#include <glm/gtc/packing.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+
 namespace jate::rendering::vulkan
 {
 	// --- AVulkanBuffer
@@ -11,14 +18,11 @@ namespace jate::rendering::vulkan
 
 	AVulkanBuffer::~AVulkanBuffer()
 	{
-		if (m_buffer != nullptr)
-			vkDestroyBuffer(m_device.getVkDevice(), m_buffer, nullptr);
-		
-		if (m_bufferMemory != nullptr)
-			vkFreeMemory(m_device.getVkDevice(), m_bufferMemory, nullptr);
+		// Frames still in flight may reference this buffer : let the device release it once they are done
+		m_device.destroyBufferDeferred(m_buffer, m_bufferMemory);
 	}
 
-	void AVulkanBuffer::createStagingBuffer(VkBuffer& outBuffer, VkDeviceMemory& outBufferMemory, const void* bufferData, VkDeviceSize bufferSize)
+	void AVulkanBuffer::createStagingBuffer(VkBuffer& outBuffer, VkDeviceMemory& outBufferMemory, VkDeviceSize bufferSize, const std::function<void (void* hostData)>& fillData)
 	{
 		// Create staging buffer, a temporary host-visible buffer
 		m_device.createBuffer(
@@ -32,45 +36,35 @@ namespace jate::rendering::vulkan
 		void* hostData;
 		vkMapMemory(m_device.getVkDevice(), outBufferMemory, m_bufferOffset, bufferSize, 0, &hostData);
 
-		// Copy data from the vertices vector to the host data, which is mapped to device memory.
+		// Write the data (copied from a vector or a memory mapped file, or converted on the way) to the host data, which is mapped to device memory.
 		// Thanks to the VK_MEMORY_PROPERTY_HOST_COHERENT_BIT flag, this will automatically be flushed to device memory
-		memcpy(hostData, bufferData, static_cast<size_t>(bufferSize));
+		fillData(hostData);
 
 		// Release mapping
 		vkUnmapMemory(m_device.getVkDevice(), outBufferMemory);
 	}
 
-	// --- VulkanVertexBuffer
-
-    VulkanVertexBuffer::VulkanVertexBuffer(VulkanDevice& device, const std::vector<VertexData>& vertices, VkDeviceSize bufferOffset)
-		: AVulkanBuffer(device, bufferOffset)
-	{
-		init_createVertexBuffer(vertices);
-	}
-
-	VulkanVertexBuffer::~VulkanVertexBuffer()
-	{
-		// buffer and memory deletion happens in parent class 
-	}
-
-	void VulkanVertexBuffer::init_createVertexBuffer(const std::vector<VertexData>& vertices)
+	void AVulkanBuffer::init_createDeviceLocalBuffer(VkDeviceSize bufferSize, VkBufferUsageFlags usage, VulkanBufferUpload* deferredUpload, const std::function<void (void* hostData)>& fillData)
 	{
-		m_vertexCount = static_cast<uint32_t>(vertices.size());
-		assert(m_vertexCount >= 3 && "VertexCount must be at least 3");
-		VkDeviceSize bufferSize = sizeof(VertexData) * m_vertexCount;
-
 		// Create staging buffer, a temporary host-visible buffer
 		VkBuffer stagingBuffer;
 		VkDeviceMemory stagingMemory;
-		createStagingBuffer(stagingBuffer, stagingMemory, vertices.data(), bufferSize);
+		createStagingBuffer(stagingBuffer, stagingMemory, bufferSize, fillData);
 
-		// Create vertex buffer and its local device memory (only visible by device), using transfer queue to get data from staging buffer
+		// Create the buffer and its local device memory (only visible by device), filled by a copy from the staging buffer
 		m_device.createBuffer(
 			bufferSize,
-			VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+			VK_BUFFER_USAGE_TRANSFER_DST_BIT | usage,
 			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
 			m_buffer, m_bufferMemory
 		);
+
+		if (deferredUpload != nullptr)
+		{
+			*deferredUpload = {stagingBuffer, stagingMemory, m_buffer, bufferSize};
+			return;
+		}
+
 		m_device.copyBuffer(stagingBuffer, m_buffer, bufferSize);
 
 		// Destroy staging buffer
@@ -78,40 +72,142 @@ namespace jate::rendering::vulkan
 		vkFreeMemory(m_device.getVkDevice(), stagingMemory, nullptr);
 	}
 
-	std::vector<VkVertexInputBindingDescription> VulkanVertexBuffer::getVertexBindingDescriptions()
+	// --- Vertex attribute formats
+
+	static VkFormat toVkFormat(VertexAttributeFormat format)
+	{
+		// Only formats every device supports for vertex buffers : 3 component 16 and 8 bit formats are optional, hence the padding
+		switch (format)
+		{
+		case VertexAttributeFormat::Float32x3: return VK_FORMAT_R32G32B32_SFLOAT;
+		case VertexAttributeFormat::Float16x4: return VK_FORMAT_R16G16B16A16_SFLOAT;
+		case VertexAttributeFormat::Unorm8x4: return VK_FORMAT_R8G8B8A8_UNORM;
+		case VertexAttributeFormat::Snorm8x4: return VK_FORMAT_R8G8B8A8_SNORM;
+		}
+		return VK_FORMAT_UNDEFINED;
+	}
+
+	static uint32_t getFormatSize(VertexAttributeFormat format)
+	{
+		switch (format)
+		{
+		case VertexAttributeFormat::Float32x3: return 3 * sizeof(float);
+		case VertexAttributeFormat::Float16x4: return 4 * sizeof(uint16_t);
+		case VertexAttributeFormat::Unorm8x4:
+		case VertexAttributeFormat::Snorm8x4: return 4 * sizeof(uint8_t);
+		}
+		return 0;
+	}
+
+	/// @brief Writes the value at dst in the given format
+	/// @return Right after the written value
+	static std::byte* packAttribute(const glm::vec3& value, VertexAttributeFormat format, std::byte* dst)
+	{
+		// glm packs the first component in the lowest bits : on little endian hosts, the bytes end up in the order of the Vulkan formats
+		switch (format)
+		{
+		case VertexAttributeFormat::Float32x3:
+			std::memcpy(dst, &value, sizeof(glm::vec3));
+			break;
+		case VertexAttributeFormat::Float16x4:
+		{
+			uint64_t packed = glm::packHalf4x16(glm::vec4(value, 1.f));
+			std::memcpy(dst, &packed, sizeof(packed));
+			break;
+		}
+		case VertexAttributeFormat::Unorm8x4:
+		{
+			uint32_t packed = glm::packUnorm4x8(glm::vec4(value, 1.f));
+			std::memcpy(dst, &packed, sizeof(packed));
+			break;
+		}
+		case VertexAttributeFormat::Snorm8x4:
+		{
+			uint32_t packed = glm::packSnorm4x8(glm::vec4(value, 0.f));
+			std::memcpy(dst, &packed, sizeof(packed));
+			break;
+		}
+		}
+		return dst + getFormatSize(format);
+	}
+
+	// --- VulkanVertexBuffer
+
+    VulkanVertexBuffer::VulkanVertexBuffer(VulkanDevice& device, std::span<const VertexData> vertices, const VertexLayout& layout, VkDeviceSize bufferOffset, VulkanBufferUpload* deferredUpload)
+		: AVulkanBuffer(device, bufferOffset)
+	{
+		init_createVertexBuffer(vertices, layout, deferredUpload);
+	}
+
+	VulkanVertexBuffer::~VulkanVertexBuffer()
+	{
+		// buffer and memory deletion happens in parent class 
+	}
+
+	void VulkanVertexBuffer::init_createVertexBuffer(std::span<const VertexData> vertices, const VertexLayout& layout, VulkanBufferUpload* deferredUpload)
+	{
+		m_vertexCount = static_cast<uint32_t>(vertices.size());
+		assert(m_vertexCount >= 3 && "VertexCount must be at least 3");
+		VkDeviceSize bufferSize = static_cast<VkDeviceSize>(getVertexStride(layout)) * m_vertexCount;
+
+		init_createDeviceLocalBuffer(bufferSize, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, deferredUpload, [&](void* hostData)
+		{
+			// The default layout is VertexData itself : copied as is
+			static_assert(offsetof(VertexData, color) == sizeof(glm::vec3) && sizeof(VertexData) == 2 * sizeof(glm::vec3));
+			if (layout == VertexLayout{})
+			{
+				std::memcpy(hostData, vertices.data(), static_cast<size_t>(bufferSize));
+				return;
+			}
+
+			std::byte* dst = static_cast<std::byte*>(hostData);
+			for (const VertexData& vertex : vertices)
+			{
+				dst = packAttribute(vertex.position, layout.position, dst);
+				dst = packAttribute(vertex.color, layout.color, dst);
+			}
+		});
+	}
+
+	uint32_t VulkanVertexBuffer::getVertexStride(const VertexLayout& layout)
+	{
+		return getFormatSize(layout.position) + getFormatSize(layout.color);
+	}
+
+	std::vector<VkVertexInputBindingDescription> VulkanVertexBuffer::getVertexBindingDescriptions(const VertexLayout& layout)
 	{
 		std::vector<VkVertexInputBindingDescription> bindingDescriptions(1);
 		bindingDescriptions[0].binding = 0;
 		bindingDescriptions[0].inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
-		bindingDescriptions[0].stride = sizeof(VertexData);
+		bindingDescriptions[0].stride = getVertexStride(layout);
 		return bindingDescriptions;
 	}
 
-	std::vector<VkVertexInputAttributeDescription> VulkanVertexBuffer::getVertexAttributeDescriptions()
+	std::vector<VkVertexInputAttributeDescription> VulkanVertexBuffer::getVertexAttributeDescriptions(const VertexLayout& layout)
 	{
 		std::vector<VkVertexInputAttributeDescription> attributeDescriptions(2);
 
 		// Position
 		attributeDescriptions[0].binding = 0;
 		attributeDescriptions[0].location = 0;
-		attributeDescriptions[0].offset = offsetof(VertexData, position);
-		attributeDescriptions[0].format = VK_FORMAT_R32G32_SFLOAT;
+		attributeDescriptions[0].offset = 0;
+		attributeDescriptions[0].format = toVkFormat(layout.position);
 
 		// Color
 		attributeDescriptions[1].binding = 0;
 		attributeDescriptions[1].location = 1;
-		attributeDescriptions[1].offset = offsetof(VertexData, color);
-		attributeDescriptions[1].format = VK_FORMAT_R32G32B32_SFLOAT;
+		attributeDescriptions[1].offset = getFormatSize(layout.position);
+		attributeDescriptions[1].format = toVkFormat(layout.color);
 
 		return attributeDescriptions;
 	}
 
 	// --- VulkanIndexBuffer
 
-    VulkanIndexBuffer::VulkanIndexBuffer(VulkanDevice &device, const std::vector<uint32_t> &indices, VkDeviceSize bufferOffset)
+    VulkanIndexBuffer::VulkanIndexBuffer(VulkanDevice &device, std::span<const uint32_t> indices, VkDeviceSize bufferOffset, VulkanBufferUpload* deferredUpload)
 		: AVulkanBuffer(device, bufferOffset)
     {
-		init_createIndexBuffer(indices);
+		init_createIndexBuffer(indices, deferredUpload);
     }
 
     VulkanIndexBuffer::~VulkanIndexBuffer()
@@ -119,28 +215,29 @@ namespace jate::rendering::vulkan
 		// buffer and memory deletion happens in parent class 
     }
 
-    void VulkanIndexBuffer::init_createIndexBuffer(const std::vector<uint32_t> &indices)
+    void VulkanIndexBuffer::init_createIndexBuffer(std::span<const uint32_t> indices, VulkanBufferUpload* deferredUpload)
     {
 		m_indexCount = static_cast<uint32_t>(indices.size());
 		assert(m_indexCount >= 3 && "IndexCount must be at least 3");
-		VkDeviceSize bufferSize = sizeof(uint32_t) * m_indexCount;
-
-		// Create staging buffer, a temporary host-visible buffer
-		VkBuffer stagingBuffer;
-		VkDeviceMemory stagingMemory;
-		createStagingBuffer(stagingBuffer, stagingMemory, indices.data(), bufferSize);
 
-		// Create vertex buffer and its local device memory (only visible by device), using transfer queue to get data from staging buffer
-		m_device.createBuffer(
-			bufferSize,
-			VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
-			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-			m_buffer, m_bufferMemory
-		);
-		m_device.copyBuffer(stagingBuffer, m_buffer, bufferSize);
-
-		// Destroy staging buffer
-		vkDestroyBuffer(m_device.getVkDevice(), stagingBuffer, nullptr);
-		vkFreeMemory(m_device.getVkDevice(), stagingMemory, nullptr);
+		// Primitive restart is disabled : 0xFFFF is a regular index
+		bool fitsIn16Bits = std::all_of(indices.begin(), indices.end(), [](uint32_t index) { return index <= std::numeric_limits<uint16_t>::max(); });
+		m_indexType = fitsIn16Bits ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32;
+		VkDeviceSize bufferSize = (fitsIn16Bits ? sizeof(uint16_t) : sizeof(uint32_t)) * m_indexCount;
+
+		init_createDeviceLocalBuffer(bufferSize, VK_BUFFER_USAGE_INDEX_BUFFER_BIT, deferredUpload, [&](void* hostData)
+		{
+			if (!fitsIn16Bits)
+			{
+				std::memcpy(hostData, indices.data(), static_cast<size_t>(bufferSize));
+				return;
+			}
+
+			uint16_t* dst = static_cast<uint16_t*>(hostData);
+			for (uint32_t index : indices)
+			{
+				*dst++ = static_cast<uint16_t>(index);
+			}
+		});
     }
 }
\ No newline at end of file
@@ -1,12 +1,14 @@
 #include <jate/rendering/vulkan/vulkan_command_manager.h>
+#include <jate/rendering/vulkan/exceptions.h>
+#include <jate/profiling/cpu_profiler.h>
 
 #include <spdlog/spdlog.h>
+#include <array>
 
 namespace jate::rendering::vulkan
 {
-    VulkanCommandManager::VulkanCommandManager(VulkanDevice& device, VulkanSwapChain& swapChain, uint8_t commandBuffersCount) :
-        m_device(device),
-        m_swapChain(swapChain)
+    VulkanCommandManager::VulkanCommandManager(VulkanDevice& device, uint8_t commandBuffersCount) :
+        m_device(device)
     {
         init_createCommandPools();
         init_createCommandBuffers(commandBuffersCount);
@@ -133,22 +135,17 @@ namespace jate::rendering::vulkan
         }
     }
 
-    void VulkanCommandBuffer::cmdStartRenderPass(const VulkanSwapChain& swapChain, uint32_t frameBufferIndex)
+    void VulkanCommandBuffer::cmdStartRenderPass(VkRenderPass renderPass, VkFramebuffer frameBuffer, VkExtent2D extent, const std::vector<VkClearValue>& clearValues)
     {
         VkRenderPassBeginInfo renderPassInfo{};
         renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-        renderPassInfo.renderPass = swapChain.getRenderPass();
-        renderPassInfo.framebuffer = swapChain.getFrameBuffer(frameBufferIndex);
+        renderPassInfo.renderPass = renderPass;
+        renderPassInfo.framebuffer = frameBuffer;
 
         renderPassInfo.renderArea.offset = {0, 0};
-        renderPassInfo.renderArea.extent = swapChain.getExtent();
+        renderPassInfo.renderArea.extent = extent;
 
-        // TODO this should be a parameter or smth
-        std::array<VkClearValue, 2> clearValues;
-		clearValues[0].color = { 0.01f, 0.01f, 0.01f, 1.0f };
-		clearValues[1].depthStencil = { 1.0f, 0 };
-
-        renderPassInfo.clearValueCount = clearValues.size();
+        renderPassInfo.clearValueCount = static_cast<uint32_t>(clearValues.size());
         renderPassInfo.pClearValues = clearValues.data();
 
         vkCmdBeginRenderPass(m_commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
@@ -159,11 +156,45 @@ namespace jate::rendering::vulkan
         vkCmdEndRenderPass(m_commandBuffer);
     }
 
+    void VulkanCommandBuffer::cmdBeginRendering(const VkRenderingInfo& renderingInfo)
+    {
+        m_device.getVkCmdBeginRendering()(m_commandBuffer, &renderingInfo);
+    }
+
+    void VulkanCommandBuffer::cmdEndRendering()
+    {
+        m_device.getVkCmdEndRendering()(m_commandBuffer);
+    }
+
+    void VulkanCommandBuffer::cmdPipelineBarrier(VkPipelineStageFlags srcStages, VkPipelineStageFlags dstStages,
+        const std::vector<VkImageMemoryBarrier>& imageBarriers, const std::vector<VkBufferMemoryBarrier>& bufferBarriers)
+    {
+        vkCmdPipelineBarrier(m_commandBuffer, srcStages, dstStages, 0,
+            0, nullptr,
+            static_cast<uint32_t>(bufferBarriers.size()), bufferBarriers.data(),
+            static_cast<uint32_t>(imageBarriers.size()), imageBarriers.data());
+    }
+
+    void VulkanCommandBuffer::cmdMemoryBarrier(VkPipelineStageFlags srcStages, VkPipelineStageFlags dstStages, VkAccessFlags srcAccess, VkAccessFlags dstAccess)
+    {
+        VkMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = srcAccess;
+        barrier.dstAccessMask = dstAccess;
+
+        vkCmdPipelineBarrier(m_commandBuffer, srcStages, dstStages, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+    }
+
     void VulkanCommandBuffer::cmdBindPipeline(const VulkanPipeline& pipeline)
     {
         vkCmdBindPipeline(m_commandBuffer, VkPipelineBindPoint::VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline.getVkPipeline());
     }
 
+    void VulkanCommandBuffer::cmdBindPipeline(const VulkanComputePipeline& pipeline)
+    {
+        vkCmdBindPipeline(m_commandBuffer, VkPipelineBindPoint::VK_PIPELINE_BIND_POINT_COMPUTE, pipeline.getVkPipeline());
+    }
+
     void VulkanCommandBuffer::cmdSetViewport(float x, float y, float width, float height, float minDepth, float maxDepth)
     {
         VkViewport viewport {};
@@ -183,9 +214,24 @@ namespace jate::rendering::vulkan
         vkCmdSetScissor(m_commandBuffer, 0, 1, &scissor);
     }
 
-    void VulkanCommandBuffer::cmdPushConstants(const PushConstantData &data, VkPipelineLayout pipelineLayout)
+    void VulkanCommandBuffer::cmdPushConstants(VkPipelineLayout pipelineLayout, VkShaderStageFlags stageFlags, uint32_t size, const void* data)
+    {
+        vkCmdPushConstants(m_commandBuffer, pipelineLayout, stageFlags, 0, size, data);
+    }
+
+    void VulkanCommandBuffer::cmdBindDescriptorSet(VkPipelineLayout pipelineLayout, VkDescriptorSet descriptorSet, uint32_t setIndex, VkPipelineBindPoint bindPoint)
+    {
+        vkCmdBindDescriptorSets(m_commandBuffer, bindPoint, pipelineLayout, setIndex, 1, &descriptorSet, 0, nullptr);
+    }
+
+    void VulkanCommandBuffer::cmdBindVertexBuffer(VkBuffer buffer, uint32_t binding, VkDeviceSize offset)
     {
-        vkCmdPushConstants(m_commandBuffer, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(data), &data);
+        vkCmdBindVertexBuffers(m_commandBuffer, binding, 1, &buffer, &offset);
+    }
+
+    void VulkanCommandBuffer::cmdDraw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance)
+    {
+        vkCmdDraw(m_commandBuffer, vertexCount, instanceCount, firstVertex, firstInstance);
     }
 
     void VulkanCommandBuffer::cmdDrawVertexBuffer(const VulkanVertexBuffer &vertexBuffer)
@@ -197,15 +243,30 @@ namespace jate::rendering::vulkan
         vkCmdDraw(m_commandBuffer, vertexBuffer.getVertexCount(), 1, 0, 0);
     }
 
-    void VulkanCommandBuffer::cmdDrawIndexedVertexBuffer(const VulkanVertexBuffer &vertexBuffer, const VulkanIndexBuffer &indexBuffer)
+    void VulkanCommandBuffer::cmdDrawIndexedVertexBuffer(const VulkanVertexBuffer &vertexBuffer, const VulkanIndexBuffer &indexBuffer, uint32_t firstInstance)
     {
         VkBuffer buffers[] = { vertexBuffer.getVkBuffer() };
 		VkDeviceSize bufferOffsets[] = { vertexBuffer.getBufferOffset() };
 		vkCmdBindVertexBuffers(m_commandBuffer, 0, 1, buffers, bufferOffsets);
 
-        vkCmdBindIndexBuffer(m_commandBuffer, indexBuffer.getVkBuffer(), indexBuffer.getBufferOffset(), VkIndexType::VK_INDEX_TYPE_UINT32);
+        vkCmdBindIndexBuffer(m_commandBuffer, indexBuffer.getVkBuffer(), indexBuffer.getBufferOffset(), indexBuffer.getIndexType());
+
+        vkCmdDrawIndexed(m_commandBuffer, indexBuffer.getIndexCount(), 1, 0, vertexBuffer.getBufferOffset(), firstInstance);
+    }
 
-        vkCmdDrawIndexed(m_commandBuffer, indexBuffer.getIndexCount(), 1, 0, vertexBuffer.getBufferOffset(), 0);
+    void VulkanCommandBuffer::cmdDrawIndirect(VkBuffer buffer, VkDeviceSize offset)
+    {
+        vkCmdDrawIndirect(m_commandBuffer, buffer, offset, 1, sizeof(VkDrawIndirectCommand));
+    }
+
+    void VulkanCommandBuffer::cmdDispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ)
+    {
+        vkCmdDispatch(m_commandBuffer, groupCountX, groupCountY, groupCountZ);
+    }
+
+    void VulkanCommandBuffer::cmdDispatchIndirect(VkBuffer buffer, VkDeviceSize offset)
+    {
+        vkCmdDispatchIndirect(m_commandBuffer, buffer, offset);
     }
 
     void VulkanCommandBuffer::cmdCopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size)
@@ -218,8 +279,73 @@ namespace jate::rendering::vulkan
         vkCmdCopyBuffer(m_commandBuffer, srcBuffer, dstBuffer, 1, &copyRegion);
     }
 
-    void VulkanCommandBuffer::submit(VkSemaphore waitSemaphore, VkSemaphore signalSemaphore, VkFence fence)
+    void VulkanCommandBuffer::cmdCopyImageToBuffer(VkImage srcImage, VkExtent2D extent, VkBuffer dstBuffer)
     {
+        VkBufferImageCopy copyRegion {};
+        copyRegion.bufferOffset = 0;
+        copyRegion.bufferRowLength = 0;     // Tightly packed
+        copyRegion.bufferImageHeight = 0;
+        copyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        copyRegion.imageSubresource.mipLevel = 0;
+        copyRegion.imageSubresource.baseArrayLayer = 0;
+        copyRegion.imageSubresource.layerCount = 1;
+        copyRegion.imageOffset = {0, 0, 0};
+        copyRegion.imageExtent = {extent.width, extent.height, 1};
+
+        vkCmdCopyImageToBuffer(m_commandBuffer, srcImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, dstBuffer, 1, &copyRegion);
+
+        // Make the copied data visible to the host once the command buffer has completed
+        VkBufferMemoryBarrier barrier {};
+        barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.buffer = dstBuffer;
+        barrier.offset = 0;
+        barrier.size = VK_WHOLE_SIZE;
+
+        vkCmdPipelineBarrier(m_commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+    }
+
+    void VulkanCommandBuffer::cmdCopyBufferToImage(VkBuffer srcBuffer, VkImage dstImage, const std::vector<VkBufferImageCopy>& regions)
+    {
+        vkCmdCopyBufferToImage(m_commandBuffer, srcBuffer, dstImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, static_cast<uint32_t>(regions.size()), regions.data());
+    }
+
+    void VulkanCommandBuffer::cmdBlitImage(VkImage srcImage, VkImage dstImage, const std::vector<VkImageBlit>& regions, VkFilter filter)
+    {
+        vkCmdBlitImage(m_commandBuffer, srcImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, dstImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            static_cast<uint32_t>(regions.size()), regions.data(), filter);
+    }
+
+    void VulkanCommandBuffer::cmdResetProfileQueries(VulkanGpuProfiler& profiler)
+    {
+        m_openProfileScopes.clear();
+        profiler.cmdResetQueries(m_commandBuffer);
+    }
+
+    void VulkanCommandBuffer::cmdBeginProfileScope(VulkanGpuProfiler& profiler, const std::string& name)
+    {
+        m_openProfileScopes.push_back(profiler.cmdBeginScope(m_commandBuffer, name));
+    }
+
+    void VulkanCommandBuffer::cmdEndProfileScope(VulkanGpuProfiler& profiler)
+    {
+        if (m_openProfileScopes.empty())
+        {
+            spdlog::error("cmdEndProfileScope called without any open profile scope");
+            return;
+        }
+
+        profiler.cmdEndScope(m_commandBuffer, m_openProfileScopes.back());
+        m_openProfileScopes.pop_back();
+    }
+
+    uint64_t VulkanCommandBuffer::submit(VkSemaphore waitSemaphore, VkSemaphore signalSemaphore, VulkanTimelineSemaphore* timeline)
+    {
+        JATE_PROFILE_SCOPE("QueueSubmit");
+
         VkSubmitInfo submitInfo{};
         submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
 
@@ -232,18 +358,54 @@ namespace jate::rendering::vulkan
         submitInfo.commandBufferCount = 1;
         submitInfo.pCommandBuffers = &m_commandBuffer;
 
-        VkSemaphore signalSemaphores[] = {signalSemaphore};
-        submitInfo.signalSemaphoreCount = signalSemaphore != nullptr ? 1 : 0;
-        submitInfo.pSignalSemaphores = signalSemaphores;
+        // Binary semaphores ignore their signal value, the timeline one is always last
+        std::array<VkSemaphore, 2> signalSemaphores;
+        std::array<uint64_t, 2> signalValues = {0, 0};
+        uint32_t signalSemaphoreCount = 0;
+        if (signalSemaphore != nullptr)
+        {
+            signalSemaphores[signalSemaphoreCount++] = signalSemaphore;
+        }
 
-        if (vkQueueSubmit(m_device.getGraphicsQueue(), 1, &submitInfo, fence) != VK_SUCCESS) {
-            spdlog::error("failed to submit draw command buffer!");
-            return;
+        uint64_t timelineValue = 0;
+        if (timeline != nullptr)
+        {
+            timelineValue = timeline->getNextSignalValue();
+            signalValues[signalSemaphoreCount] = timelineValue;
+            signalSemaphores[signalSemaphoreCount++] = timeline->getVkSemaphore();
         }
+
+        submitInfo.signalSemaphoreCount = signalSemaphoreCount;
+        submitInfo.pSignalSemaphores = signalSemaphores.data();
+
+        uint64_t waitValue = 0;
+        VkTimelineSemaphoreSubmitInfo timelineInfo{};
+        timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+        timelineInfo.waitSemaphoreValueCount = submitInfo.waitSemaphoreCount;
+        timelineInfo.pWaitSemaphoreValues = &waitValue;
+        timelineInfo.signalSemaphoreValueCount = signalSemaphoreCount;
+        timelineInfo.pSignalSemaphoreValues = signalValues.data();
+        if (timeline != nullptr)
+        {
+            submitInfo.pNext = &timelineInfo;
+        }
+
+        // The value is only reserved once submitted : waits and deletions tagged with it must be reached
+        if (vkQueueSubmit(m_device.getGraphicsQueue(), 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS) {
+            throw std::runtime_error("failed to submit draw command buffer!");
+        }
+
+        if (timeline != nullptr)
+        {
+            timeline->advanceSignalValue();
+        }
+        return timelineValue;
     }
 
     void VulkanCommandBuffer::present(const VulkanSwapChain& swapChain, uint32_t* frameBufferIndex, VkSemaphore waitSemaphore)
     {
+        JATE_PROFILE_SCOPE("QueuePresent");
+
         VkSemaphore waitSemaphores[] = {waitSemaphore};
 
         VkPresentInfoKHR presentInfo{};
@@ -259,6 +421,10 @@ namespace jate::rendering::vulkan
 
         presentInfo.pResults = nullptr; // Optional
 
-        vkQueuePresentKHR(m_device.getPresentQueue(), &presentInfo);
+        VkResult result = vkQueuePresentKHR(m_device.getPresentQueue(), &presentInfo);
+        if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR)
+            throw SwapChainOutOfDateException("Swap chain out of date");
+        else if (result != VK_SUCCESS)
+            throw std::runtime_error("Could not present swap chain image.");
     }
 }
\ No newline at end of file
@@ -0,0 +1,30 @@
+#include <jate/rendering/vulkan/vulkan_compute_pipeline.h>
+
+#include <stdexcept>
+
+namespace jate::rendering::vulkan
+{
+    VulkanComputePipeline::VulkanComputePipeline(VulkanDevice& device, VkShaderModule compShaderModule, VkPipelineLayout pipelineLayout, VkPipelineCache pipelineCache)
+        : m_device(device)
+    {
+        VkComputePipelineCreateInfo pipelineInfo{};
+        pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+        pipelineInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        pipelineInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+        pipelineInfo.stage.module = compShaderModule;
+        pipelineInfo.stage.pName = "main";
+        pipelineInfo.layout = pipelineLayout;
+        pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
+        pipelineInfo.basePipelineIndex = -1;
+
+        if (vkCreateComputePipelines(m_device.getVkDevice(), pipelineCache, 1, &pipelineInfo, nullptr, &m_computePipeline) != VK_SUCCESS)
+        {
+            throw std::runtime_error("failed to create compute pipeline");
+        }
+    }
+
+    VulkanComputePipeline::~VulkanComputePipeline()
+    {
+        vkDestroyPipeline(m_device.getVkDevice(), m_computePipeline, nullptr);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,47 @@
+#include <jate/rendering/vulkan/vulkan_deletion_queue.h>
+
+namespace jate::rendering::vulkan
+{
+    VulkanDeletionQueue::VulkanDeletionQueue(const VulkanTimelineSemaphore& timeline)
+        : m_timeline(timeline)
+    {
+    }
+
+    VulkanDeletionQueue::~VulkanDeletionQueue()
+    {
+        flushAll();
+    }
+
+    void VulkanDeletionQueue::push(std::function<void ()> deleter)
+    {
+        // Any submission up to the next one may still reference the resource
+        m_pendingDeletions.push_back({m_timeline.getLastAllocatedValue() + 1, std::move(deleter)});
+    }
+
+    void VulkanDeletionQueue::collect()
+    {
+        if (m_pendingDeletions.empty())
+            return;
+
+        uint64_t completedValue = m_timeline.getCompletedValue();
+        flushWhile([completedValue](const PendingDeletion& deletion) { return deletion.timelineValue <= completedValue; });
+    }
+
+    void VulkanDeletionQueue::flushAll()
+    {
+        flushWhile([](const PendingDeletion&) { return true; });
+    }
+
+    template <typename Predicate>
+    void VulkanDeletionQueue::flushWhile(Predicate predicate)
+    {
+        // Deleters may push new deletions (e.g. a swap chain owning buffers) : they go to the back,
+        // so the deletion is taken out of the queue before it runs
+        while (!m_pendingDeletions.empty() && predicate(m_pendingDeletions.front()))
+        {
+            std::function<void ()> deleter = std::move(m_pendingDeletions.front().deleter);
+            m_pendingDeletions.pop_front();
+            deleter();
+        }
+    }
+}
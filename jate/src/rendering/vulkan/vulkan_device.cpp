@@ -2,32 +2,47 @@
 
 #include <jate/rendering/vulkan/vulkan_swapchain.h>
 #include <jate/rendering/vulkan/vulkan_command_manager.h>
+#include <jate/rendering/vulkan/vulkan_deletion_queue.h>
+
+#include <jate/profiling/cpu_profiler.h>
 
 #include <spdlog/spdlog.h>
 #include <algorithm>
 #include <set>
+#include <cstring>
 
 #include <cassert>
 
 namespace jate::rendering::vulkan
 {
-    VulkanDevice::VulkanDevice(const VulkanInstance& instance, Window& window) : m_instance(instance), m_window(window)
+    VulkanDevice::VulkanDevice(const VulkanInstance& instance, Window* window, bool preferDynamicRendering)
+        : m_instance(instance), m_window(window), m_preferDynamicRendering(preferDynamicRendering)
     {
-        m_window.attachVulkanInstance(instance);
-        m_window.createWindowSurface();
+        // Headless devices render offscreen, so they need neither a surface nor the swap chain extension
+        if (m_window != nullptr)
+        {
+            m_window->attachVulkanInstance(instance);
+            m_window->createWindowSurface();
+            m_deviceExtensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+        }
 
         init_pickPhysicalDevice();
         if (m_physicalDevice != nullptr)
         {
+            init_checkDynamicRenderingSupport();
             init_createLogicalDevice();
+            init_loadDynamicRenderingFunctions();
         }
     }
 
     VulkanDevice::~VulkanDevice()
     {
+        m_graphicsTimeline = nullptr;
+        m_transferTimeline = nullptr;
         vkDestroyDevice(m_device, nullptr);
 
-        m_window.freeWindowSurface();
+        if (m_window != nullptr)
+            m_window->freeWindowSurface();
     }
 
     // Init functions
@@ -65,6 +80,42 @@ namespace jate::rendering::vulkan
         m_physicalDevice = pickedDevice.first;
     }
 
+    void VulkanDevice::init_checkDynamicRenderingSupport()
+    {
+        m_dynamicRenderingSupport = DynamicRenderingSupport::None;
+        if (!m_preferDynamicRendering)
+            return;
+
+        VkPhysicalDeviceProperties deviceProperties;
+        vkGetPhysicalDeviceProperties(m_physicalDevice, &deviceProperties);
+        uint32_t apiVersion = std::min(deviceProperties.apiVersion, m_instance.getApiVersion());
+
+        // The extension depends on Vulkan 1.2 features (render pass 2, depth stencil resolve)
+        if (apiVersion < VK_API_VERSION_1_2)
+            return;
+
+        bool isCore = apiVersion >= VK_API_VERSION_1_3;
+        if (!isCore && !isDeviceExtensionSupported(m_physicalDevice, VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME))
+            return;
+
+        VkPhysicalDeviceDynamicRenderingFeatures dynamicRenderingFeatures{};
+        dynamicRenderingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES;
+
+        VkPhysicalDeviceFeatures2 deviceFeatures{};
+        deviceFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        deviceFeatures.pNext = &dynamicRenderingFeatures;
+        vkGetPhysicalDeviceFeatures2(m_physicalDevice, &deviceFeatures);
+
+        if (!dynamicRenderingFeatures.dynamicRendering)
+            return;
+
+        m_dynamicRenderingSupport = isCore ? DynamicRenderingSupport::Core : DynamicRenderingSupport::Extension;
+        if (m_dynamicRenderingSupport == DynamicRenderingSupport::Extension)
+        {
+            m_deviceExtensions.push_back(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME);
+        }
+    }
+
     void VulkanDevice::init_createLogicalDevice()
     {
         m_queueFamilyIndices = findQueueFamilies(m_physicalDevice);
@@ -86,6 +137,25 @@ namespace jate::rendering::vulkan
         // Device features
         VkPhysicalDeviceFeatures deviceFeatures{};
 
+        VkPhysicalDeviceDynamicRenderingFeatures dynamicRenderingFeatures{};
+        dynamicRenderingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES;
+        dynamicRenderingFeatures.dynamicRendering = VK_TRUE;
+
+        VkPhysicalDeviceTimelineSemaphoreFeatures timelineSemaphoreFeatures{};
+        timelineSemaphoreFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES;
+        timelineSemaphoreFeatures.timelineSemaphore = VK_TRUE;
+        timelineSemaphoreFeatures.pNext = m_dynamicRenderingSupport != DynamicRenderingSupport::None ? &dynamicRenderingFeatures : nullptr;
+
+        VkPhysicalDeviceDescriptorIndexingFeatures descriptorIndexingFeatures{};
+        descriptorIndexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES;
+        descriptorIndexingFeatures.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+        descriptorIndexingFeatures.runtimeDescriptorArray = VK_TRUE;
+        descriptorIndexingFeatures.descriptorBindingPartiallyBound = VK_TRUE;
+        descriptorIndexingFeatures.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+        descriptorIndexingFeatures.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
+        descriptorIndexingFeatures.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+        descriptorIndexingFeatures.pNext = &timelineSemaphoreFeatures;
+
         // Creating the logical device itself
         VkDeviceCreateInfo createInfo{};
         createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
@@ -94,6 +164,7 @@ namespace jate::rendering::vulkan
         createInfo.pEnabledFeatures = &deviceFeatures;
         createInfo.enabledExtensionCount = static_cast<uint32_t>(m_deviceExtensions.size());
         createInfo.ppEnabledExtensionNames = m_deviceExtensions.data();
+        createInfo.pNext = &descriptorIndexingFeatures;
 
         // Device validation layers are not relevant for modern Vulkan implementations
 
@@ -105,6 +176,33 @@ namespace jate::rendering::vulkan
         // Retrieve queues
         vkGetDeviceQueue(m_device, m_queueFamilyIndices.graphicsQueueFamily.value(), 0, &m_graphicsQueue);
         vkGetDeviceQueue(m_device, m_queueFamilyIndices.presentQueueFamily.value(), 0, &m_presentQueue);
+
+        m_graphicsTimeline = std::make_unique<VulkanTimelineSemaphore>(m_device);
+        m_transferTimeline = std::make_unique<VulkanTimelineSemaphore>(m_device);
+    }
+
+    void VulkanDevice::init_loadDynamicRenderingFunctions()
+    {
+        if (m_dynamicRenderingSupport == DynamicRenderingSupport::None)
+        {
+            spdlog::info("Dynamic rendering disabled : using render passes");
+            return;
+        }
+
+        // Loaded from the device, so that it works with loaders older than the driver
+        bool isCore = m_dynamicRenderingSupport == DynamicRenderingSupport::Core;
+        auto beginRendering = (PFN_vkCmdBeginRendering) vkGetDeviceProcAddr(m_device, isCore ? "vkCmdBeginRendering" : "vkCmdBeginRenderingKHR");
+        auto endRendering = (PFN_vkCmdEndRendering) vkGetDeviceProcAddr(m_device, isCore ? "vkCmdEndRendering" : "vkCmdEndRenderingKHR");
+
+        if (beginRendering == nullptr || endRendering == nullptr)
+        {
+            spdlog::warn("Dynamic rendering is supported, but its functions could not be loaded : using render passes");
+            return;
+        }
+
+        m_vkCmdBeginRendering = beginRendering;
+        m_vkCmdEndRendering = endRendering;
+        spdlog::info("Dynamic rendering enabled ({})", isCore ? "Vulkan 1.3" : VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME);
     }
 
     void VulkanDevice::attachCommandManager(VulkanCommandManager* commandManager)
@@ -112,6 +210,36 @@ namespace jate::rendering::vulkan
         m_commandManager = commandManager;
     }
 
+    void VulkanDevice::attachDeletionQueue(VulkanDeletionQueue* deletionQueue)
+    {
+        m_deletionQueue = deletionQueue;
+    }
+
+    void VulkanDevice::destroyBufferDeferred(VkBuffer buffer, VkDeviceMemory bufferMemory)
+    {
+        auto deleter = [device = m_device, buffer, bufferMemory]()
+        {
+            if (buffer != VK_NULL_HANDLE)
+                vkDestroyBuffer(device, buffer, nullptr);
+
+            if (bufferMemory != VK_NULL_HANDLE)
+                vkFreeMemory(device, bufferMemory, nullptr);
+        };
+
+        deferDeletion(deleter);
+    }
+
+    void VulkanDevice::deferDeletion(std::function<void ()> deleter)
+    {
+        if (m_deletionQueue == nullptr)
+        {
+            deleter();
+            return;
+        }
+
+        m_deletionQueue->push(std::move(deleter));
+    }
+
     int32_t VulkanDevice::ratePhysicalDevice(VkPhysicalDevice device) const
     {
         if (device == nullptr) return -1;   // Just for safety
@@ -133,11 +261,22 @@ namespace jate::rendering::vulkan
         if (!queueFamilies.isComplete())
             return -1;
 
-        // Check swap chain support
-        VulkanSwapChain::SwapChainSupportDetails swapChainSupportDetails = VulkanSwapChain::getPhysicalDeviceSwapChainSupport(device, m_window.getVulkanSurface());
-        if (swapChainSupportDetails.formats.empty() || swapChainSupportDetails.presentModes.empty())
+        // Every submission is tracked with timeline semaphores
+        if (!checkTimelineSemaphoreSupport(device))
+            return -1;
+
+        // Textures and per-object data are accessed through bindless descriptor arrays
+        if (!checkDescriptorIndexingSupport(device))
             return -1;
 
+        // Check swap chain support
+        if (m_window != nullptr)
+        {
+            VulkanSwapChain::SwapChainSupportDetails swapChainSupportDetails = VulkanSwapChain::getPhysicalDeviceSwapChainSupport(device, m_window->getVulkanSurface());
+            if (swapChainSupportDetails.formats.empty() || swapChainSupportDetails.presentModes.empty())
+                return -1;
+        }
+
         // Favour dedicated graphics cards
         if (deviceProperties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU)
             score += 100000;
@@ -166,12 +305,19 @@ namespace jate::rendering::vulkan
             if (queueFamilies[i].queueFlags & VK_QUEUE_GRAPHICS_BIT)
                 indices.graphicsQueueFamily = i;
 
+            if (m_window == nullptr)
+                continue;
+
             VkBool32 presentSupport = false;
-            vkGetPhysicalDeviceSurfaceSupportKHR(device, i, m_window.getVulkanSurface(), &presentSupport);
+            vkGetPhysicalDeviceSurfaceSupportKHR(device, i, m_window->getVulkanSurface(), &presentSupport);
             if (presentSupport)
                 indices.presentQueueFamily = i;
         }
 
+        // Nothing is presented in headless mode : the present queue is simply the graphics queue
+        if (m_window == nullptr)
+            indices.presentQueueFamily = indices.graphicsQueueFamily;
+
         return indices;
     }
 
@@ -192,6 +338,60 @@ namespace jate::rendering::vulkan
         return requiredExtensions.empty();
     }
 
+    bool VulkanDevice::checkTimelineSemaphoreSupport(VkPhysicalDevice device) const
+    {
+        VkPhysicalDeviceProperties deviceProperties;
+        vkGetPhysicalDeviceProperties(device, &deviceProperties);
+        if (std::min(deviceProperties.apiVersion, m_instance.getApiVersion()) < VK_API_VERSION_1_2)
+            return false;
+
+        VkPhysicalDeviceTimelineSemaphoreFeatures timelineSemaphoreFeatures{};
+        timelineSemaphoreFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES;
+
+        VkPhysicalDeviceFeatures2 deviceFeatures{};
+        deviceFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        deviceFeatures.pNext = &timelineSemaphoreFeatures;
+        vkGetPhysicalDeviceFeatures2(device, &deviceFeatures);
+
+        return timelineSemaphoreFeatures.timelineSemaphore == VK_TRUE;
+    }
+
+    bool VulkanDevice::checkDescriptorIndexingSupport(VkPhysicalDevice device) const
+    {
+        VkPhysicalDeviceProperties deviceProperties;
+        vkGetPhysicalDeviceProperties(device, &deviceProperties);
+        if (std::min(deviceProperties.apiVersion, m_instance.getApiVersion()) < VK_API_VERSION_1_2)
+            return false;
+
+        VkPhysicalDeviceDescriptorIndexingFeatures descriptorIndexingFeatures{};
+        descriptorIndexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES;
+
+        VkPhysicalDeviceFeatures2 deviceFeatures{};
+        deviceFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        deviceFeatures.pNext = &descriptorIndexingFeatures;
+        vkGetPhysicalDeviceFeatures2(device, &deviceFeatures);
+
+        return descriptorIndexingFeatures.shaderSampledImageArrayNonUniformIndexing == VK_TRUE
+            && descriptorIndexingFeatures.runtimeDescriptorArray == VK_TRUE
+            && descriptorIndexingFeatures.descriptorBindingPartiallyBound == VK_TRUE
+            && descriptorIndexingFeatures.descriptorBindingSampledImageUpdateAfterBind == VK_TRUE
+            && descriptorIndexingFeatures.descriptorBindingStorageBufferUpdateAfterBind == VK_TRUE
+            && descriptorIndexingFeatures.descriptorBindingUpdateUnusedWhilePending == VK_TRUE;
+    }
+
+    bool VulkanDevice::isDeviceExtensionSupported(VkPhysicalDevice device, const char* extensionName)
+    {
+        uint32_t extensionCount;
+        vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, nullptr);
+
+        std::vector<VkExtensionProperties> availableExtensions(extensionCount);
+        vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, availableExtensions.data());
+
+        return std::any_of(availableExtensions.begin(), availableExtensions.end(), [extensionName](const VkExtensionProperties& extension) {
+            return strcmp(extension.extensionName, extensionName) == 0;
+        });
+    }
+
     void VulkanDevice::createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer &buffer, VkDeviceMemory &bufferMemory)
     {
         VkBufferCreateInfo bufferInfo{};
@@ -223,6 +423,8 @@ namespace jate::rendering::vulkan
 
     void VulkanDevice::copyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, VkDeviceSize size)
     {
+        JATE_PROFILE_SCOPE("VulkanDevice::copyBuffer");
+
         if (m_commandManager == nullptr)
         {
             throw std::runtime_error("Cannot copy buffer in device : command manager is null");
@@ -233,12 +435,24 @@ namespace jate::rendering::vulkan
             cmdBuffer.startRecording();
             cmdBuffer.cmdCopyBuffer(srcBuffer, dstBuffer, size);
             cmdBuffer.endRecording();
-            cmdBuffer.submit();
-            vkQueueWaitIdle(m_graphicsQueue);	// TODO can be optimized using multiple queues and fences ?
+            // Only waits for this copy, not for the frames in flight sharing the queue
+            uint64_t copyDone = cmdBuffer.submit(nullptr, nullptr, m_transferTimeline.get());
+            m_transferTimeline->wait(copyDone);
         }
     }
 
     uint32_t VulkanDevice::findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties)
+    {
+        std::optional<uint32_t> memoryType = tryFindMemoryType(typeFilter, properties);
+        if (!memoryType.has_value())
+        {
+            throw std::runtime_error("failed to find suitable memory type!");
+        }
+
+        return memoryType.value();
+    }
+
+    std::optional<uint32_t> VulkanDevice::tryFindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties)
     {
         VkPhysicalDeviceMemoryProperties memProperties;
         vkGetPhysicalDeviceMemoryProperties(m_physicalDevice, &memProperties);
@@ -250,7 +464,7 @@ namespace jate::rendering::vulkan
             }
         }
 
-        throw std::runtime_error("failed to find suitable memory type!");
+        return std::nullopt;
     }
 
     VkFormat VulkanDevice::findSupportedFormat(const std::vector<VkFormat> &candidates, VkImageTiling tiling, VkFormatFeatureFlags features)
@@ -272,4 +486,39 @@ namespace jate::rendering::vulkan
 
         throw std::runtime_error("failed to find supported format!");
     }
+
+    VkFormat VulkanDevice::findDepthFormat()
+    {
+        return findSupportedFormat(
+            {VK_FORMAT_D32_SFLOAT, VK_FORMAT_D32_SFLOAT_S8_UINT, VK_FORMAT_D24_UNORM_S8_UINT},
+            VK_IMAGE_TILING_OPTIMAL,
+            VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT
+        );
+    }
+
+    void VulkanDevice::createImageWithInfo(const VkImageCreateInfo &imageInfo, VkMemoryPropertyFlags properties, VkImage &image, VkDeviceMemory &imageMemory)
+    {
+        if (vkCreateImage(m_device, &imageInfo, nullptr, &image) != VK_SUCCESS)
+        {
+            throw std::runtime_error("failed to create image!");
+        }
+
+        VkMemoryRequirements memRequirements;
+        vkGetImageMemoryRequirements(m_device, image, &memRequirements);
+
+        VkMemoryAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocInfo.allocationSize = memRequirements.size;
+        allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, properties);
+
+        if (vkAllocateMemory(m_device, &allocInfo, nullptr, &imageMemory) != VK_SUCCESS)
+        {
+            throw std::runtime_error("failed to allocate image memory!");
+        }
+
+        if (vkBindImageMemory(m_device, image, imageMemory, 0) != VK_SUCCESS)
+        {
+            throw std::runtime_error("failed to bind image memory!");
+        }
+    }
 }
\ No newline at end of file
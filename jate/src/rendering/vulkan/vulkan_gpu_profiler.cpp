@@ -0,0 +1,176 @@
+#include <jate/rendering/vulkan/vulkan_gpu_profiler.h>
+
+#include <spdlog/spdlog.h>
+#include <cassert>
+
+namespace jate::rendering::vulkan
+{
+    VulkanGpuProfiler::VulkanGpuProfiler(VulkanDevice& device, uint8_t framesInFlight, uint32_t maxScopesPerFrame)
+        : m_device(device), m_maxScopesPerFrame(maxScopesPerFrame), m_frames(framesInFlight)
+    {
+        VkPhysicalDeviceProperties deviceProperties;
+        vkGetPhysicalDeviceProperties(m_device.getPhysicalDevice(), &deviceProperties);
+
+        uint32_t queueFamilyCount = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(m_device.getPhysicalDevice(), &queueFamilyCount, nullptr);
+        std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+        vkGetPhysicalDeviceQueueFamilyProperties(m_device.getPhysicalDevice(), &queueFamilyCount, queueFamilies.data());
+
+        uint32_t timestampValidBits = queueFamilies[m_device.getQueueFamilyIndices().graphicsQueueFamily.value()].timestampValidBits;
+        if (timestampValidBits == 0 || deviceProperties.limits.timestampPeriod <= 0.0f)
+        {
+            spdlog::warn("GPU timestamps are not supported by the graphics queue, GPU profiling is disabled");
+            return;
+        }
+
+        m_supported = true;
+        m_timestampPeriodNs = static_cast<double>(deviceProperties.limits.timestampPeriod);
+        m_timestampMask = timestampValidBits >= 64 ? UINT64_MAX : ((uint64_t(1) << timestampValidBits) - 1);
+
+        init_createQueryPools();
+    }
+
+    VulkanGpuProfiler::~VulkanGpuProfiler()
+    {
+        destroyQueryPools();
+    }
+
+    void VulkanGpuProfiler::destroyQueryPools()
+    {
+        for (auto& frame : m_frames)
+        {
+            if (frame.queryPool != VK_NULL_HANDLE)
+                vkDestroyQueryPool(m_device.getVkDevice(), frame.queryPool, nullptr);
+
+            frame.queryPool = VK_NULL_HANDLE;
+            frame.scopes.clear();
+        }
+    }
+
+    void VulkanGpuProfiler::resize(uint8_t framesInFlight)
+    {
+        destroyQueryPools();
+        m_frames.resize(framesInFlight);
+        m_currentFrameInFlight = 0;
+
+        if (m_supported)
+            init_createQueryPools();
+    }
+
+    void VulkanGpuProfiler::init_createQueryPools()
+    {
+        VkQueryPoolCreateInfo createInfo{};
+        createInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        createInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+        createInfo.queryCount = m_maxScopesPerFrame * 2;
+
+        for (auto& frame : m_frames)
+        {
+            if (vkCreateQueryPool(m_device.getVkDevice(), &createInfo, nullptr, &frame.queryPool) != VK_SUCCESS)
+            {
+                spdlog::error("Failed to create timestamp query pool, GPU profiling is disabled");
+                m_supported = false;
+                return;
+            }
+            frame.scopes.reserve(m_maxScopesPerFrame);
+        }
+    }
+
+    void VulkanGpuProfiler::beginFrame(uint8_t frameInFlight)
+    {
+        if (!m_supported) return;
+        assert(frameInFlight < m_frames.size() && "Invalid frame in flight index");
+
+        m_currentFrameInFlight = frameInFlight;
+
+        FrameQueries& frame = m_frames[m_currentFrameInFlight];
+        collectResults(frame);
+        frame.scopes.clear();
+    }
+
+    void VulkanGpuProfiler::collectResults(FrameQueries& frame)
+    {
+        if (frame.scopes.empty()) return;
+
+        // Value + availability for each query
+        uint32_t queryCount = static_cast<uint32_t>(frame.scopes.size()) * 2;
+        std::vector<uint64_t> results(queryCount * 2);
+
+        // No WAIT flag : the frame fence has been waited on, so results are ready. If they are not, the frame is skipped.
+        VkResult result = vkGetQueryPoolResults(m_device.getVkDevice(), frame.queryPool, 0, queryCount,
+            results.size() * sizeof(uint64_t), results.data(), 2 * sizeof(uint64_t),
+            VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+
+        if (result != VK_SUCCESS && result != VK_NOT_READY)
+        {
+            spdlog::error("Failed to read GPU timestamps");
+            return;
+        }
+
+        for (size_t i = 0; i < frame.scopes.size(); i++)
+        {
+            const Scope& scope = frame.scopes[i];
+            if (!scope.closed) continue;
+
+            uint64_t beginTimestamp = results[4 * i];
+            uint64_t beginAvailable = results[4 * i + 1];
+            uint64_t endTimestamp = results[4 * i + 2];
+            uint64_t endAvailable = results[4 * i + 3];
+            if (beginAvailable == 0 || endAvailable == 0) continue;
+
+            uint64_t ticks = (endTimestamp - beginTimestamp) & m_timestampMask;
+            double durationMs = static_cast<double>(ticks) * m_timestampPeriodNs / 1e6;
+
+            m_scopeStats[scope.name].addSample(durationMs);
+        }
+    }
+
+    void VulkanGpuProfiler::cmdResetQueries(VkCommandBuffer commandBuffer)
+    {
+        if (!m_supported) return;
+
+        vkCmdResetQueryPool(commandBuffer, m_frames[m_currentFrameInFlight].queryPool, 0, m_maxScopesPerFrame * 2);
+    }
+
+    uint32_t VulkanGpuProfiler::cmdBeginScope(VkCommandBuffer commandBuffer, const std::string& name)
+    {
+        if (!m_supported) return ms_INVALID_SCOPE;
+
+        FrameQueries& frame = m_frames[m_currentFrameInFlight];
+        if (frame.scopes.size() >= m_maxScopesPerFrame)
+        {
+            spdlog::warn("GPU profiler : too many scopes in one frame, ignoring scope {}", name);
+            return ms_INVALID_SCOPE;
+        }
+
+        uint32_t scopeId = static_cast<uint32_t>(frame.scopes.size());
+        frame.scopes.push_back({name, false});
+
+        vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, frame.queryPool, 2 * scopeId);
+        return scopeId;
+    }
+
+    void VulkanGpuProfiler::cmdEndScope(VkCommandBuffer commandBuffer, uint32_t scopeId)
+    {
+        if (!m_supported || scopeId == ms_INVALID_SCOPE) return;
+
+        FrameQueries& frame = m_frames[m_currentFrameInFlight];
+        assert(scopeId < frame.scopes.size() && "Invalid GPU profiler scope id");
+
+        vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, frame.queryPool, 2 * scopeId + 1);
+        frame.scopes[scopeId].closed = true;
+    }
+
+    std::vector<GpuScopeTiming> VulkanGpuProfiler::getTimings() const
+    {
+        std::vector<GpuScopeTiming> timings;
+        timings.reserve(m_scopeStats.size());
+
+        for (const auto& [name, stats] : m_scopeStats)
+        {
+            timings.push_back({name, stats.getMin(), stats.getAverage(), stats.getMax()});
+        }
+
+        return timings;
+    }
+}
\ No newline at end of file
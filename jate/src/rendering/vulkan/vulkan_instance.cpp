@@ -1,18 +1,28 @@
 #include <jate/rendering/vulkan/vulkan_instance.h>
 
 #include <spdlog/spdlog.h>
+#include <algorithm>
 
 namespace jate::rendering::vulkan
 {
-    VulkanInstance::VulkanInstance(const std::string& appName)
+    VulkanInstance::VulkanInstance(const std::string& appName, bool headless) : m_headless(headless)
     {
+        // Vulkan 1.0 loaders do not have vkEnumerateInstanceVersion, and reject any other api version
+        auto enumerateInstanceVersion = (PFN_vkEnumerateInstanceVersion) vkGetInstanceProcAddr(nullptr, "vkEnumerateInstanceVersion");
+        if (enumerateInstanceVersion != nullptr)
+        {
+            uint32_t loaderVersion = VK_API_VERSION_1_0;
+            enumerateInstanceVersion(&loaderVersion);
+            m_apiVersion = std::min(loaderVersion, ms_MAX_API_VERSION);
+        }
+
         VkApplicationInfo appInfo{};
         appInfo.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
         appInfo.pApplicationName = appName.c_str();
         appInfo.applicationVersion = VK_MAKE_VERSION(1, 0, 0);
         appInfo.pEngineName = "jate";
         appInfo.engineVersion = VK_MAKE_VERSION(1, 0, 0);
-        appInfo.apiVersion = VK_API_VERSION_1_0;
+        appInfo.apiVersion = m_apiVersion;
 
         VkInstanceCreateInfo createInfo{};
         createInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
@@ -92,11 +102,15 @@ namespace jate::rendering::vulkan
         std::vector<VkExtensionProperties> supportedExtensions(supportedExtensionCount);
         vkEnumerateInstanceExtensionProperties(nullptr, &supportedExtensionCount, supportedExtensions.data());
 
-        // Get GLFW required extensions
-        uint32_t glfwExtensionCount = 0;
-        const char** glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
+        std::vector<const char*> requiredExtensions;
 
-        std::vector<const char*> requiredExtensions(glfwExtensions, glfwExtensions + glfwExtensionCount);
+        // Get GLFW required extensions (surface extensions), not needed when rendering offscreen
+        if (!m_headless)
+        {
+            uint32_t glfwExtensionCount = 0;
+            const char** glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
+            requiredExtensions.assign(glfwExtensions, glfwExtensions + glfwExtensionCount);
+        }
 
         // Add required extensions here
         requiredExtensions.emplace_back(VK_KHR_PORTABILITY_ENUMERATION_EXTENSION_NAME); // Solves VK_ERROR_INCOMPATIBLE_DRIVER with some versions of MoltenVK SDK (MacOS)
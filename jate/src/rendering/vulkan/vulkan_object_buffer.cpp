@@ -0,0 +1,69 @@
+#include <jate/rendering/vulkan/vulkan_object_buffer.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace jate::rendering::vulkan
+{
+    VulkanObjectBuffer::VulkanObjectBuffer(VulkanDevice& device, VulkanBindlessDescriptors& bindlessDescriptors, uint8_t framesInFlight)
+        : m_device(device), m_bindlessDescriptors(bindlessDescriptors)
+    {
+        m_frameBuffers.resize(framesInFlight);
+    }
+
+    VulkanObjectBuffer::~VulkanObjectBuffer()
+    {
+        for (auto& frameBuffer : m_frameBuffers)
+        {
+            releaseFrameBuffer(frameBuffer);
+        }
+    }
+
+    void VulkanObjectBuffer::releaseFrameBuffer(FrameBuffer& frameBuffer)
+    {
+        if (frameBuffer.buffer == VK_NULL_HANDLE)
+            return;
+
+        // Frames still in flight may read the buffer through its slot : both are released once they are done
+        m_bindlessDescriptors.removeStorageBuffer(frameBuffer.bindlessIndex);
+        m_device.destroyBufferDeferred(frameBuffer.buffer, frameBuffer.memory);
+        frameBuffer = {};
+    }
+
+    void VulkanObjectBuffer::resize(uint8_t framesInFlight)
+    {
+        for (auto& frameBuffer : m_frameBuffers)
+        {
+            releaseFrameBuffer(frameBuffer);
+        }
+        m_frameBuffers.clear();
+        m_frameBuffers.resize(framesInFlight);
+    }
+
+    void VulkanObjectBuffer::upload(uint8_t frameInFlight, const std::vector<ObjectData>& objects)
+    {
+        FrameBuffer& frameBuffer = m_frameBuffers[frameInFlight];
+
+        // Always allocated, even without objects : shaders must never index an unwritten slot
+        uint32_t objectCount = static_cast<uint32_t>(objects.size());
+        if (frameBuffer.buffer == VK_NULL_HANDLE || objectCount > frameBuffer.capacity)
+        {
+            uint32_t capacity = std::max({objectCount, frameBuffer.capacity * 2, ms_MIN_CAPACITY});
+            releaseFrameBuffer(frameBuffer);
+
+            VkDeviceSize bufferSize = sizeof(ObjectData) * capacity;
+            m_device.createBuffer(bufferSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                frameBuffer.buffer, frameBuffer.memory);
+            vkMapMemory(m_device.getVkDevice(), frameBuffer.memory, 0, bufferSize, 0, &frameBuffer.mappedData);
+            frameBuffer.capacity = capacity;
+            frameBuffer.bindlessIndex = m_bindlessDescriptors.addStorageBuffer(frameBuffer.buffer);
+        }
+
+        // Host coherent : the writes are visible to the GPU once the frame is submitted
+        if (objectCount > 0)
+        {
+            memcpy(frameBuffer.mappedData, objects.data(), sizeof(ObjectData) * objectCount);
+        }
+    }
+}
\ No newline at end of file
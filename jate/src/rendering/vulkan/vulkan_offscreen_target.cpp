@@ -0,0 +1,73 @@
+#include <jate/rendering/vulkan/vulkan_offscreen_target.h>
+
+#include <spdlog/spdlog.h>
+
+namespace jate::rendering::vulkan
+{
+    VulkanOffscreenTarget::VulkanOffscreenTarget(VulkanDevice& device, VkExtent2D extent, uint32_t imageCount)
+        : m_device(device), m_extent(extent)
+    {
+        init_createColorResources(imageCount);
+    }
+
+    VulkanOffscreenTarget::~VulkanOffscreenTarget()
+    {
+        for (size_t i = 0; i < m_colorImages.size(); i++)
+        {
+            vkDestroyImageView(m_device.getVkDevice(), m_colorImageViews[i], nullptr);
+            vkDestroyImage(m_device.getVkDevice(), m_colorImages[i], nullptr);
+            vkFreeMemory(m_device.getVkDevice(), m_colorImageMemorys[i], nullptr);
+        }
+    }
+
+    void VulkanOffscreenTarget::init_createColorResources(uint32_t imageCount)
+    {
+        m_colorImages.resize(imageCount);
+        m_colorImageMemorys.resize(imageCount);
+        m_colorImageViews.resize(imageCount);
+
+        for (size_t i = 0; i < m_colorImages.size(); i++)
+        {
+            VkImageCreateInfo imageInfo{};
+            imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+            imageInfo.imageType = VK_IMAGE_TYPE_2D;
+            imageInfo.extent.width = m_extent.width;
+            imageInfo.extent.height = m_extent.height;
+            imageInfo.extent.depth = 1;
+            imageInfo.mipLevels = 1;
+            imageInfo.arrayLayers = 1;
+            imageInfo.format = ms_COLOR_FORMAT;
+            imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+            imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            imageInfo.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+            imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+            imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+            imageInfo.flags = 0;
+
+            m_device.createImageWithInfo(imageInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_colorImages[i], m_colorImageMemorys[i]);
+            m_colorImageViews[i] = createImageView(m_colorImages[i], ms_COLOR_FORMAT, VK_IMAGE_ASPECT_COLOR_BIT);
+        }
+    }
+
+    VkImageView VulkanOffscreenTarget::createImageView(VkImage image, VkFormat format, VkImageAspectFlags aspectMask) const
+    {
+        VkImageViewCreateInfo viewInfo{};
+        viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.image = image;
+        viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        viewInfo.format = format;
+        viewInfo.subresourceRange.aspectMask = aspectMask;
+        viewInfo.subresourceRange.baseMipLevel = 0;
+        viewInfo.subresourceRange.levelCount = 1;
+        viewInfo.subresourceRange.baseArrayLayer = 0;
+        viewInfo.subresourceRange.layerCount = 1;
+
+        VkImageView imageView = VK_NULL_HANDLE;
+        if (vkCreateImageView(m_device.getVkDevice(), &viewInfo, nullptr, &imageView) != VK_SUCCESS)
+        {
+            spdlog::error("Failed to create offscreen image view");
+        }
+
+        return imageView;
+    }
+}
\ No newline at end of file
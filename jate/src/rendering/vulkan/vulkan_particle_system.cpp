@@ -0,0 +1,156 @@
+#include <jate/rendering/vulkan/vulkan_particle_system.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+namespace jate::rendering::vulkan
+{
+    static_assert(sizeof(ParticlePushConstants) <= 128, "Particle push constants must fit the minimum push constant size");
+
+    VulkanParticleSystem::VulkanParticleSystem(VulkanDevice& device, VulkanBindlessDescriptors& bindlessDescriptors, const ParticleEmitterSettings& settings)
+        : m_device(device), m_bindlessDescriptors(bindlessDescriptors), m_settings(settings)
+    {
+        m_settings.maxParticles = std::max(m_settings.maxParticles, 1u);
+
+        init_createBuffers();
+        init_uploadInitialState();
+
+        // Everything but the frame parameters is fixed
+        m_pushConstants.initialVelocityAndSpread = glm::vec4(m_settings.initialVelocity, m_settings.velocitySpread);
+        m_pushConstants.startColor = m_settings.startColor;
+        m_pushConstants.endColor = m_settings.endColor;
+        m_pushConstants.lifetimeAndSize = glm::vec4(m_settings.minLifetime, m_settings.maxLifetime, m_settings.startSize, m_settings.endSize);
+        m_pushConstants.positionsIndex = m_positions.bindlessIndex;
+        m_pushConstants.velocitiesIndex = m_velocities.bindlessIndex;
+        m_pushConstants.deadListIndex = m_deadList.bindlessIndex;
+        m_pushConstants.stateIndex = m_state.bindlessIndex;
+    }
+
+    VulkanParticleSystem::~VulkanParticleSystem()
+    {
+        releaseStorageBuffer(m_positions);
+        releaseStorageBuffer(m_velocities);
+        releaseStorageBuffer(m_aliveLists[0]);
+        releaseStorageBuffer(m_aliveLists[1]);
+        releaseStorageBuffer(m_deadList);
+        releaseStorageBuffer(m_state);
+    }
+
+    VulkanParticleSystem::StorageBuffer VulkanParticleSystem::createStorageBuffer(VkDeviceSize size, VkBufferUsageFlags extraUsage)
+    {
+        StorageBuffer storageBuffer;
+        m_device.createBuffer(size, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | extraUsage,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, storageBuffer.buffer, storageBuffer.memory);
+        storageBuffer.bindlessIndex = m_bindlessDescriptors.addStorageBuffer(storageBuffer.buffer);
+        return storageBuffer;
+    }
+
+    void VulkanParticleSystem::releaseStorageBuffer(StorageBuffer& storageBuffer)
+    {
+        if (storageBuffer.buffer == VK_NULL_HANDLE)
+            return;
+
+        m_bindlessDescriptors.removeStorageBuffer(storageBuffer.bindlessIndex);
+        m_device.destroyBufferDeferred(storageBuffer.buffer, storageBuffer.memory);
+        storageBuffer = {};
+    }
+
+    void VulkanParticleSystem::uploadToBuffer(const StorageBuffer& storageBuffer, const void* data, VkDeviceSize size)
+    {
+        VkBuffer stagingBuffer;
+        VkDeviceMemory stagingBufferMemory;
+        m_device.createBuffer(size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+            stagingBuffer, stagingBufferMemory);
+
+        void* mappedData;
+        vkMapMemory(m_device.getVkDevice(), stagingBufferMemory, 0, size, 0, &mappedData);
+        memcpy(mappedData, data, static_cast<size_t>(size));
+        vkUnmapMemory(m_device.getVkDevice(), stagingBufferMemory);
+
+        m_device.copyBuffer(stagingBuffer, storageBuffer.buffer, size);
+
+        vkDestroyBuffer(m_device.getVkDevice(), stagingBuffer, nullptr);
+        vkFreeMemory(m_device.getVkDevice(), stagingBufferMemory, nullptr);
+    }
+
+    void VulkanParticleSystem::init_createBuffers()
+    {
+        VkDeviceSize particleCount = m_settings.maxParticles;
+
+        // Structure of arrays : the simulation reads and writes whole vec4s, the draw only reads what it needs
+        m_positions = createStorageBuffer(sizeof(glm::vec4) * particleCount, 0);     // xyz : position, w : age
+        m_velocities = createStorageBuffer(sizeof(glm::vec4) * particleCount, 0);    // xyz : velocity, w : lifetime
+        m_aliveLists[0] = createStorageBuffer(sizeof(uint32_t) * particleCount, 0);
+        m_aliveLists[1] = createStorageBuffer(sizeof(uint32_t) * particleCount, 0);
+        m_deadList = createStorageBuffer(sizeof(uint32_t) * particleCount, 0);
+        m_state = createStorageBuffer(sizeof(ParticleSystemState), VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT);
+    }
+
+    void VulkanParticleSystem::init_uploadInitialState()
+    {
+        std::vector<uint32_t> deadList(m_settings.maxParticles);
+        std::iota(deadList.begin(), deadList.end(), 0u);
+        uploadToBuffer(m_deadList, deadList.data(), sizeof(uint32_t) * deadList.size());
+
+        ParticleSystemState state{};
+        state.emitArgs = {0, 1, 1};
+        state.simulateArgs = {0, 1, 1};
+        state.drawArgs = {6, 0, 0, 0};      // One quad per instance, no particle alive yet
+        state.deadCount = m_settings.maxParticles;
+        uploadToBuffer(m_state, &state, sizeof(state));
+    }
+
+    void VulkanParticleSystem::prepareFrame(const glm::vec3& emitterPosition, float deltaTime, uint32_t seed)
+    {
+        // Spawn rates below one particle per frame still spawn, every few frames
+        m_spawnAccumulator += m_settings.spawnRate * deltaTime;
+        float requestedSpawnCount = std::min(std::floor(m_spawnAccumulator), static_cast<float>(m_settings.maxParticles));
+        m_spawnAccumulator = std::min(m_spawnAccumulator - requestedSpawnCount, 1.f);
+
+        // Particles alive after the last simulation are simulated into the other list
+        uint32_t sourceList = m_destinationList;
+        m_destinationList = 1 - sourceList;
+
+        m_pushConstants.emitterPositionAndRadius = glm::vec4(emitterPosition, m_settings.spawnRadius);
+        m_pushConstants.gravityAndDeltaTime = glm::vec4(m_settings.gravity, deltaTime);
+        m_pushConstants.sourceListIndex = m_aliveLists[sourceList].bindlessIndex;
+        m_pushConstants.destinationListIndex = m_aliveLists[m_destinationList].bindlessIndex;
+        m_pushConstants.requestedSpawnCount = static_cast<uint32_t>(requestedSpawnCount);
+        m_pushConstants.seed = seed;
+    }
+
+    void VulkanParticleSystem::cmdPushConstants(VulkanCommandBuffer& commandBuffer, VkPipelineLayout pipelineLayout) const
+    {
+        commandBuffer.cmdPushConstants(pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT | VK_SHADER_STAGE_COMPUTE_BIT,
+            sizeof(ParticlePushConstants), &m_pushConstants);
+    }
+
+    void VulkanParticleSystem::cmdBegin(VulkanCommandBuffer& commandBuffer, VkPipelineLayout pipelineLayout) const
+    {
+        cmdPushConstants(commandBuffer, pipelineLayout);
+        commandBuffer.cmdDispatch(1);
+    }
+
+    void VulkanParticleSystem::cmdEmit(VulkanCommandBuffer& commandBuffer, VkPipelineLayout pipelineLayout) const
+    {
+        cmdPushConstants(commandBuffer, pipelineLayout);
+        commandBuffer.cmdDispatchIndirect(m_state.buffer, offsetof(ParticleSystemState, emitArgs));
+    }
+
+    void VulkanParticleSystem::cmdSimulate(VulkanCommandBuffer& commandBuffer, VkPipelineLayout pipelineLayout) const
+    {
+        cmdPushConstants(commandBuffer, pipelineLayout);
+        commandBuffer.cmdDispatchIndirect(m_state.buffer, offsetof(ParticleSystemState, simulateArgs));
+    }
+
+    void VulkanParticleSystem::cmdDraw(VulkanCommandBuffer& commandBuffer, VkPipelineLayout pipelineLayout) const
+    {
+        cmdPushConstants(commandBuffer, pipelineLayout);
+        commandBuffer.cmdDrawIndirect(m_state.buffer, offsetof(ParticleSystemState, drawArgs));
+    }
+}
\ No newline at end of file
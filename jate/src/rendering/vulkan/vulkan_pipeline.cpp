@@ -2,80 +2,66 @@
 
 #include <jate/rendering/vulkan/vulkan_buffers.h>
 
-#include <fstream>
+#include <stdexcept>
 
 namespace jate::rendering::vulkan
 {
-    VulkanPipeline::VulkanPipeline(VulkanDevice& device, const std::string& vertFilePath, const std::string& fragFilePath, const PipelineConfigInfo& config)
+    VulkanPipeline::VulkanPipeline(VulkanDevice& device, VkShaderModule vertShaderModule, VkShaderModule fragShaderModule, const PipelineConfigInfo& config,
+		VkPipelineCache pipelineCache, bool allowDerivatives, VkPipeline basePipeline)
 		: m_device(device)
 	{
-		createGraphicsPipeline(vertFilePath, fragFilePath, config);
+		createGraphicsPipeline(vertShaderModule, fragShaderModule, config, pipelineCache, allowDerivatives, basePipeline);
 	}
 
 	VulkanPipeline::~VulkanPipeline()
 	{
-		vkDestroyShaderModule(m_device.getVkDevice(), m_vertShaderModule, nullptr);
-		vkDestroyShaderModule(m_device.getVkDevice(), m_fragShaderModule, nullptr);
 		vkDestroyPipeline(m_device.getVkDevice(), m_graphicsPipeline, nullptr);
 	}
 
-	std::vector<char> VulkanPipeline::readFile(const std::string& path)
+	void VulkanPipeline::createGraphicsPipeline(VkShaderModule vertShaderModule, VkShaderModule fragShaderModule, const PipelineConfigInfo& config, VkPipelineCache pipelineCache,
+		bool allowDerivatives, VkPipeline basePipeline)
 	{
-		std::ifstream file(path, std::ios::ate | std::ios::binary);
-		if (!file.is_open())
+		// Constants are resolved when the pipeline is compiled : branches on them cost nothing at runtime
+		std::vector<VkSpecializationMapEntry> specializationEntries(config.specializationConstants.size());
+		for (uint32_t i = 0; i < specializationEntries.size(); i++)
 		{
-			throw std::runtime_error("failed to open file " + path + " !");
+			specializationEntries[i].constantID = i;
+			specializationEntries[i].offset = i * sizeof(uint32_t);
+			specializationEntries[i].size = sizeof(uint32_t);
 		}
 
-		size_t fileSize = static_cast<size_t>(file.tellg());
-		std::vector<char> buffer(fileSize);
-
-		file.seekg(0);
-		file.read(buffer.data(), fileSize);
-
-		file.close();
-
-		return buffer;
-	}
-
-	void VulkanPipeline::createGraphicsPipeline(const std::string& vertFilePath, const std::string& fragFilePath, const PipelineConfigInfo& config)
-	{
-		auto vertCode = readFile(vertFilePath);
-		auto fragCode = readFile(fragFilePath);
-
-		/*std::cout << "vert code size : " << vertCode.size() << std::endl;
-		std::cout << "frag code size : " << fragCode.size() << std::endl;*/
-
-		createShaderModule(vertCode, &m_vertShaderModule);
-		createShaderModule(fragCode, &m_fragShaderModule);
+		VkSpecializationInfo specializationInfo{};
+		specializationInfo.mapEntryCount = static_cast<uint32_t>(specializationEntries.size());
+		specializationInfo.pMapEntries = specializationEntries.data();
+		specializationInfo.dataSize = config.specializationConstants.size() * sizeof(uint32_t);
+		specializationInfo.pData = config.specializationConstants.data();
+		const VkSpecializationInfo* stageSpecializationInfo = specializationEntries.empty() ? nullptr : &specializationInfo;
 
 		VkPipelineShaderStageCreateInfo shaderStages[2];
 		// Vertex stage
 		shaderStages[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
 		shaderStages[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
-		shaderStages[0].module = m_vertShaderModule;
+		shaderStages[0].module = vertShaderModule;
 		shaderStages[0].pName = "main";
 		shaderStages[0].flags = 0;
 		shaderStages[0].pNext = nullptr;
-		shaderStages[0].pSpecializationInfo = nullptr;
+		shaderStages[0].pSpecializationInfo = stageSpecializationInfo;
 		// Fragment stage
 		shaderStages[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
 		shaderStages[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
-		shaderStages[1].module = m_fragShaderModule;
+		shaderStages[1].module = fragShaderModule;
 		shaderStages[1].pName = "main";
 		shaderStages[1].flags = 0;
 		shaderStages[1].pNext = nullptr;
-		shaderStages[1].pSpecializationInfo = nullptr;
+		shaderStages[1].pSpecializationInfo = stageSpecializationInfo;
 
 		// Setup vertex input
-		auto bindingDescriptions = VulkanVertexBuffer::getVertexBindingDescriptions();
-		auto attributeDescriptions = VulkanVertexBuffer::getVertexAttributeDescriptions();
 		VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
 		vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-		vertexInputInfo.vertexBindingDescriptionCount = static_cast<uint32_t>(bindingDescriptions.size());
-		vertexInputInfo.pVertexBindingDescriptions = bindingDescriptions.data();
-		vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDescriptions.size());
-		vertexInputInfo.pVertexAttributeDescriptions = attributeDescriptions.data();
+		vertexInputInfo.vertexBindingDescriptionCount = static_cast<uint32_t>(config.bindingDescriptions.size());
+		vertexInputInfo.pVertexBindingDescriptions = config.bindingDescriptions.data();
+		vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(config.attributeDescriptions.size());
+		vertexInputInfo.pVertexAttributeDescriptions = config.attributeDescriptions.data();
 
 		// Setup graphics pipeline
 		VkGraphicsPipelineCreateInfo graphicsPipelineInfo{};
@@ -97,30 +83,39 @@ namespace jate::rendering::vulkan
 		graphicsPipelineInfo.subpass = config.subpass;
 		graphicsPipelineInfo.layout = config.pipelineLayout;
 
-		graphicsPipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
+		// Without a render pass (dynamic rendering), the pipeline is only bound to attachment formats
+		VkPipelineRenderingCreateInfo renderingInfo{};
+		if (config.renderPass == VK_NULL_HANDLE)
+		{
+			bool hasStencil = config.depthAttachmentFormat == VK_FORMAT_D32_SFLOAT_S8_UINT || config.depthAttachmentFormat == VK_FORMAT_D24_UNORM_S8_UINT
+				|| config.depthAttachmentFormat == VK_FORMAT_D16_UNORM_S8_UINT;
+
+			renderingInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO;
+			renderingInfo.colorAttachmentCount = static_cast<uint32_t>(config.colorAttachmentFormats.size());
+			renderingInfo.pColorAttachmentFormats = config.colorAttachmentFormats.data();
+			renderingInfo.depthAttachmentFormat = config.depthAttachmentFormat;
+			renderingInfo.stencilAttachmentFormat = hasStencil ? config.depthAttachmentFormat : VK_FORMAT_UNDEFINED;
+			graphicsPipelineInfo.pNext = &renderingInfo;
+		}
+
+		if (allowDerivatives)
+		{
+			graphicsPipelineInfo.flags |= VK_PIPELINE_CREATE_ALLOW_DERIVATIVES_BIT;
+		}
+		if (basePipeline != VK_NULL_HANDLE)
+		{
+			graphicsPipelineInfo.flags |= VK_PIPELINE_CREATE_DERIVATIVE_BIT;
+		}
+		graphicsPipelineInfo.basePipelineHandle = basePipeline;
 		graphicsPipelineInfo.basePipelineIndex = -1;
 
-		if (vkCreateGraphicsPipelines(m_device.getVkDevice(), VK_NULL_HANDLE, 1, &graphicsPipelineInfo, nullptr, &m_graphicsPipeline) != VK_SUCCESS)
+		// The pipeline cache lets the driver skip shader compilation for pipelines it has already built
+		if (vkCreateGraphicsPipelines(m_device.getVkDevice(), pipelineCache, 1, &graphicsPipelineInfo, nullptr, &m_graphicsPipeline) != VK_SUCCESS)
 		{
 			throw std::runtime_error("failed to create graphics pipeline");
 		};
 	}
 
-	void VulkanPipeline::createShaderModule(const std::vector<char>& shaderCode, VkShaderModule* shaderModule)
-	{
-		VkShaderModuleCreateInfo createInfo{};
-		createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-		createInfo.codeSize = shaderCode.size();
-		createInfo.pCode = reinterpret_cast<const uint32_t*>(shaderCode.data());
-		createInfo.flags = 0;
-
-		if (vkCreateShaderModule(m_device.getVkDevice(), &createInfo, nullptr, shaderModule) != VK_SUCCESS)
-		{
-			throw new std::runtime_error("failed to create shader module");
-		}
-	}
-
-
 	void VulkanPipeline::PipelineConfigInfo::defaultConfig(PipelineConfigInfo& conf)
 	{
 		conf.viewportInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
@@ -191,6 +186,10 @@ namespace jate::rendering::vulkan
 		conf.depthStencilInfo.front = {};  // Optional
 		conf.depthStencilInfo.back = {};   // Optional
 
+		// Vertex input, in the default layout
+		conf.bindingDescriptions = VulkanVertexBuffer::getVertexBindingDescriptions(VertexLayout{});
+		conf.attributeDescriptions = VulkanVertexBuffer::getVertexAttributeDescriptions(VertexLayout{});
+
 		// Dynamic states
 		conf.dynamicStateEnables = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
 		conf.dynamicStateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
@@ -0,0 +1,182 @@
+#include <jate/rendering/vulkan/vulkan_pipeline_cache.h>
+
+#include <spdlog/spdlog.h>
+#include <filesystem>
+#include <fstream>
+#include <cstring>
+
+namespace jate::rendering::vulkan
+{
+    VulkanPipelineCache::VulkanPipelineCache(VulkanDevice& device, const std::string& cacheFilePath)
+        : m_device(device), m_cacheFilePath(cacheFilePath)
+    {
+        vkGetPhysicalDeviceProperties(m_device.getPhysicalDevice(), &m_deviceProperties);
+
+        init_createPipelineCache();
+    }
+
+    VulkanPipelineCache::~VulkanPipelineCache()
+    {
+        if (m_pipelineCache == VK_NULL_HANDLE)
+            return;
+
+        save();
+        vkDestroyPipelineCache(m_device.getVkDevice(), m_pipelineCache, nullptr);
+    }
+
+    void VulkanPipelineCache::init_createPipelineCache()
+    {
+        std::vector<char> initialData = loadCacheData();
+
+        VkPipelineCacheCreateInfo createInfo{};
+        createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        createInfo.initialDataSize = initialData.size();
+        createInfo.pInitialData = initialData.empty() ? nullptr : initialData.data();
+
+        if (vkCreatePipelineCache(m_device.getVkDevice(), &createInfo, nullptr, &m_pipelineCache) != VK_SUCCESS)
+        {
+            // The driver may still reject data that passed our checks : retry with an empty cache
+            createInfo.initialDataSize = 0;
+            createInfo.pInitialData = nullptr;
+            if (vkCreatePipelineCache(m_device.getVkDevice(), &createInfo, nullptr, &m_pipelineCache) != VK_SUCCESS)
+            {
+                spdlog::error("Failed to create pipeline cache");
+                m_pipelineCache = VK_NULL_HANDLE;
+                return;
+            }
+        }
+
+        if (!initialData.empty())
+        {
+            spdlog::info("Loaded pipeline cache from {} ({} bytes)", m_cacheFilePath, initialData.size());
+        }
+    }
+
+    std::vector<char> VulkanPipelineCache::loadCacheData() const
+    {
+        std::ifstream file(m_cacheFilePath, std::ios::binary);
+        if (!file.is_open())
+        {
+            return {};
+        }
+
+        FileHeader header{};
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (!file)
+        {
+            spdlog::warn("Pipeline cache {} is truncated, ignoring it", m_cacheFilePath);
+            return {};
+        }
+
+        FileHeader expectedHeader = makeFileHeader();
+        if (header.magic != expectedHeader.magic || header.version != expectedHeader.version)
+        {
+            spdlog::warn("Pipeline cache {} has an unknown format, ignoring it", m_cacheFilePath);
+            return {};
+        }
+
+        if (header.vendorID != expectedHeader.vendorID || header.deviceID != expectedHeader.deviceID ||
+            header.driverVersion != expectedHeader.driverVersion ||
+            std::memcmp(header.pipelineCacheUUID, expectedHeader.pipelineCacheUUID, VK_UUID_SIZE) != 0)
+        {
+            spdlog::info("Pipeline cache {} was created by another device or driver, ignoring it", m_cacheFilePath);
+            return {};
+        }
+
+        // The size comes from the file : checked before allocating, a corrupted one could ask for anything
+        std::error_code ec;
+        uintmax_t fileSize = std::filesystem::file_size(m_cacheFilePath, ec);
+        if (ec || fileSize < sizeof(header) || header.dataSize != fileSize - sizeof(header))
+        {
+            spdlog::warn("Pipeline cache {} is truncated, ignoring it", m_cacheFilePath);
+            return {};
+        }
+
+        std::vector<char> data(static_cast<size_t>(header.dataSize));
+        file.read(data.data(), data.size());
+        if (!file || data.size() < sizeof(VkPipelineCacheHeaderVersionOne))
+        {
+            spdlog::warn("Pipeline cache {} is truncated, ignoring it", m_cacheFilePath);
+            return {};
+        }
+
+        // Also check the header written by the driver itself
+        VkPipelineCacheHeaderVersionOne vkHeader{};
+        std::memcpy(&vkHeader, data.data(), sizeof(vkHeader));
+        if (vkHeader.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE ||
+            vkHeader.vendorID != m_deviceProperties.vendorID || vkHeader.deviceID != m_deviceProperties.deviceID ||
+            std::memcmp(vkHeader.pipelineCacheUUID, m_deviceProperties.pipelineCacheUUID, VK_UUID_SIZE) != 0)
+        {
+            spdlog::warn("Pipeline cache {} has an invalid Vulkan header, ignoring it", m_cacheFilePath);
+            return {};
+        }
+
+        return data;
+    }
+
+    bool VulkanPipelineCache::save() const
+    {
+        if (m_pipelineCache == VK_NULL_HANDLE)
+            return false;
+
+        size_t dataSize = 0;
+        if (vkGetPipelineCacheData(m_device.getVkDevice(), m_pipelineCache, &dataSize, nullptr) != VK_SUCCESS || dataSize == 0)
+        {
+            return false;
+        }
+
+        std::vector<char> data(dataSize);
+        if (vkGetPipelineCacheData(m_device.getVkDevice(), m_pipelineCache, &dataSize, data.data()) != VK_SUCCESS)
+        {
+            spdlog::error("Failed to retrieve pipeline cache data");
+            return false;
+        }
+        data.resize(dataSize);
+
+        FileHeader header = makeFileHeader();     // Value initialized, padding included
+        header.dataSize = static_cast<uint64_t>(dataSize);
+
+        // Write to a temporary file first, so that a crash while saving never leaves a corrupted cache behind
+        std::string tmpPath = m_cacheFilePath + ".tmp";
+        {
+            std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+            if (!file.is_open())
+            {
+                spdlog::error("Failed to open {} to write pipeline cache", tmpPath);
+                return false;
+            }
+
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(data.data(), data.size());
+            if (!file)
+            {
+                spdlog::error("Failed to write pipeline cache to {}", tmpPath);
+                return false;
+            }
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(tmpPath, m_cacheFilePath, ec);
+        if (ec)
+        {
+            spdlog::error("Failed to move pipeline cache to {} : {}", m_cacheFilePath, ec.message());
+            return false;
+        }
+
+        return true;
+    }
+
+    VulkanPipelineCache::FileHeader VulkanPipelineCache::makeFileHeader() const
+    {
+        FileHeader header{};
+        header.magic = ms_FILE_MAGIC;
+        header.version = ms_FILE_VERSION;
+        header.vendorID = m_deviceProperties.vendorID;
+        header.deviceID = m_deviceProperties.deviceID;
+        header.driverVersion = m_deviceProperties.driverVersion;
+        std::memcpy(header.pipelineCacheUUID, m_deviceProperties.pipelineCacheUUID, VK_UUID_SIZE);
+        header.padding = 0;
+        header.dataSize = 0;
+        return header;
+    }
+}
@@ -0,0 +1,142 @@
+#include <jate/rendering/vulkan/vulkan_pipeline_variant_cache.h>
+
+#include <jate/profiling/cpu_profiler.h>
+
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace jate::rendering::vulkan
+{
+    // Fields are appended one by one : whole Vulkan structs would bring their padding and pNext pointers into the key
+    template <typename T>
+    static void appendToKey(std::string& key, const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        size_t offset = key.size();
+        key.resize(offset + sizeof(T));
+        std::memcpy(key.data() + offset, &value, sizeof(T));
+    }
+
+    template <typename T>
+    static void appendToKey(std::string& key, const std::vector<T>& values)
+    {
+        appendToKey(key, values.size());
+        for (const T& value : values)
+        {
+            appendToKey(key, value);
+        }
+    }
+
+    static void appendToKey(std::string& key, const std::string& value)
+    {
+        appendToKey(key, value.size());
+        key += value;
+    }
+
+    VulkanPipelineVariantCache::VulkanPipelineVariantCache(VulkanDevice& device, VulkanShaderCache& shaderCache, VkPipelineCache pipelineCache)
+        : m_device(device), m_shaderCache(shaderCache), m_pipelineCache(pipelineCache)
+    {
+    }
+
+    VulkanPipeline& VulkanPipelineVariantCache::getPipeline(const std::string& vertShader, const std::string& fragShader, const VulkanPipeline::PipelineConfigInfo& config)
+    {
+        std::string key = makeKey(vertShader, fragShader, config);
+        auto pipelineIt = m_pipelines.find(key);
+        if (pipelineIt != m_pipelines.end())
+            return *pipelineIt->second;
+
+        JATE_PROFILE_SCOPE("VulkanPipelineVariantCache::createVariant");
+
+        VkShaderModule vertShaderModule = m_shaderCache.getShaderModule(vertShader);
+        VkShaderModule fragShaderModule = m_shaderCache.getShaderModule(fragShader);
+
+        // Derivatives share most of their state with their base : drivers may build them faster
+        std::string shadersKey = vertShader + "|" + fragShader;
+        auto baseIt = m_basePipelines.find(shadersKey);
+        bool isBase = baseIt == m_basePipelines.end();
+        VkPipeline basePipeline = isBase ? VK_NULL_HANDLE : baseIt->second;
+
+        auto pipeline = std::make_unique<VulkanPipeline>(m_device, vertShaderModule, fragShaderModule, config, m_pipelineCache, isBase, basePipeline);
+        if (isBase)
+        {
+            m_basePipelines.emplace(shadersKey, pipeline->getVkPipeline());
+        }
+
+        VulkanPipeline& result = *pipeline;
+        m_pipelines.emplace(std::move(key), std::move(pipeline));
+        return result;
+    }
+
+    std::string VulkanPipelineVariantCache::makeKey(const std::string& vertShader, const std::string& fragShader, const VulkanPipeline::PipelineConfigInfo& config)
+    {
+        std::string key;
+        key.reserve(512);
+
+        appendToKey(key, vertShader);
+        appendToKey(key, fragShader);
+
+        appendToKey(key, config.viewportInfo.viewportCount);
+        appendToKey(key, config.viewportInfo.scissorCount);
+
+        appendToKey(key, config.inputAssemblyInfo.topology);
+        appendToKey(key, config.inputAssemblyInfo.primitiveRestartEnable);
+
+        const VkPipelineRasterizationStateCreateInfo& rasterization = config.rasterizationInfo;
+        appendToKey(key, rasterization.depthClampEnable);
+        appendToKey(key, rasterization.rasterizerDiscardEnable);
+        appendToKey(key, rasterization.polygonMode);
+        appendToKey(key, rasterization.cullMode);
+        appendToKey(key, rasterization.frontFace);
+        appendToKey(key, rasterization.depthBiasEnable);
+        appendToKey(key, rasterization.depthBiasConstantFactor);
+        appendToKey(key, rasterization.depthBiasClamp);
+        appendToKey(key, rasterization.depthBiasSlopeFactor);
+        appendToKey(key, rasterization.lineWidth);
+
+        const VkPipelineMultisampleStateCreateInfo& multisample = config.multisampleInfo;
+        appendToKey(key, multisample.rasterizationSamples);
+        appendToKey(key, multisample.sampleShadingEnable);
+        appendToKey(key, multisample.minSampleShading);
+        appendToKey(key, multisample.alphaToCoverageEnable);
+        appendToKey(key, multisample.alphaToOneEnable);
+
+        const VkPipelineColorBlendAttachmentState& blend = config.colorBlendAttachment;
+        appendToKey(key, blend.blendEnable);
+        appendToKey(key, blend.srcColorBlendFactor);
+        appendToKey(key, blend.dstColorBlendFactor);
+        appendToKey(key, blend.colorBlendOp);
+        appendToKey(key, blend.srcAlphaBlendFactor);
+        appendToKey(key, blend.dstAlphaBlendFactor);
+        appendToKey(key, blend.alphaBlendOp);
+        appendToKey(key, blend.colorWriteMask);
+        appendToKey(key, config.colorBlendInfo.logicOpEnable);
+        appendToKey(key, config.colorBlendInfo.logicOp);
+        appendToKey(key, config.colorBlendInfo.blendConstants);
+
+        const VkPipelineDepthStencilStateCreateInfo& depthStencil = config.depthStencilInfo;
+        appendToKey(key, depthStencil.depthTestEnable);
+        appendToKey(key, depthStencil.depthWriteEnable);
+        appendToKey(key, depthStencil.depthCompareOp);
+        appendToKey(key, depthStencil.depthBoundsTestEnable);
+        appendToKey(key, depthStencil.minDepthBounds);
+        appendToKey(key, depthStencil.maxDepthBounds);
+        appendToKey(key, depthStencil.stencilTestEnable);
+        appendToKey(key, depthStencil.front);
+        appendToKey(key, depthStencil.back);
+
+        appendToKey(key, config.dynamicStateEnables);
+        appendToKey(key, config.bindingDescriptions);
+        appendToKey(key, config.attributeDescriptions);
+
+        appendToKey(key, config.pipelineLayout);
+        appendToKey(key, config.renderPass);
+        appendToKey(key, config.subpass);
+        appendToKey(key, config.colorAttachmentFormats);
+        appendToKey(key, config.depthAttachmentFormat);
+
+        appendToKey(key, config.specializationConstants);
+
+        return key;
+    }
+}
\ No newline at end of file
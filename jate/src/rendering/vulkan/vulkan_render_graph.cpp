@@ -0,0 +1,902 @@
+#include <jate/rendering/vulkan/vulkan_render_graph.h>
+
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <numeric>
+
+namespace jate::rendering::vulkan
+{
+    static bool isDepthFormat(VkFormat format)
+    {
+        return format == VK_FORMAT_D32_SFLOAT || format == VK_FORMAT_D32_SFLOAT_S8_UINT || format == VK_FORMAT_D24_UNORM_S8_UINT
+            || format == VK_FORMAT_D16_UNORM || format == VK_FORMAT_D16_UNORM_S8_UINT;
+    }
+
+    static bool hasStencilComponent(VkFormat format)
+    {
+        return format == VK_FORMAT_D32_SFLOAT_S8_UINT || format == VK_FORMAT_D24_UNORM_S8_UINT || format == VK_FORMAT_D16_UNORM_S8_UINT;
+    }
+
+    static VkImageAspectFlags getAspectMask(VkFormat format)
+    {
+        if (!isDepthFormat(format))
+            return VK_IMAGE_ASPECT_COLOR_BIT;
+
+        return hasStencilComponent(format) ? (VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT) : VK_IMAGE_ASPECT_DEPTH_BIT;
+    }
+
+    /// @brief Image usage flags needed to use an image in the given layout
+    static VkImageUsageFlags getUsageForLayout(VkImageLayout layout, VkAccessFlags access)
+    {
+        switch (layout)
+        {
+            case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL:          return VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+            case VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL:  return VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+            case VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL:   return VK_IMAGE_USAGE_SAMPLED_BIT;
+            case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL:          return VK_IMAGE_USAGE_SAMPLED_BIT;
+            case VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL:              return VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+            case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL:              return VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+            case VK_IMAGE_LAYOUT_GENERAL:
+                return (access & (VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT)) ? VK_IMAGE_USAGE_STORAGE_BIT : 0;
+            default:
+                return 0;
+        }
+    }
+
+    // --- PASS ---
+
+    void VulkanRenderGraphPass::addColorAttachment(RenderGraphImage image, VkAttachmentLoadOp loadOp, VkClearColorValue clearColor)
+    {
+        Attachment attachment{};
+        attachment.imageIndex = image.index;
+        attachment.loadOp = loadOp;
+        attachment.clearValue.color = clearColor;
+        m_colorAttachments.push_back(attachment);
+
+        VkAccessFlags access = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+        if (loadOp == VK_ATTACHMENT_LOAD_OP_LOAD)
+            access |= VK_ACCESS_COLOR_ATTACHMENT_READ_BIT;
+
+        addUse(false, image.index, {VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, access}, true);
+    }
+
+    void VulkanRenderGraphPass::setDepthAttachment(RenderGraphImage image, VkAttachmentLoadOp loadOp, float clearDepth)
+    {
+        Attachment attachment{};
+        attachment.imageIndex = image.index;
+        attachment.loadOp = loadOp;
+        attachment.clearValue.depthStencil = {clearDepth, 0};
+        m_depthAttachment = attachment;
+
+        // Depth is read by the depth test, and written both by the clear and by the depth writes
+        addUse(false, image.index, {
+            VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+            VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+            VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT
+        }, true);
+    }
+
+    void VulkanRenderGraphPass::readImage(RenderGraphImage image, VkImageLayout layout, VkPipelineStageFlags stages, VkAccessFlags access)
+    {
+        addUse(false, image.index, {layout, stages, access}, false);
+    }
+
+    void VulkanRenderGraphPass::writeImage(RenderGraphImage image, VkImageLayout layout, VkPipelineStageFlags stages, VkAccessFlags access)
+    {
+        addUse(false, image.index, {layout, stages, access}, true);
+    }
+
+    void VulkanRenderGraphPass::readBuffer(RenderGraphBuffer buffer, VkPipelineStageFlags stages, VkAccessFlags access)
+    {
+        addUse(true, buffer.index, {VK_IMAGE_LAYOUT_UNDEFINED, stages, access}, false);
+    }
+
+    void VulkanRenderGraphPass::writeBuffer(RenderGraphBuffer buffer, VkPipelineStageFlags stages, VkAccessFlags access)
+    {
+        addUse(true, buffer.index, {VK_IMAGE_LAYOUT_UNDEFINED, stages, access}, true);
+    }
+
+    void VulkanRenderGraphPass::addUse(bool isBuffer, uint32_t index, RenderGraphResourceState state, bool write)
+    {
+        // A resource used twice by the same pass is merged into a single use : it can only be in one layout at a time
+        for (auto& use : m_uses)
+        {
+            if (use.isBuffer != isBuffer || use.index != index)
+                continue;
+
+            if (use.state.layout != state.layout)
+            {
+                spdlog::error("[Render Graph] Pass {} uses resource {} in two different layouts", m_name, index);
+                return;
+            }
+
+            use.state.stages |= state.stages;
+            use.state.access |= state.access;
+            use.write |= write;
+            return;
+        }
+
+        m_uses.push_back({isBuffer, index, state, write});
+    }
+
+    // --- GRAPH ---
+
+    VulkanRenderGraph::VulkanRenderGraph(VulkanDevice& device)
+        : m_device(device), m_useDynamicRendering(device.isDynamicRenderingEnabled())
+    {
+    }
+
+    VulkanRenderGraph::~VulkanRenderGraph()
+    {
+        destroyResources();
+    }
+
+    void VulkanRenderGraph::destroyResources()
+    {
+        VkDevice device = m_device.getVkDevice();
+
+        for (auto& pass : m_passes)
+        {
+            for (const auto& frameBuffer : pass->m_frameBuffers)
+            {
+                vkDestroyFramebuffer(device, frameBuffer.second, nullptr);
+            }
+            pass->m_frameBuffers.clear();
+
+            if (pass->m_renderPass != VK_NULL_HANDLE)
+            {
+                vkDestroyRenderPass(device, pass->m_renderPass, nullptr);
+                pass->m_renderPass = VK_NULL_HANDLE;
+            }
+        }
+
+        for (auto& image : m_images)
+        {
+            if (image.imported)
+                continue;
+
+            if (image.imageView != VK_NULL_HANDLE)
+                vkDestroyImageView(device, image.imageView, nullptr);
+            if (image.image != VK_NULL_HANDLE)
+                vkDestroyImage(device, image.image, nullptr);
+
+            image.imageView = VK_NULL_HANDLE;
+            image.image = VK_NULL_HANDLE;
+        }
+
+        for (auto& block : m_memoryBlocks)
+        {
+            vkFreeMemory(device, block.memory, nullptr);
+        }
+        m_memoryBlocks.clear();
+    }
+
+    RenderGraphImage VulkanRenderGraph::importImage(const std::string& name, VkFormat format, VkExtent2D extent,
+        RenderGraphResourceState initialState, RenderGraphResourceState finalState)
+    {
+        ImageResource image{};
+        image.name = name;
+        image.format = format;
+        image.extent = extent;
+        image.aspect = getAspectMask(format);
+        image.imported = true;
+        image.initialState = initialState;
+        image.finalState = finalState;
+        m_images.push_back(image);
+
+        return {static_cast<uint32_t>(m_images.size() - 1)};
+    }
+
+    void VulkanRenderGraph::setImportedImage(RenderGraphImage image, VkImage vkImage, VkImageView vkImageView)
+    {
+        if (image.index >= m_images.size() || !m_images[image.index].imported)
+        {
+            spdlog::error("[Render Graph] Image {} is not an imported image", image.index);
+            return;
+        }
+
+        m_images[image.index].image = vkImage;
+        m_images[image.index].imageView = vkImageView;
+    }
+
+    RenderGraphImage VulkanRenderGraph::createTransientImage(const std::string& name, VkFormat format, VkExtent2D extent)
+    {
+        ImageResource image{};
+        image.name = name;
+        image.format = format;
+        image.extent = extent;
+        image.aspect = getAspectMask(format);
+        image.imported = false;
+        m_images.push_back(image);
+
+        return {static_cast<uint32_t>(m_images.size() - 1)};
+    }
+
+    RenderGraphBuffer VulkanRenderGraph::importBuffer(const std::string& name, VkBuffer vkBuffer, RenderGraphResourceState initialState)
+    {
+        m_buffers.push_back({name, vkBuffer, initialState});
+        return {static_cast<uint32_t>(m_buffers.size() - 1)};
+    }
+
+    void VulkanRenderGraph::setImportedBuffer(RenderGraphBuffer buffer, VkBuffer vkBuffer)
+    {
+        if (buffer.index >= m_buffers.size())
+        {
+            spdlog::error("[Render Graph] Invalid buffer {}", buffer.index);
+            return;
+        }
+
+        m_buffers[buffer.index].buffer = vkBuffer;
+    }
+
+    VulkanRenderGraphPass& VulkanRenderGraph::addPass(const std::string& name, RenderGraphPassType type)
+    {
+        if (m_compiled)
+        {
+            spdlog::error("[Render Graph] Pass {} added after compilation, it will not run", name);
+        }
+
+        m_passes.push_back(std::unique_ptr<VulkanRenderGraphPass>(new VulkanRenderGraphPass(name, type)));
+        return *m_passes.back();
+    }
+
+    void VulkanRenderGraph::compile()
+    {
+        if (m_compiled)
+        {
+            spdlog::error("[Render Graph] Graph is already compiled");
+            return;
+        }
+
+        for (const auto& pass : m_passes)
+        {
+            for (const auto& use : pass->m_uses)
+            {
+                size_t resourceCount = use.isBuffer ? m_buffers.size() : m_images.size();
+                if (use.index >= resourceCount)
+                {
+                    throw std::runtime_error("[Render Graph] Pass " + pass->m_name + " uses an unknown resource");
+                }
+            }
+        }
+
+        compile_cullPasses();
+        compile_computeTransientUsage();
+        compile_allocateTransientImages();
+        compile_computeBarriers();
+        compile_createRenderPasses();
+
+        m_compiled = true;
+
+        spdlog::debug("[Render Graph] Compiled {} passes ({} culled), {} KiB of transient memory ({} KiB without aliasing, {} KiB lazily allocated)",
+            m_compiledPasses.size(), getCulledPassCount(), m_transientMemorySize / 1024, m_unaliasedTransientMemorySize / 1024, m_lazilyAllocatedMemorySize / 1024);
+    }
+
+    void VulkanRenderGraph::compile_cullPasses()
+    {
+        // Walk backwards from the passes with visible results : a pass is kept if a kept pass reads something it writes
+        std::vector<bool> neededImages(m_images.size(), false);
+        std::vector<bool> neededBuffers(m_buffers.size(), false);
+        for (size_t i = 0; i < m_images.size(); i++)
+        {
+            neededImages[i] = m_images[i].imported;
+        }
+        std::fill(neededBuffers.begin(), neededBuffers.end(), true);    // Buffers are always imported
+
+        for (auto passIt = m_passes.rbegin(); passIt != m_passes.rend(); passIt++)
+        {
+            VulkanRenderGraphPass& pass = **passIt;
+
+            bool needed = pass.m_hasSideEffects;
+            for (const auto& use : pass.m_uses)
+            {
+                if (use.write)
+                    needed |= use.isBuffer ? neededBuffers[use.index] : neededImages[use.index];
+            }
+
+            pass.m_culled = !needed;
+            if (!needed)
+                continue;
+
+            for (const auto& use : pass.m_uses)
+            {
+                // Written resources are needed too : an earlier pass may write the part this one does not overwrite
+                if (use.isBuffer)
+                    neededBuffers[use.index] = true;
+                else
+                    neededImages[use.index] = true;
+            }
+        }
+
+        m_compiledPasses.clear();
+        for (const auto& pass : m_passes)
+        {
+            if (!pass->m_culled)
+                m_compiledPasses.push_back(pass.get());
+        }
+    }
+
+    void VulkanRenderGraph::compile_computeTransientUsage()
+    {
+        for (size_t passIndex = 0; passIndex < m_compiledPasses.size(); passIndex++)
+        {
+            for (const auto& use : m_compiledPasses[passIndex]->m_uses)
+            {
+                if (use.isBuffer)
+                    continue;
+
+                ImageResource& image = m_images[use.index];
+                if (image.imported)
+                    continue;
+
+                image.usage |= getUsageForLayout(use.state.layout, use.state.access);
+                image.firstUse = std::min(image.firstUse, passIndex);
+                image.lastUse = std::max(image.lastUse, passIndex);
+                image.usedStages |= use.state.stages;
+                if (use.write)
+                    image.writeAccess |= use.state.access;
+            }
+        }
+
+        // An image living inside a single pass, as an attachment only, never needs its content in memory :
+        // it is cleared (or undefined) when loaded, and not stored since no later pass uses it
+        const VkImageUsageFlags attachmentUsages = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT;
+        for (auto& image : m_images)
+        {
+            if (image.imported || image.firstUse == SIZE_MAX)
+                continue;
+
+            image.attachmentOnly = image.firstUse == image.lastUse && (image.usage & ~attachmentUsages) == 0;
+            if (image.attachmentOnly)
+                image.usage |= VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+        }
+    }
+
+    void VulkanRenderGraph::compile_allocateTransientImages()
+    {
+        VkDevice device = m_device.getVkDevice();
+
+        std::vector<uint32_t> transientImages;
+        std::vector<VkMemoryRequirements> memoryRequirements(m_images.size());
+
+        for (uint32_t i = 0; i < m_images.size(); i++)
+        {
+            ImageResource& image = m_images[i];
+            if (image.imported || image.firstUse == SIZE_MAX)
+                continue;
+
+            VkImageCreateInfo imageInfo{};
+            imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+            imageInfo.imageType = VK_IMAGE_TYPE_2D;
+            imageInfo.extent = {image.extent.width, image.extent.height, 1};
+            imageInfo.mipLevels = 1;
+            imageInfo.arrayLayers = 1;
+            imageInfo.format = image.format;
+            imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+            imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            imageInfo.usage = image.usage;
+            imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+            imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+            if (vkCreateImage(device, &imageInfo, nullptr, &image.image) != VK_SUCCESS)
+            {
+                throw std::runtime_error("[Render Graph] Failed to create transient image " + image.name);
+            }
+
+            vkGetImageMemoryRequirements(device, image.image, &memoryRequirements[i]);
+            m_unaliasedTransientMemorySize += memoryRequirements[i].size;
+            transientImages.push_back(i);
+        }
+
+        // Greedy aliasing : biggest images first, each one goes to the first block whose images are never alive at the same time
+        std::sort(transientImages.begin(), transientImages.end(), [&memoryRequirements](uint32_t a, uint32_t b) {
+            return memoryRequirements[a].size > memoryRequirements[b].size;
+        });
+
+        for (uint32_t imageIndex : transientImages)
+        {
+            ImageResource& image = m_images[imageIndex];
+            const VkMemoryRequirements& requirements = memoryRequirements[imageIndex];
+
+            for (size_t blockIndex = 0; blockIndex < m_memoryBlocks.size() && image.memoryBlock < 0; blockIndex++)
+            {
+                MemoryBlock& block = m_memoryBlocks[blockIndex];
+                if (block.attachmentOnly != image.attachmentOnly || (block.memoryTypeBits & requirements.memoryTypeBits) == 0)
+                    continue;
+
+                bool overlaps = std::any_of(block.images.begin(), block.images.end(), [this, &image](uint32_t otherIndex) {
+                    const ImageResource& other = m_images[otherIndex];
+                    return image.firstUse <= other.lastUse && other.firstUse <= image.lastUse;
+                });
+                if (overlaps)
+                    continue;
+
+                // Images are all bound at offset 0 : only the alignment of the block's own allocation matters, and it suits any image
+                block.size = std::max(block.size, requirements.size);
+                block.memoryTypeBits &= requirements.memoryTypeBits;
+                block.images.push_back(imageIndex);
+                image.memoryBlock = static_cast<int32_t>(blockIndex);
+            }
+
+            if (image.memoryBlock < 0)
+            {
+                MemoryBlock block{};
+                block.size = requirements.size;
+                block.memoryTypeBits = requirements.memoryTypeBits;
+                block.attachmentOnly = image.attachmentOnly;
+                block.images.push_back(imageIndex);
+                m_memoryBlocks.push_back(block);
+                image.memoryBlock = static_cast<int32_t>(m_memoryBlocks.size() - 1);
+            }
+        }
+
+        for (auto& block : m_memoryBlocks)
+        {
+            std::sort(block.images.begin(), block.images.end(), [this](uint32_t a, uint32_t b) {
+                return m_images[a].firstUse < m_images[b].firstUse;
+            });
+
+            // Desktop GPUs usually have no lazily allocated memory type : transient attachments then use regular memory
+            std::optional<uint32_t> lazyMemoryType;
+            if (block.attachmentOnly)
+                lazyMemoryType = m_device.tryFindMemoryType(block.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT);
+
+            VkMemoryAllocateInfo allocInfo{};
+            allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+            allocInfo.allocationSize = block.size;
+            allocInfo.memoryTypeIndex = lazyMemoryType.has_value() ? lazyMemoryType.value() : m_device.findMemoryType(block.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+            if (vkAllocateMemory(device, &allocInfo, nullptr, &block.memory) != VK_SUCCESS)
+            {
+                throw std::runtime_error("[Render Graph] Failed to allocate transient image memory");
+            }
+            m_transientMemorySize += block.size;
+            if (lazyMemoryType.has_value())
+                m_lazilyAllocatedMemorySize += block.size;
+
+            for (uint32_t imageIndex : block.images)
+            {
+                ImageResource& image = m_images[imageIndex];
+                vkBindImageMemory(device, image.image, block.memory, 0);
+
+                VkImageViewCreateInfo viewInfo{};
+                viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+                viewInfo.image = image.image;
+                viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+                viewInfo.format = image.format;
+                viewInfo.subresourceRange.aspectMask = image.aspect;
+                viewInfo.subresourceRange.baseMipLevel = 0;
+                viewInfo.subresourceRange.levelCount = 1;
+                viewInfo.subresourceRange.baseArrayLayer = 0;
+                viewInfo.subresourceRange.layerCount = 1;
+
+                if (vkCreateImageView(device, &viewInfo, nullptr, &image.imageView) != VK_SUCCESS)
+                {
+                    throw std::runtime_error("[Render Graph] Failed to create transient image view " + image.name);
+                }
+            }
+        }
+    }
+
+    void VulkanRenderGraph::compile_computeBarriers()
+    {
+        std::vector<TrackedState> imageStates(m_images.size());
+        std::vector<TrackedState> bufferStates(m_buffers.size());
+
+        for (size_t i = 0; i < m_images.size(); i++)
+        {
+            const ImageResource& image = m_images[i];
+            TrackedState& state = imageStates[i];
+
+            if (image.imported)
+            {
+                state.layout = image.initialState.layout;
+                state.writeStages = image.initialState.stages;
+                state.writeAccess = image.initialState.access;
+            }
+            else if (image.memoryBlock >= 0)
+            {
+                // Content is undefined at the first use, but the memory may still be in use by the previous image of the block.
+                // The first image of a block waits for the last one, which may belong to the previous frame.
+                const auto& blockImages = m_memoryBlocks[image.memoryBlock].images;
+                auto it = std::find(blockImages.begin(), blockImages.end(), static_cast<uint32_t>(i));
+                uint32_t previousIndex = (it == blockImages.begin()) ? blockImages.back() : *(it - 1);
+
+                state.layout = VK_IMAGE_LAYOUT_UNDEFINED;
+                state.writeStages = m_images[previousIndex].usedStages;
+                state.writeAccess = m_images[previousIndex].writeAccess;
+            }
+        }
+
+        for (size_t i = 0; i < m_buffers.size(); i++)
+        {
+            bufferStates[i].writeStages = m_buffers[i].initialState.stages;
+            bufferStates[i].writeAccess = m_buffers[i].initialState.access;
+        }
+
+        for (VulkanRenderGraphPass* pass : m_compiledPasses)
+        {
+            pass->m_barriers = {};
+            for (const auto& use : pass->m_uses)
+            {
+                TrackedState& state = use.isBuffer ? bufferStates[use.index] : imageStates[use.index];
+                trackUse(state, use.state, use.write, !use.isBuffer, pass->m_barriers, use.index);
+            }
+        }
+
+        // Leave imported images in the state expected after the graph
+        m_finalBarriers = {};
+        for (uint32_t i = 0; i < m_images.size(); i++)
+        {
+            const ImageResource& image = m_images[i];
+            if (!image.imported)
+                continue;
+
+            TrackedState& state = imageStates[i];
+            bool layoutChange = state.layout != image.finalState.layout;
+            bool needsVisibility = image.finalState.access != 0 && state.writeAccess != 0;
+            if (!layoutChange && !needsVisibility)
+                continue;
+
+            m_finalBarriers.srcStages |= state.writeStages | state.readStages;
+            m_finalBarriers.dstStages |= image.finalState.stages;
+            m_finalBarriers.imageBarriers.push_back({i, state.layout, image.finalState.layout, state.writeAccess, image.finalState.access});
+        }
+    }
+
+    void VulkanRenderGraph::trackUse(TrackedState& state, const RenderGraphResourceState& use, bool write, bool isImage, VulkanRenderGraphPass::BarrierBatch& batch, uint32_t index)
+    {
+        bool layoutChange = isImage && state.layout != use.layout;
+
+        bool needsBarrier = false;
+        VkPipelineStageFlags srcStages = 0;
+        VkAccessFlags srcAccess = 0;
+
+        if (layoutChange || write)
+        {
+            // Wait for every previous access : writes (WAW) and reads (WAR). Reads only need an execution dependency.
+            srcStages = state.writeStages | state.readStages;
+            srcAccess = state.writeAccess;
+            needsBarrier = layoutChange || srcStages != 0;
+        }
+        else if (state.writeStages != 0 && ((use.stages & ~state.visibleStages) != 0 || (use.access & ~state.visibleAccess) != 0))
+        {
+            // Read after write, not yet visible to these stages
+            srcStages = state.writeStages;
+            srcAccess = state.writeAccess;
+            needsBarrier = true;
+        }
+
+        if (needsBarrier)
+        {
+            batch.srcStages |= srcStages != 0 ? srcStages : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+            batch.dstStages |= use.stages;
+
+            if (isImage)
+            {
+                batch.imageBarriers.push_back({index, state.layout, use.layout, srcAccess, use.access});
+            }
+            else if (srcAccess != 0)
+            {
+                batch.bufferBarriers.push_back({index, srcAccess, use.access});
+            }
+        }
+
+        if (write)
+        {
+            state.layout = use.layout;
+            state.writeStages = use.stages;
+            state.writeAccess = use.access;
+            state.readStages = 0;
+            state.visibleStages = use.stages;
+            state.visibleAccess = use.access;
+        }
+        else if (layoutChange)
+        {
+            // The layout transition acts as a write : later readers must wait for the stages that waited for it
+            state.layout = use.layout;
+            state.writeStages |= use.stages;
+            state.readStages = use.stages;
+            state.visibleStages = use.stages;
+            state.visibleAccess = use.access;
+        }
+        else
+        {
+            state.readStages |= use.stages;
+            if (needsBarrier)
+            {
+                state.visibleStages |= use.stages;
+                state.visibleAccess |= use.access;
+            }
+        }
+    }
+
+    void VulkanRenderGraph::compile_createRenderPasses()
+    {
+        for (size_t passIndex = 0; passIndex < m_compiledPasses.size(); passIndex++)
+        {
+            VulkanRenderGraphPass& pass = *m_compiledPasses[passIndex];
+            if (pass.m_type != RenderGraphPassType::Graphics)
+                continue;
+
+            // Attachment content only has to be stored if something uses it afterwards
+            auto computeStoreOp = [this, passIndex](uint32_t imageIndex) {
+                if (m_images[imageIndex].imported)
+                    return VK_ATTACHMENT_STORE_OP_STORE;
+
+                for (size_t laterPass = passIndex + 1; laterPass < m_compiledPasses.size(); laterPass++)
+                {
+                    for (const auto& use : m_compiledPasses[laterPass]->m_uses)
+                    {
+                        if (!use.isBuffer && use.index == imageIndex)
+                            return VK_ATTACHMENT_STORE_OP_STORE;
+                    }
+                }
+                return VK_ATTACHMENT_STORE_OP_DONT_CARE;
+            };
+
+            std::vector<VkAttachmentDescription> attachments;
+            std::vector<VkAttachmentReference> colorReferences;
+            VkAttachmentReference depthReference{};
+
+            pass.m_colorAttachmentFormats.clear();
+            for (auto& colorAttachment : pass.m_colorAttachments)
+            {
+                colorAttachment.storeOp = computeStoreOp(colorAttachment.imageIndex);
+                pass.m_colorAttachmentFormats.push_back(m_images[colorAttachment.imageIndex].format);
+
+                VkAttachmentDescription description{};
+                description.format = m_images[colorAttachment.imageIndex].format;
+                description.samples = VK_SAMPLE_COUNT_1_BIT;
+                description.loadOp = colorAttachment.loadOp;
+                description.storeOp = colorAttachment.storeOp;
+                description.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+                description.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+                // Layout transitions are done by the graph barriers, outside of the render pass
+                description.initialLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+                description.finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+                colorReferences.push_back({static_cast<uint32_t>(attachments.size()), VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL});
+                attachments.push_back(description);
+            }
+
+            if (pass.m_depthAttachment.has_value())
+            {
+                auto& depthAttachment = pass.m_depthAttachment.value();
+                depthAttachment.storeOp = computeStoreOp(depthAttachment.imageIndex);
+                pass.m_depthAttachmentFormat = m_images[depthAttachment.imageIndex].format;
+
+                VkAttachmentDescription description{};
+                description.format = m_images[depthAttachment.imageIndex].format;
+                description.samples = VK_SAMPLE_COUNT_1_BIT;
+                description.loadOp = depthAttachment.loadOp;
+                description.storeOp = depthAttachment.storeOp;
+                description.stencilLoadOp = depthAttachment.loadOp == VK_ATTACHMENT_LOAD_OP_CLEAR ? VK_ATTACHMENT_LOAD_OP_CLEAR : VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+                description.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+                description.initialLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+                description.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+                depthReference = {static_cast<uint32_t>(attachments.size()), VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL};
+                attachments.push_back(description);
+            }
+
+            if (m_useDynamicRendering)
+                continue;
+
+            VkSubpassDescription subpass{};
+            subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+            subpass.colorAttachmentCount = static_cast<uint32_t>(colorReferences.size());
+            subpass.pColorAttachments = colorReferences.data();
+            subpass.pDepthStencilAttachment = pass.m_depthAttachment.has_value() ? &depthReference : nullptr;
+
+            VkRenderPassCreateInfo renderPassInfo{};
+            renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+            renderPassInfo.attachmentCount = static_cast<uint32_t>(attachments.size());
+            renderPassInfo.pAttachments = attachments.data();
+            renderPassInfo.subpassCount = 1;
+            renderPassInfo.pSubpasses = &subpass;
+            renderPassInfo.dependencyCount = 0;     // Synchronization is done by the graph barriers
+            renderPassInfo.pDependencies = nullptr;
+
+            if (vkCreateRenderPass(m_device.getVkDevice(), &renderPassInfo, nullptr, &pass.m_renderPass) != VK_SUCCESS)
+            {
+                throw std::runtime_error("[Render Graph] Failed to create render pass for pass " + pass.m_name);
+            }
+        }
+    }
+
+    VkFramebuffer VulkanRenderGraph::getFrameBuffer(VulkanRenderGraphPass& pass)
+    {
+        std::vector<VkImageView> attachmentViews;
+        for (const auto& colorAttachment : pass.m_colorAttachments)
+        {
+            attachmentViews.push_back(m_images[colorAttachment.imageIndex].imageView);
+        }
+        if (pass.m_depthAttachment.has_value())
+        {
+            attachmentViews.push_back(m_images[pass.m_depthAttachment->imageIndex].imageView);
+        }
+
+        auto frameBufferIt = pass.m_frameBuffers.find(attachmentViews);
+        if (frameBufferIt != pass.m_frameBuffers.end())
+            return frameBufferIt->second;
+
+        uint32_t firstImage = pass.m_colorAttachments.empty() ? pass.m_depthAttachment->imageIndex : pass.m_colorAttachments.front().imageIndex;
+        VkExtent2D extent = m_images[firstImage].extent;
+
+        VkFramebufferCreateInfo framebufferInfo{};
+        framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+        framebufferInfo.renderPass = pass.m_renderPass;
+        framebufferInfo.attachmentCount = static_cast<uint32_t>(attachmentViews.size());
+        framebufferInfo.pAttachments = attachmentViews.data();
+        framebufferInfo.width = extent.width;
+        framebufferInfo.height = extent.height;
+        framebufferInfo.layers = 1;
+
+        VkFramebuffer frameBuffer = VK_NULL_HANDLE;
+        if (vkCreateFramebuffer(m_device.getVkDevice(), &framebufferInfo, nullptr, &frameBuffer) != VK_SUCCESS)
+        {
+            spdlog::error("[Render Graph] Failed to create frame buffer for pass {}", pass.m_name);
+            return VK_NULL_HANDLE;
+        }
+
+        pass.m_frameBuffers.emplace(std::move(attachmentViews), frameBuffer);
+        return frameBuffer;
+    }
+
+    void VulkanRenderGraph::recordBarriers(VulkanCommandBuffer& commandBuffer, const VulkanRenderGraphPass::BarrierBatch& batch) const
+    {
+        if (batch.isEmpty())
+            return;
+
+        std::vector<VkImageMemoryBarrier> imageBarriers;
+        imageBarriers.reserve(batch.imageBarriers.size());
+        for (const auto& barrier : batch.imageBarriers)
+        {
+            const ImageResource& image = m_images[barrier.imageIndex];
+
+            VkImageMemoryBarrier imageBarrier{};
+            imageBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            imageBarrier.srcAccessMask = barrier.srcAccess;
+            imageBarrier.dstAccessMask = barrier.dstAccess;
+            imageBarrier.oldLayout = barrier.oldLayout;
+            imageBarrier.newLayout = barrier.newLayout;
+            imageBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            imageBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            imageBarrier.image = image.image;
+            imageBarrier.subresourceRange.aspectMask = image.aspect;
+            imageBarrier.subresourceRange.baseMipLevel = 0;
+            imageBarrier.subresourceRange.levelCount = 1;
+            imageBarrier.subresourceRange.baseArrayLayer = 0;
+            imageBarrier.subresourceRange.layerCount = 1;
+            imageBarriers.push_back(imageBarrier);
+        }
+
+        std::vector<VkBufferMemoryBarrier> bufferBarriers;
+        bufferBarriers.reserve(batch.bufferBarriers.size());
+        for (const auto& barrier : batch.bufferBarriers)
+        {
+            VkBufferMemoryBarrier bufferBarrier{};
+            bufferBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+            bufferBarrier.srcAccessMask = barrier.srcAccess;
+            bufferBarrier.dstAccessMask = barrier.dstAccess;
+            bufferBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            bufferBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            bufferBarrier.buffer = m_buffers[barrier.bufferIndex].buffer;
+            bufferBarrier.offset = 0;
+            bufferBarrier.size = VK_WHOLE_SIZE;
+            bufferBarriers.push_back(bufferBarrier);
+        }
+
+        VkPipelineStageFlags dstStages = batch.dstStages != 0 ? batch.dstStages : VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+        commandBuffer.cmdPipelineBarrier(batch.srcStages, dstStages, imageBarriers, bufferBarriers);
+    }
+
+    void VulkanRenderGraph::beginGraphicsPass(VulkanCommandBuffer& commandBuffer, VulkanRenderGraphPass& pass)
+    {
+        uint32_t firstImage = pass.m_colorAttachments.empty() ? pass.m_depthAttachment->imageIndex : pass.m_colorAttachments.front().imageIndex;
+        VkExtent2D extent = m_images[firstImage].extent;
+
+        if (!m_useDynamicRendering)
+        {
+            std::vector<VkClearValue> clearValues;
+            for (const auto& colorAttachment : pass.m_colorAttachments)
+            {
+                clearValues.push_back(colorAttachment.clearValue);
+            }
+            if (pass.m_depthAttachment.has_value())
+            {
+                clearValues.push_back(pass.m_depthAttachment->clearValue);
+            }
+
+            commandBuffer.cmdStartRenderPass(pass.m_renderPass, getFrameBuffer(pass), extent, clearValues);
+            return;
+        }
+
+        auto toAttachmentInfo = [this](const VulkanRenderGraphPass::Attachment& attachment, VkImageLayout layout) {
+            VkRenderingAttachmentInfo attachmentInfo{};
+            attachmentInfo.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
+            attachmentInfo.imageView = m_images[attachment.imageIndex].imageView;
+            attachmentInfo.imageLayout = layout;
+            attachmentInfo.resolveMode = VK_RESOLVE_MODE_NONE;
+            attachmentInfo.loadOp = attachment.loadOp;
+            attachmentInfo.storeOp = attachment.storeOp;
+            attachmentInfo.clearValue = attachment.clearValue;
+            return attachmentInfo;
+        };
+
+        std::vector<VkRenderingAttachmentInfo> colorAttachments;
+        for (const auto& colorAttachment : pass.m_colorAttachments)
+        {
+            colorAttachments.push_back(toAttachmentInfo(colorAttachment, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL));
+        }
+
+        VkRenderingAttachmentInfo depthAttachment{};
+        bool hasStencil = false;
+        if (pass.m_depthAttachment.has_value())
+        {
+            depthAttachment = toAttachmentInfo(pass.m_depthAttachment.value(), VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
+            hasStencil = (m_images[pass.m_depthAttachment->imageIndex].aspect & VK_IMAGE_ASPECT_STENCIL_BIT) != 0;
+        }
+
+        VkRenderingInfo renderingInfo{};
+        renderingInfo.sType = VK_STRUCTURE_TYPE_RENDERING_INFO;
+        renderingInfo.renderArea = {{0, 0}, extent};
+        renderingInfo.layerCount = 1;
+        renderingInfo.colorAttachmentCount = static_cast<uint32_t>(colorAttachments.size());
+        renderingInfo.pColorAttachments = colorAttachments.data();
+        renderingInfo.pDepthAttachment = pass.m_depthAttachment.has_value() ? &depthAttachment : nullptr;
+        // A combined depth stencil image must be given as both attachments
+        renderingInfo.pStencilAttachment = hasStencil ? &depthAttachment : nullptr;
+
+        commandBuffer.cmdBeginRendering(renderingInfo);
+    }
+
+    void VulkanRenderGraph::endGraphicsPass(VulkanCommandBuffer& commandBuffer) const
+    {
+        if (m_useDynamicRendering)
+            commandBuffer.cmdEndRendering();
+        else
+            commandBuffer.cmdEndRenderPass();
+    }
+
+    void VulkanRenderGraph::execute(VulkanCommandBuffer& commandBuffer, VulkanGpuProfiler* profiler)
+    {
+        if (!m_compiled)
+        {
+            spdlog::error("[Render Graph] Graph must be compiled before being executed");
+            return;
+        }
+
+        for (const auto& image : m_images)
+        {
+            if (image.imported && image.image == VK_NULL_HANDLE)
+            {
+                spdlog::error("[Render Graph] Imported image {} is not set, skipping the frame", image.name);
+                return;
+            }
+        }
+
+        for (VulkanRenderGraphPass* pass : m_compiledPasses)
+        {
+            recordBarriers(commandBuffer, pass->m_barriers);
+
+            if (profiler != nullptr)
+                commandBuffer.cmdBeginProfileScope(*profiler, pass->m_name);
+
+            if (pass->m_type == RenderGraphPassType::Graphics)
+                beginGraphicsPass(commandBuffer, *pass);
+
+            if (pass->m_executeFunction)
+                pass->m_executeFunction(commandBuffer);
+
+            if (pass->m_type == RenderGraphPassType::Graphics)
+                endGraphicsPass(commandBuffer);
+
+            if (profiler != nullptr)
+                commandBuffer.cmdEndProfileScope(*profiler);
+        }
+
+        recordBarriers(commandBuffer, m_finalBarriers);
+    }
+}
\ No newline at end of file
@@ -1,70 +1,229 @@
 #include <jate/rendering/vulkan/vulkan_renderer.h>
 #include <jate/rendering/vulkan/exceptions.h>
 #include <jate/rendering/data_structs.h>
+#include <jate/profiling/cpu_profiler.h>
 
 #include <spdlog/spdlog.h>
 #include <vector>
+#include <cassert>
+#include <cstring>
+#include <chrono>
+#include <algorithm>
 
 namespace jate::rendering::vulkan
 {
-    VulkanRenderer::VulkanRenderer(Window& window) :
-        ARenderer(window),
-        m_vulkanInstance("My app"),
-        m_vulkanDevice(m_vulkanInstance, m_window)
+    static VkPresentModeKHR toVkPresentMode(PresentMode presentMode)
     {
-        init_createSwapChain();
+        switch (presentMode)
+        {
+            case PresentMode::FifoRelaxed:  return VK_PRESENT_MODE_FIFO_RELAXED_KHR;
+            case PresentMode::Mailbox:      return VK_PRESENT_MODE_MAILBOX_KHR;
+            case PresentMode::Immediate:    return VK_PRESENT_MODE_IMMEDIATE_KHR;
+            case PresentMode::Fifo:
+            default:                        return VK_PRESENT_MODE_FIFO_KHR;
+        }
+    }
+
+    VulkanRenderer::VulkanRenderer(Window* window, const RendererConfig& config) :
+        ARenderer(window, config),
+        m_vulkanInstance("My app", config.headless),
+        m_vulkanDevice(m_vulkanInstance, m_window, config.preferDynamicRendering),
+        m_deletionQueue(m_vulkanDevice.getGraphicsTimeline()),
+        m_vulkanPipelineCache(m_vulkanDevice, "jate_pipeline_cache.bin"),
+        m_shaderCache(m_vulkanDevice),
+        m_gpuProfiler(m_vulkanDevice, std::max<uint8_t>(config.framesInFlight, 1)),
+        m_framesInFlight(std::max<uint8_t>(config.framesInFlight, 1))
+    {
+        m_config.framesInFlight = m_framesInFlight;
+
+        assert((m_window == nullptr) == m_config.headless && "VulkanRenderer needs a window unless it is headless");
+
+        m_vulkanDevice.attachDeletionQueue(&m_deletionQueue);
+
+        init_createRenderTarget();
+        init_createRenderGraph();
         init_createCommandManager();
+        init_createBindlessResources();
         init_createPipelineLayout();
+        init_createSpriteResources();
+        init_createParticleResources();
         init_createPipeline();
         init_createSyncObjects();
+
+#ifdef JATE_SHADER_HOT_RELOAD
+        m_shaderHotReloader = std::make_unique<VulkanShaderHotReloader>(JATE_SHADER_SOURCE_DIR, JATE_GLSLC_EXECUTABLE);
+#endif
     }
 
     VulkanRenderer::~VulkanRenderer()
     {
         vkDeviceWaitIdle(m_vulkanDevice.getVkDevice());
 
+        // Device is idle : every deferred deletion can run now
+        m_vertexBufferSlots.clear();
+        m_indexBufferSlots.clear();
+        m_pipelineVariants = nullptr;
+        m_particleBeginPipeline = nullptr;
+        m_particleEmitPipeline = nullptr;
+        m_particleSimulatePipeline = nullptr;
+        m_particleSystems.clear();
+        m_spriteBatch = nullptr;
+
+        // Allocated after the last frame : never copied, their callbacks never run
+        for (const auto& upload : m_pendingBufferUploads)
+        {
+            vkDestroyBuffer(m_vulkanDevice.getVkDevice(), upload.stagingBuffer, nullptr);
+            vkFreeMemory(m_vulkanDevice.getVkDevice(), upload.stagingMemory, nullptr);
+        }
+        m_pendingBufferUploads.clear();
+        m_pendingUploadCallbacks.clear();
+        m_textureAtlas = nullptr;
+        m_objectBuffer = nullptr;
+        m_renderGraph = nullptr;
+        m_vulkanSwapChain = nullptr;
+        m_offscreenTarget = nullptr;
+        m_deletionQueue.flushAll();
+        m_vulkanDevice.attachDeletionQueue(nullptr);
+        m_bindlessDescriptors = nullptr;
+
         m_vulkanCommandManager = nullptr;
 
-        // Sync objects
-        for (auto imageAvailableSemaphore : m_imageAvailableSemaphores)
+        destroySyncObjects();
+
+        vkDestroyPipelineLayout(m_vulkanDevice.getVkDevice(), m_pipelineLayout, nullptr);
+        vkDestroyPipelineLayout(m_vulkanDevice.getVkDevice(), m_particlePipelineLayout, nullptr);
+    }
+
+    void VulkanRenderer::init_createRenderTarget()
+    {
+        if (m_config.headless)
         {
-            vkDestroySemaphore(m_vulkanDevice.getVkDevice(), imageAvailableSemaphore, nullptr);
+            // One image per frame in flight, so that a frame never renders into an image still being read
+            m_offscreenTarget = std::make_unique<VulkanOffscreenTarget>(m_vulkanDevice, VkExtent2D{m_config.width, m_config.height}, m_framesInFlight);
+            return;
         }
-        for (auto renderFinishedSemaphore : m_renderFinishedSemaphores)
+
+        m_vulkanSwapChain = std::make_unique<VulkanSwapChain>(*m_window, m_vulkanDevice, toVkPresentMode(m_config.presentMode), m_config.swapChainImageCount);
+    }
+
+    void VulkanRenderer::init_createRenderGraph()
+    {
+        if (m_renderGraph != nullptr)
         {
-            vkDestroySemaphore(m_vulkanDevice.getVkDevice(), renderFinishedSemaphore, nullptr);
+            // Transient images may still be used by frames in flight
+            std::shared_ptr<VulkanRenderGraph> oldRenderGraph = std::move(m_renderGraph);
+            m_deletionQueue.push([oldRenderGraph]() mutable { oldRenderGraph.reset(); });
         }
-        for (auto inFlightFence : m_inFlightFences)
+
+        const AVulkanRenderTarget& renderTarget = getRenderTarget();
+        VkExtent2D extent = renderTarget.getExtent();
+
+        m_renderGraph = std::make_unique<VulkanRenderGraph>(m_vulkanDevice);
+
+        // Swap chain images are acquired with a semaphore waited on at the color output stage.
+        // Offscreen images are left ready to be copied, for frame captures.
+        RenderGraphResourceState initialState {VK_IMAGE_LAYOUT_UNDEFINED, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, 0};
+        RenderGraphResourceState finalState {VK_IMAGE_LAYOUT_PRESENT_SRC_KHR, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0};
+        if (m_config.headless)
         {
-            vkDestroyFence(m_vulkanDevice.getVkDevice(), inFlightFence, nullptr);
+            initialState = {VK_IMAGE_LAYOUT_UNDEFINED, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 0};
+            finalState = {VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT};
         }
 
-        vkDestroyPipelineLayout(m_vulkanDevice.getVkDevice(), m_pipelineLayout, nullptr);
+        m_colorTarget = m_renderGraph->importImage("color", renderTarget.getImageFormat(), extent, initialState, finalState);
+        // Depth never leaves the main pass : a single lazily allocated attachment serves every frame in flight
+        RenderGraphImage depth = m_renderGraph->createTransientImage("depth", m_vulkanDevice.findDepthFormat(), extent);
+
+        VulkanRenderGraphPass& mainPass = m_renderGraph->addPass("main_pass", RenderGraphPassType::Graphics);
+        mainPass.addColorAttachment(m_colorTarget, VK_ATTACHMENT_LOAD_OP_CLEAR, {{0.01f, 0.01f, 0.01f, 1.0f}});
+        mainPass.setDepthAttachment(depth, VK_ATTACHMENT_LOAD_OP_CLEAR, 1.0f);
+        mainPass.setExecuteFunction([this, extent](VulkanCommandBuffer& commandBuffer) {
+            // Every pipeline shares the same layout : the bindless set and the push constants stay bound across pipeline changes
+            FramePushConstants pushConstants {m_objectBuffer->getBindlessIndex(m_currentFrameInFlight)};
+            commandBuffer.cmdBindDescriptorSet(m_pipelineLayout, m_bindlessDescriptors->getDescriptorSet());
+            commandBuffer.cmdPushConstants(m_pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, sizeof(pushConstants), &pushConstants);
+
+            commandBuffer.cmdBindPipeline(*m_vulkanPipeline);
+            commandBuffer.cmdSetViewport(0.0f, 0.0f, static_cast<float>(extent.width), static_cast<float>(extent.height));
+            commandBuffer.cmdSetScissor({0, 0}, extent);
+
+            for (uint32_t objectIndex = 0; objectIndex < m_frameDrawCommands.size(); objectIndex++)
+            {
+                // Slots freed after being drawn this frame are skipped
+                const DrawCommand& drawCommand = m_frameDrawCommands[objectIndex];
+                auto vertexBufferIt = m_vertexBufferSlots.find(drawCommand.verticesSlot);
+                auto indexBufferIt = m_indexBufferSlots.find(drawCommand.indicesSlot);
+                if (vertexBufferIt == m_vertexBufferSlots.end() || indexBufferIt == m_indexBufferSlots.end())
+                    continue;
+
+                // The instance index selects the object data of the draw
+                commandBuffer.cmdDrawIndexedVertexBuffer(*(vertexBufferIt->second), *(indexBufferIt->second), objectIndex);
+            }
+
+            // Sprites are blended over the meshes
+            if (m_spriteBatch->getInstanceCount(m_currentFrameInFlight) > 0)
+            {
+                commandBuffer.cmdBindPipeline(*m_spritePipeline);
+                m_spriteBatch->cmdDraw(commandBuffer, m_currentFrameInFlight);
+            }
+
+            // Particles are blended last. Their push constants differ from the shared ones : the set is bound again with their layout.
+            if (!m_frameParticleSystems.empty())
+            {
+                commandBuffer.cmdBindDescriptorSet(m_particlePipelineLayout, m_bindlessDescriptors->getDescriptorSet());
+                const VulkanPipeline* boundPipeline = nullptr;
+                for (const VulkanParticleSystem* particleSystem : m_frameParticleSystems)
+                {
+                    VulkanPipeline& pipeline = getParticlePipeline(particleSystem->getBlendMode());
+                    if (&pipeline != boundPipeline)
+                    {
+                        commandBuffer.cmdBindPipeline(pipeline);
+                        boundPipeline = &pipeline;
+                    }
+                    particleSystem->cmdDraw(commandBuffer, m_particlePipelineLayout);
+                }
+            }
+        });
+        m_mainPass = &mainPass;
+
+        m_renderGraph->compile();
     }
 
-    void VulkanRenderer::init_createSwapChain()
+    AVulkanRenderTarget& VulkanRenderer::getRenderTarget() const
     {
-        m_vulkanSwapChain = std::make_unique<VulkanSwapChain>(m_window, m_vulkanDevice, std::move(m_vulkanSwapChain));
+        if (m_offscreenTarget != nullptr)
+            return *m_offscreenTarget;
+
+        return *m_vulkanSwapChain;
     }
 
     void VulkanRenderer::init_createCommandManager()
     {
-        m_vulkanCommandManager = std::make_unique<VulkanCommandManager>(m_vulkanDevice, *m_vulkanSwapChain, MAX_FRAMES_IN_FLIGHT);
+        m_vulkanCommandManager = std::make_unique<VulkanCommandManager>(m_vulkanDevice, m_framesInFlight);
         m_vulkanDevice.attachCommandManager(m_vulkanCommandManager.get());
     }
 
+    void VulkanRenderer::init_createBindlessResources()
+    {
+        m_bindlessDescriptors = std::make_unique<VulkanBindlessDescriptors>(m_vulkanDevice, m_config.maxBindlessTextures, m_config.maxBindlessStorageBuffers);
+        m_objectBuffer = std::make_unique<VulkanObjectBuffer>(m_vulkanDevice, *m_bindlessDescriptors, m_framesInFlight);
+    }
+
     void VulkanRenderer::init_createPipelineLayout()
     {
         // Push constant
         VkPushConstantRange pushConstantRange{};
         pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
         pushConstantRange.offset = 0;
-        pushConstantRange.size = sizeof(PushConstantData);
+        pushConstantRange.size = sizeof(FramePushConstants);
+
+        // A single set, whatever the number of textures and objects drawn
+        VkDescriptorSetLayout bindlessSetLayout = m_bindlessDescriptors->getDescriptorSetLayout();
 
         VkPipelineLayoutCreateInfo layoutInfo{};
 		layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-		layoutInfo.setLayoutCount = 0;
-		layoutInfo.pSetLayouts = nullptr;
+		layoutInfo.setLayoutCount = 1;
+		layoutInfo.pSetLayouts = &bindlessSetLayout;
 		layoutInfo.pushConstantRangeCount = 1;
 		layoutInfo.pPushConstantRanges = &pushConstantRange;
 
@@ -75,14 +234,126 @@ namespace jate::rendering::vulkan
 		}
     }
 
+    void VulkanRenderer::init_createSpriteResources()
+    {
+        m_textureAtlas = std::make_unique<VulkanTextureAtlas>(m_vulkanDevice, *m_bindlessDescriptors, m_config.textureAtlasSize);
+        m_spriteBatch = std::make_unique<VulkanSpriteBatch>(m_vulkanDevice, m_framesInFlight);
+    }
+
+    void VulkanRenderer::init_createParticleResources()
+    {
+        // Compute and graphics stages read the same push constants
+        VkPushConstantRange pushConstantRange{};
+        pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT | VK_SHADER_STAGE_COMPUTE_BIT;
+        pushConstantRange.offset = 0;
+        pushConstantRange.size = sizeof(ParticlePushConstants);
+
+        VkDescriptorSetLayout bindlessSetLayout = m_bindlessDescriptors->getDescriptorSetLayout();
+
+        VkPipelineLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layoutInfo.setLayoutCount = 1;
+        layoutInfo.pSetLayouts = &bindlessSetLayout;
+        layoutInfo.pushConstantRangeCount = 1;
+        layoutInfo.pPushConstantRanges = &pushConstantRange;
+
+        if (vkCreatePipelineLayout(m_vulkanDevice.getVkDevice(), &layoutInfo, nullptr, &m_particlePipelineLayout) != VK_SUCCESS)
+        {
+            spdlog::error("failed to create particle pipeline layout");
+            return;
+        }
+
+        init_createParticleComputePipelines();
+    }
+
+    void VulkanRenderer::init_createParticleComputePipelines()
+    {
+        // Compute pipelines do not depend on the render target : they are only rebuilt when their shaders are reloaded
+        VkPipelineCache pipelineCache = m_vulkanPipelineCache.getVkPipelineCache();
+        m_particleBeginPipeline = std::make_unique<VulkanComputePipeline>(m_vulkanDevice, m_shaderCache.getShaderModule("particle_begin.comp"), m_particlePipelineLayout, pipelineCache);
+        m_particleEmitPipeline = std::make_unique<VulkanComputePipeline>(m_vulkanDevice, m_shaderCache.getShaderModule("particle_emit.comp"), m_particlePipelineLayout, pipelineCache);
+        m_particleSimulatePipeline = std::make_unique<VulkanComputePipeline>(m_vulkanDevice, m_shaderCache.getShaderModule("particle_simulate.comp"), m_particlePipelineLayout, pipelineCache);
+    }
+
     void VulkanRenderer::init_createPipeline()
     {
+        m_pipelineVariants = std::make_unique<VulkanPipelineVariantCache>(m_vulkanDevice, m_shaderCache, m_vulkanPipelineCache.getVkPipelineCache());
+        m_pipelineColorFormat = getRenderTarget().getImageFormat();
+
         VulkanPipeline::PipelineConfigInfo pipelineConfig {};
-        VulkanPipeline::PipelineConfigInfo::defaultConfig(pipelineConfig);
-        pipelineConfig.renderPass = m_vulkanSwapChain->getRenderPass();
-        pipelineConfig.pipelineLayout = m_pipelineLayout;
+        fillMainPassPipelineConfig(pipelineConfig, m_pipelineLayout);
+        m_vulkanPipeline = &m_pipelineVariants->getPipeline("simple.vert", "simple.frag", pipelineConfig);
+
+        // Sprites : instanced quads, alpha blended. They are depth tested against meshes, but do not hide each other.
+        VulkanPipeline::PipelineConfigInfo spritePipelineConfig {};
+        fillMainPassPipelineConfig(spritePipelineConfig, m_pipelineLayout);
+        spritePipelineConfig.bindingDescriptions = VulkanSpriteBatch::getBindingDescriptions();
+        spritePipelineConfig.attributeDescriptions = VulkanSpriteBatch::getAttributeDescriptions();
+        spritePipelineConfig.colorBlendAttachment.blendEnable = VK_TRUE;
+        spritePipelineConfig.colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+        spritePipelineConfig.colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+        spritePipelineConfig.colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+        spritePipelineConfig.colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+        spritePipelineConfig.depthStencilInfo.depthWriteEnable = VK_FALSE;
+        spritePipelineConfig.depthStencilInfo.depthCompareOp = VK_COMPARE_OP_LESS_OR_EQUAL;
+        m_spritePipeline = &m_pipelineVariants->getPipeline("sprite.vert", "sprite.frag", spritePipelineConfig);
+
+        // Particle variants already in use are created now, the others when a system first needs them
+        m_particlePipelines.fill(nullptr);
+        for (const auto& [particleSystemId, particleSystem] : m_particleSystems)
+        {
+            getParticlePipeline(particleSystem->getBlendMode());
+        }
+    }
+
+    void VulkanRenderer::fillMainPassPipelineConfig(VulkanPipeline::PipelineConfigInfo& config, VkPipelineLayout pipelineLayout) const
+    {
+        VulkanPipeline::PipelineConfigInfo::defaultConfig(config);
+        config.renderPass = m_mainPass->getRenderPass();     // VK_NULL_HANDLE with dynamic rendering : formats are used instead
+        config.colorAttachmentFormats = m_mainPass->getColorAttachmentFormats();
+        config.depthAttachmentFormat = m_mainPass->getDepthAttachmentFormat();
+        config.pipelineLayout = pipelineLayout;
+        config.bindingDescriptions = VulkanVertexBuffer::getVertexBindingDescriptions(m_config.vertexLayout);
+        config.attributeDescriptions = VulkanVertexBuffer::getVertexAttributeDescriptions(m_config.vertexLayout);
+    }
+
+    VulkanPipeline& VulkanRenderer::getParticlePipeline(ParticleBlendMode blendMode)
+    {
+        VulkanPipeline*& pipeline = m_particlePipelines[static_cast<size_t>(blendMode)];
+        if (pipeline != nullptr)
+            return *pipeline;
+
+        // Quads generated from the particle buffers. Like sprites, they are depth tested against meshes, but do not hide each other.
+        VulkanPipeline::PipelineConfigInfo config {};
+        fillMainPassPipelineConfig(config, m_particlePipelineLayout);
+        config.bindingDescriptions.clear();
+        config.attributeDescriptions.clear();
+        config.depthStencilInfo.depthWriteEnable = VK_FALSE;
+        config.depthStencilInfo.depthCompareOp = VK_COMPARE_OP_LESS_OR_EQUAL;
+        config.colorBlendAttachment.blendEnable = VK_TRUE;
 
-        m_vulkanPipeline = std::make_unique<vulkan::VulkanPipeline>(m_vulkanDevice, "jate_resources/shaders/simple.vert.spv", "jate_resources/shaders/simple.frag.spv", pipelineConfig);
+        // Specialization constant 0 : PREMULTIPLY_ALPHA in particle.frag
+        switch (blendMode)
+        {
+            case ParticleBlendMode::Alpha:
+                config.colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+                config.colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+                config.colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+                config.colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+                config.specializationConstants = {VK_FALSE};
+                break;
+            case ParticleBlendMode::Additive:
+                // The color is weighted by its alpha in the shader, and added as is : the destination alpha is kept
+                config.colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_ONE;
+                config.colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE;
+                config.colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
+                config.colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+                config.specializationConstants = {VK_TRUE};
+                break;
+        }
+
+        pipeline = &m_pipelineVariants->getPipeline("particle.vert", "particle.frag", config);
+        return *pipeline;
     }
 
     void VulkanRenderer::init_createSyncObjects()
@@ -90,91 +361,602 @@ namespace jate::rendering::vulkan
         VkSemaphoreCreateInfo semaphoreInfo{};
         semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
 
-        VkFenceCreateInfo fenceInfo{};
-        fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-        fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+        m_imageAvailableSemaphores.resize(m_framesInFlight);
+        m_renderFinishedSemaphores.resize(m_framesInFlight);
 
-        m_imageAvailableSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
-        m_renderFinishedSemaphores.resize(MAX_FRAMES_IN_FLIGHT);
-        m_inFlightFences.resize(MAX_FRAMES_IN_FLIGHT);
+        // Value 0 is reached from the start, so the first frames never wait
+        m_frameTimelineValues.assign(m_framesInFlight, 0);
 
-        for (uint8_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+        for (uint8_t i = 0; i < m_framesInFlight; i++)
         {
             if (vkCreateSemaphore(m_vulkanDevice.getVkDevice(), &semaphoreInfo, nullptr, &m_imageAvailableSemaphores[i]) != VK_SUCCESS ||
-                vkCreateSemaphore(m_vulkanDevice.getVkDevice(), &semaphoreInfo, nullptr, &m_renderFinishedSemaphores[i]) != VK_SUCCESS ||
-                vkCreateFence(m_vulkanDevice.getVkDevice(), &fenceInfo, nullptr, &m_inFlightFences[i]) != VK_SUCCESS) {
+                vkCreateSemaphore(m_vulkanDevice.getVkDevice(), &semaphoreInfo, nullptr, &m_renderFinishedSemaphores[i]) != VK_SUCCESS) {
                 spdlog::error("failed to create semaphores at index {}", i);
                 return;
             }
         }
     }
 
-    void VulkanRenderer::recreateSwapChain()
+    void VulkanRenderer::destroySyncObjects()
     {
-        // If one dimension is zero, pause the current thread until both dimensions are positive
-        int width = 0, height = 0;
-        glfwGetFramebufferSize(m_window.getWindowPtr(), &width, &height);
-        while (width == 0 || height == 0) {
-            glfwGetFramebufferSize(m_window.getWindowPtr(), &width, &height);
-            glfwWaitEvents();
+        for (auto imageAvailableSemaphore : m_imageAvailableSemaphores)
+        {
+            vkDestroySemaphore(m_vulkanDevice.getVkDevice(), imageAvailableSemaphore, nullptr);
+        }
+        for (auto renderFinishedSemaphore : m_renderFinishedSemaphores)
+        {
+            vkDestroySemaphore(m_vulkanDevice.getVkDevice(), renderFinishedSemaphore, nullptr);
         }
 
-		// Pause current thread until device is not busy
-		vkDeviceWaitIdle(m_vulkanDevice.getVkDevice());
+        m_imageAvailableSemaphores.clear();
+        m_renderFinishedSemaphores.clear();
+        m_frameTimelineValues.clear();
+    }
+
+    bool VulkanRenderer::recreateSwapChain()
+    {
+        JATE_PROFILE_SCOPE("VulkanRenderer::recreateSwapChain");
+
+        // A swap chain can't have an empty extent. Don't wait for events here : this may not run on the main thread.
+        if (m_window->isMinimized())
+        {
+            m_swapChainNeedsRecreation = true;
+            return false;
+        }
 
-        // Recreate swap chain, and everything that needs the swap chain
-        init_createSwapChain();
+        // No device wait here : the old swap chain is retired, and destroyed once the frames using it are done
+        std::shared_ptr<VulkanSwapChain> oldSwapChain = std::move(m_vulkanSwapChain);
+        m_vulkanSwapChain = std::make_unique<VulkanSwapChain>(*m_window, m_vulkanDevice, toVkPresentMode(m_config.presentMode), m_config.swapChainImageCount, oldSwapChain.get());
+        m_deletionQueue.push([oldSwapChain]() mutable { oldSwapChain.reset(); });
+
+        init_createRenderGraph();
+
+        // Viewport and scissor are dynamic, and render passes with the same formats are compatible :
+        // the pipeline only has to be rebuilt if the color format changed
+        if (m_vulkanSwapChain->getImageFormat() != m_pipelineColorFormat)
+        {
+            rebuildGraphicsPipelines();
+        }
+
+        m_window->resetFrameBufferResizedFlag();
+        m_swapChainNeedsRecreation = false;
+        return true;
+    }
+
+    void VulkanRenderer::applyFramesInFlightChange()
+    {
+        JATE_PROFILE_SCOPE("VulkanRenderer::applyFramesInFlightChange");
+
+        // Every per-frame resource is rebuilt : this is the only case where waiting for the whole device is acceptable
+        vkDeviceWaitIdle(m_vulkanDevice.getVkDevice());
+
+        m_framesInFlight = m_config.framesInFlight;
+        m_currentFrameInFlight = 0;
+        m_framesInFlightChanged = false;
+
+        m_spriteBatch->resize(m_framesInFlight);
+        m_objectBuffer->resize(m_framesInFlight);
+        m_deletionQueue.flushAll();
+        m_gpuProfiler.resize(m_framesInFlight);
+
+        destroySyncObjects();
+        init_createSyncObjects();
         init_createCommandManager();
-        init_createPipeline();
+
+        if (m_config.headless)
+        {
+            // Offscreen images are owned by frames in flight
+            m_hasSubmittedFrame = false;
+            m_offscreenTarget = nullptr;
+            init_createRenderTarget();
+            init_createRenderGraph();
+        }
     }
 
-    void VulkanRenderer::beginFrame()
+    bool VulkanRenderer::rebuildGraphicsPipelines()
     {
-        vkWaitForFences(m_vulkanDevice.getVkDevice(), 1, &m_inFlightFences[m_currentFrameInFlight], VK_TRUE, UINT64_MAX);
-        vkResetFences(m_vulkanDevice.getVkDevice(), 1, &m_inFlightFences[m_currentFrameInFlight]);
+        JATE_PROFILE_SCOPE("VulkanRenderer::rebuildGraphicsPipelines");
+
+        std::unique_ptr<VulkanPipelineVariantCache> oldPipelineVariants = std::move(m_pipelineVariants);
+        VulkanPipeline* oldPipeline = m_vulkanPipeline;
+        VulkanPipeline* oldSpritePipeline = m_spritePipeline;
+        std::array<VulkanPipeline*, 2> oldParticlePipelines = m_particlePipelines;
+        VkFormat oldColorFormat = m_pipelineColorFormat;
 
         try
         {
-            m_currentImageIndex = m_vulkanSwapChain->acquireNextImage(m_imageAvailableSemaphores[m_currentFrameInFlight]);
+            init_createPipeline();
+        }
+        catch (const std::exception& e)
+        {
+            // e.g. a reloaded vertex shader output no longer matches the fragment shader input
+            spdlog::error("Could not rebuild graphics pipelines, keeping the previous ones : {}", e.what());
+            m_pipelineVariants = std::move(oldPipelineVariants);
+            m_vulkanPipeline = oldPipeline;
+            m_spritePipeline = oldSpritePipeline;
+            m_particlePipelines = oldParticlePipelines;
+            m_pipelineColorFormat = oldColorFormat;
+            return false;
+        }
+
+        std::shared_ptr<VulkanPipelineVariantCache> retiredPipelineVariants = std::move(oldPipelineVariants);
+        m_deletionQueue.push([retiredPipelineVariants]() mutable { retiredPipelineVariants.reset(); });
+        return true;
+    }
+
+    void VulkanRenderer::applyShaderReloads()
+    {
+        std::vector<VulkanShaderHotReloader::CompiledShader> shaders = m_shaderHotReloader->takeCompiledShaders();
+        if (shaders.empty())
+            return;
+
+        JATE_PROFILE_SCOPE("VulkanRenderer::applyShaderReloads");
+
+        std::vector<std::string> graphicsShaders;
+        std::vector<std::string> computeShaders;
+        for (const auto& shader : shaders)
+        {
+            try
+            {
+                m_shaderCache.reloadShader(shader.name, shader.code);
+            }
+            catch (const std::exception& e)
+            {
+                spdlog::error("[Shader Hot Reload] {}", e.what());
+                continue;
+            }
+
+            (shader.name.ends_with(".comp") ? computeShaders : graphicsShaders).push_back(shader.name);
+        }
+
+        // New modules are only kept once the pipelines using them are built : otherwise the next rebuild (or new variant) would fail too
+        auto finishReloads = [this](const std::vector<std::string>& names, bool rebuilt) {
+            for (const std::string& name : names)
+            {
+                if (rebuilt)
+                    m_shaderCache.commitReload(name);
+                else
+                    m_shaderCache.revertReload(name);
+            }
+        };
+
+        // Pipelines are cheap to rebuild from the pipeline cache : every pipeline of the changed kind is, except graphics variants
+        // not in use, created again when needed. The previous ones are destroyed once the frames using them are done.
+        if (!graphicsShaders.empty())
+        {
+            bool rebuilt = rebuildGraphicsPipelines();
+            finishReloads(graphicsShaders, rebuilt);
+            if (rebuilt)
+            {
+                spdlog::info("[Shader Hot Reload] Rebuilt graphics pipelines");
+            }
+        }
+
+        if (!computeShaders.empty())
+        {
+            std::unique_ptr<VulkanComputePipeline> oldBeginPipeline = std::move(m_particleBeginPipeline);
+            std::unique_ptr<VulkanComputePipeline> oldEmitPipeline = std::move(m_particleEmitPipeline);
+            std::unique_ptr<VulkanComputePipeline> oldSimulatePipeline = std::move(m_particleSimulatePipeline);
+            try
+            {
+                init_createParticleComputePipelines();
+
+                m_deletionQueue.push([oldBeginPipeline = std::shared_ptr<VulkanComputePipeline>(std::move(oldBeginPipeline)),
+                    oldEmitPipeline = std::shared_ptr<VulkanComputePipeline>(std::move(oldEmitPipeline)),
+                    oldSimulatePipeline = std::shared_ptr<VulkanComputePipeline>(std::move(oldSimulatePipeline))]() mutable {
+                    oldBeginPipeline.reset();
+                    oldEmitPipeline.reset();
+                    oldSimulatePipeline.reset();
+                });
+                finishReloads(computeShaders, true);
+                spdlog::info("[Shader Hot Reload] Rebuilt compute pipelines");
+            }
+            catch (const std::exception& e)
+            {
+                spdlog::error("[Shader Hot Reload] {}, keeping the previous compute pipelines", e.what());
+                m_particleBeginPipeline = std::move(oldBeginPipeline);
+                m_particleEmitPipeline = std::move(oldEmitPipeline);
+                m_particleSimulatePipeline = std::move(oldSimulatePipeline);
+                finishReloads(computeShaders, false);
+            }
+        }
+    }
+
+    void VulkanRenderer::setPresentMode(PresentMode presentMode)
+    {
+        std::lock_guard<std::mutex> lock(m_resourceMutex);
+        if (m_config.presentMode == presentMode) return;
+
+        m_config.presentMode = presentMode;
+        m_swapChainNeedsRecreation = !m_config.headless;
+    }
+
+    void VulkanRenderer::setSwapChainImageCount(uint32_t imageCount)
+    {
+        std::lock_guard<std::mutex> lock(m_resourceMutex);
+        if (m_config.swapChainImageCount == imageCount) return;
+
+        m_config.swapChainImageCount = imageCount;
+        m_swapChainNeedsRecreation = !m_config.headless;
+    }
+
+    void VulkanRenderer::setFramesInFlight(uint8_t framesInFlight)
+    {
+        std::lock_guard<std::mutex> lock(m_resourceMutex);
+        framesInFlight = std::max<uint8_t>(framesInFlight, 1);
+        m_config.framesInFlight = framesInFlight;
+        m_framesInFlightChanged = framesInFlight != m_framesInFlight;
+    }
+
+    void VulkanRenderer::beginFrame()
+    {
+        JATE_PROFILE_SCOPE("VulkanRenderer::beginFrame");
+
+        std::unique_lock<std::mutex> lock(m_resourceMutex);
+
+        if (m_framesInFlightChanged)
+        {
+            applyFramesInFlightChange();
+        }
+
+        {
+            JATE_PROFILE_SCOPE("WaitForFrameTimeline");
+            uint64_t frameReleaseValue = m_frameTimelineValues[m_currentFrameInFlight];
+            lock.unlock();
+            auto waitStart = std::chrono::steady_clock::now();
+            m_vulkanDevice.getGraphicsTimeline().wait(frameReleaseValue);
+
+            if (m_frameStatistics != nullptr)
+            {
+                std::chrono::duration<double, std::milli> waitDuration = std::chrono::steady_clock::now() - waitStart;
+                m_frameStatistics->record(timing::FrameMetric::FenceWait, waitDuration.count());
+            }
+            lock.lock();
+        }
+        m_deletionQueue.collect();
+        m_gpuProfiler.beginFrame(m_currentFrameInFlight);
+
+        if (m_shaderHotReloader != nullptr)
+        {
+            applyShaderReloads();
         }
-        catch(const SwapChainOutOfDateException e)
+
+        // Clamped, so that a long stall (a breakpoint, a window being moved) does not make particles jump
+        auto frameStart = std::chrono::steady_clock::now();
+        std::chrono::duration<float> frameDeltaTime = frameStart - m_lastFrameStart;
+        m_frameDeltaTime = std::min(frameDeltaTime.count(), 0.1f);
+        m_lastFrameStart = frameStart;
+
+        if (m_config.headless)
         {
-            recreateSwapChain();
-            m_window.resetFrameBufferResizedFlag();
-            m_currentImageIndex = m_vulkanSwapChain->acquireNextImage(m_imageAvailableSemaphores[m_currentFrameInFlight]);
+            // Offscreen images are owned by frames in flight, there is nothing to acquire
+            m_currentImageIndex = m_currentFrameInFlight;
+        }
+        else
+        {
+            if (m_swapChainNeedsRecreation && !recreateSwapChain())
+            {
+                m_frameSkipped = true;
+                return;
+            }
+
+            JATE_PROFILE_SCOPE("AcquireNextImage");
+            try
+            {
+                m_currentImageIndex = m_vulkanSwapChain->acquireNextImage(m_imageAvailableSemaphores[m_currentFrameInFlight]);
+            }
+            catch(const SwapChainOutOfDateException& e)
+            {
+                if (!recreateSwapChain())
+                {
+                    m_frameSkipped = true;
+                    return;
+                }
+                m_currentImageIndex = m_vulkanSwapChain->acquireNextImage(m_imageAvailableSemaphores[m_currentFrameInFlight]);
+            }
         }
 
         m_currentFrameCommandBuffer = m_vulkanCommandManager->getMainCommandBuffer(static_cast<size_t>(m_currentFrameInFlight));
 
         m_currentFrameCommandBuffer->startRecording();
-        m_currentFrameCommandBuffer->cmdStartRenderPass(*m_vulkanSwapChain, m_currentImageIndex);
-        m_currentFrameCommandBuffer->cmdBindPipeline(*m_vulkanPipeline);
+        m_currentFrameCommandBuffer->cmdResetProfileQueries(m_gpuProfiler);
+        m_currentFrameCommandBuffer->cmdBeginProfileScope(m_gpuProfiler, "frame");
 
-        auto swapChainExtent = m_vulkanSwapChain->getExtent();
-        m_currentFrameCommandBuffer->cmdSetViewport(0.0f, 0.0f, static_cast<float>(swapChainExtent.width), static_cast<float>(swapChainExtent.height));
-        m_currentFrameCommandBuffer->cmdSetScissor({0, 0}, swapChainExtent);
+        const AVulkanRenderTarget& renderTarget = getRenderTarget();
+        m_renderGraph->setImportedImage(m_colorTarget, renderTarget.getImage(m_currentImageIndex), renderTarget.getImageView(m_currentImageIndex));
+        m_frameDrawCommands.clear();
+        m_frameSpriteInstances.clear();
+        m_frameParticleEmitters.clear();
     }
 
     void VulkanRenderer::endFrame()
     {
-        m_currentFrameCommandBuffer->cmdEndRenderPass();
+        JATE_PROFILE_SCOPE("VulkanRenderer::endFrame");
+
+        std::lock_guard<std::mutex> lock(m_resourceMutex);
+
+        if (m_frameSkipped)
+        {
+            // Same frame in flight next time, nothing was submitted with it
+            m_frameSkipped = false;
+            return;
+        }
+
+        // Meshes allocated since the last frame are copied before any pass draws them
+        if (!m_pendingBufferUploads.empty())
+        {
+            m_currentFrameCommandBuffer->cmdBeginProfileScope(m_gpuProfiler, "buffer_uploads");
+            recordPendingBufferUploads(*m_currentFrameCommandBuffer);
+            m_currentFrameCommandBuffer->cmdEndProfileScope(m_gpuProfiler);
+        }
+
+        // Everything allocated before the callbacks were added is recorded in this frame : they run once it is done
+        for (auto& callback : m_pendingUploadCallbacks)
+        {
+            m_deletionQueue.push(std::move(callback));
+        }
+        m_pendingUploadCallbacks.clear();
+
+        // Textures added since the last frame are uploaded before any pass samples the atlas
+        m_currentFrameCommandBuffer->cmdBeginProfileScope(m_gpuProfiler, "texture_uploads");
+        m_textureAtlas->recordPendingUploads(*m_currentFrameCommandBuffer);
+        m_currentFrameCommandBuffer->cmdEndProfileScope(m_gpuProfiler);
+        m_spriteBatch->upload(m_currentFrameInFlight, m_frameSpriteInstances);
+
+        m_frameObjects.clear();
+        for (const auto& drawCommand : m_frameDrawCommands)
+        {
+            m_frameObjects.push_back({drawCommand.pushConstantData.transform});
+        }
+        m_objectBuffer->upload(m_currentFrameInFlight, m_frameObjects);
+
+        m_frameParticleSystems.clear();
+        for (const auto& [particleSystemId, emitterPosition] : m_frameParticleEmitters)
+        {
+            // Systems destroyed after being drawn this frame are skipped
+            auto particleSystemIt = m_particleSystems.find(particleSystemId);
+            if (particleSystemIt == m_particleSystems.end())
+                continue;
+
+            particleSystemIt->second->prepareFrame(emitterPosition, m_frameDeltaTime, m_particleSeed++);
+            m_frameParticleSystems.push_back(particleSystemIt->second.get());
+        }
+
+        if (!m_frameParticleSystems.empty())
+        {
+            m_currentFrameCommandBuffer->cmdBeginProfileScope(m_gpuProfiler, "particles");
+            recordParticleSimulation(*m_currentFrameCommandBuffer);
+            m_currentFrameCommandBuffer->cmdEndProfileScope(m_gpuProfiler);
+        }
+
+        // Passes, and their barriers, are only recorded now that every draw of the frame is known
+        m_renderGraph->execute(*m_currentFrameCommandBuffer, &m_gpuProfiler);
+        m_currentFrameCommandBuffer->cmdEndProfileScope(m_gpuProfiler);     // frame
         m_currentFrameCommandBuffer->endRecording();
 
-        m_currentFrameCommandBuffer->submit(m_imageAvailableSemaphores[m_currentFrameInFlight], m_renderFinishedSemaphores[m_currentFrameInFlight], m_inFlightFences[m_currentFrameInFlight]);
-        m_currentFrameCommandBuffer->present(*m_vulkanSwapChain, &m_currentImageIndex, m_renderFinishedSemaphores[m_currentFrameInFlight]);
+        VulkanTimelineSemaphore& graphicsTimeline = m_vulkanDevice.getGraphicsTimeline();
+
+        if (m_config.headless)
+        {
+            // Nothing to present : the timeline is enough to know when the image is ready
+            m_frameTimelineValues[m_currentFrameInFlight] = m_currentFrameCommandBuffer->submit(nullptr, nullptr, &graphicsTimeline);
+        }
+        else
+        {
+            m_frameTimelineValues[m_currentFrameInFlight] = m_currentFrameCommandBuffer->submit(
+                m_imageAvailableSemaphores[m_currentFrameInFlight], m_renderFinishedSemaphores[m_currentFrameInFlight], &graphicsTimeline);
+        }
+
+        m_hasSubmittedFrame = true;
+        m_lastSubmittedTimelineValue = m_frameTimelineValues[m_currentFrameInFlight];
+        m_lastSubmittedImageIndex = m_currentImageIndex;
 
-        m_currentFrameInFlight = (m_currentFrameInFlight + 1) % MAX_FRAMES_IN_FLIGHT;
+        if (m_config.headless)
+        {
+            m_currentFrameInFlight = (m_currentFrameInFlight + 1) % m_framesInFlight;
+            return;
+        }
+
+        bool swapChainOutOfDate = m_window->hasBeenResized();
+        auto presentStart = std::chrono::steady_clock::now();
+        try
+        {
+            m_currentFrameCommandBuffer->present(*m_vulkanSwapChain, &m_currentImageIndex, m_renderFinishedSemaphores[m_currentFrameInFlight]);
+        }
+        catch(const SwapChainOutOfDateException& e)
+        {
+            swapChainOutOfDate = true;
+        }
+
+        if (m_frameStatistics != nullptr)
+        {
+            std::chrono::duration<double, std::milli> presentDuration = std::chrono::steady_clock::now() - presentStart;
+            m_frameStatistics->record(timing::FrameMetric::Present, presentDuration.count());
+        }
+
+        if (swapChainOutOfDate)
+        {
+            // Done at the start of the next frame, where a minimized window can be handled by skipping it
+            m_swapChainNeedsRecreation = true;
+        }
+
+        m_currentFrameInFlight = (m_currentFrameInFlight + 1) % m_framesInFlight;
     }
 
-    renderer_memory_slot_id VulkanRenderer::allocateVertexData(const std::vector<VertexData> &vertices)
+    void VulkanRenderer::recordPendingBufferUploads(VulkanCommandBuffer& commandBuffer)
     {
+        for (const auto& upload : m_pendingBufferUploads)
+        {
+            commandBuffer.cmdCopyBuffer(upload.stagingBuffer, upload.dstBuffer, upload.size);
+            m_vulkanDevice.destroyBufferDeferred(upload.stagingBuffer, upload.stagingMemory);
+        }
+        m_pendingBufferUploads.clear();
+
+        // A single barrier for every copy
+        commandBuffer.cmdMemoryBarrier(VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+            VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT);
+    }
+
+    void VulkanRenderer::recordParticleSimulation(VulkanCommandBuffer& commandBuffer)
+    {
+        // Global memory barriers : a single one covers the buffers of every system.
+        // The previous frame may still draw the particles this one overwrites, and its simulation results are read here.
+        commandBuffer.cmdMemoryBarrier(
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+
+        commandBuffer.cmdBindDescriptorSet(m_particlePipelineLayout, m_bindlessDescriptors->getDescriptorSet(), 0, VK_PIPELINE_BIND_POINT_COMPUTE);
+
+        commandBuffer.cmdBindPipeline(*m_particleBeginPipeline);
+        for (const VulkanParticleSystem* particleSystem : m_frameParticleSystems)
+        {
+            particleSystem->cmdBegin(commandBuffer, m_particlePipelineLayout);
+        }
+
+        // The next steps are dispatched with the arguments written by the begin step
+        commandBuffer.cmdMemoryBarrier(VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+
+        commandBuffer.cmdBindPipeline(*m_particleEmitPipeline);
+        for (const VulkanParticleSystem* particleSystem : m_frameParticleSystems)
+        {
+            particleSystem->cmdEmit(commandBuffer, m_particlePipelineLayout);
+        }
+
+        commandBuffer.cmdMemoryBarrier(VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+
+        commandBuffer.cmdBindPipeline(*m_particleSimulatePipeline);
+        for (const VulkanParticleSystem* particleSystem : m_frameParticleSystems)
+        {
+            particleSystem->cmdSimulate(commandBuffer, m_particlePipelineLayout);
+        }
+
+        // The main pass draws as many instances as the simulation left alive
+        commandBuffer.cmdMemoryBarrier(VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
+            VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_SHADER_READ_BIT);
+    }
+
+    bool VulkanRenderer::captureLastFrame(FrameCapture& capture)
+    {
+        std::lock_guard<std::mutex> lock(m_resourceMutex);
+
+        if (!m_config.headless)
+        {
+            spdlog::error("[Vulkan Renderer] Frame capture is only supported in headless mode");
+            return false;
+        }
+
+        if (!m_hasSubmittedFrame)
+        {
+            spdlog::error("[Vulkan Renderer] Cannot capture frame : no frame has been rendered yet");
+            return false;
+        }
+
+        // The image is only reused by its own frame in flight, so waiting on that frame is enough
+        m_vulkanDevice.getGraphicsTimeline().wait(m_lastSubmittedTimelineValue);
+
+        VkExtent2D extent = m_offscreenTarget->getExtent();
+        VkDeviceSize bufferSize = static_cast<VkDeviceSize>(extent.width) * extent.height * 4;
+
+        VkBuffer readbackBuffer;
+        VkDeviceMemory readbackBufferMemory;
+        m_vulkanDevice.createBuffer(bufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+            readbackBuffer, readbackBufferMemory);
+
+        {
+            VulkanCommandBuffer cmdBuffer = m_vulkanCommandManager->createOneShotCommandBuffer();
+            cmdBuffer.startRecording();
+            cmdBuffer.cmdCopyImageToBuffer(m_offscreenTarget->getImage(m_lastSubmittedImageIndex), extent, readbackBuffer);
+            cmdBuffer.endRecording();
+            VulkanTimelineSemaphore& transferTimeline = m_vulkanDevice.getTransferTimeline();
+            transferTimeline.wait(cmdBuffer.submit(nullptr, nullptr, &transferTimeline));
+        }
+
+        capture.width = extent.width;
+        capture.height = extent.height;
+        capture.pixels.resize(static_cast<size_t>(bufferSize));
+
+        void* data;
+        vkMapMemory(m_vulkanDevice.getVkDevice(), readbackBufferMemory, 0, bufferSize, 0, &data);
+        memcpy(capture.pixels.data(), data, static_cast<size_t>(bufferSize));
+        vkUnmapMemory(m_vulkanDevice.getVkDevice(), readbackBufferMemory);
+
+        // The copy has completed, no need to defer the deletion
+        vkDestroyBuffer(m_vulkanDevice.getVkDevice(), readbackBuffer, nullptr);
+        vkFreeMemory(m_vulkanDevice.getVkDevice(), readbackBufferMemory, nullptr);
+
+        return true;
+    }
+
+    std::vector<GpuScopeTiming> VulkanRenderer::getGpuTimings() const
+    {
+        std::lock_guard<std::mutex> lock(m_resourceMutex);
+        return m_gpuProfiler.getTimings();
+    }
+
+    void VulkanRenderer::renderSnapshot(const RenderSnapshot& snapshot)
+    {
+        JATE_PROFILE_SCOPE("VulkanRenderer::renderSnapshot");
+
+        beginFrame();
+        {
+            std::lock_guard<std::mutex> lock(m_resourceMutex);
+            for (const auto& drawCommand : snapshot.drawCommands)
+            {
+                drawIndexed(drawCommand.verticesSlot, drawCommand.indicesSlot, drawCommand.pushConstantData);
+            }
+            for (const auto& spriteCommand : snapshot.spriteCommands)
+            {
+                drawSprite(spriteCommand);
+            }
+            for (const auto& particleCommand : snapshot.particleCommands)
+            {
+                drawParticles(particleCommand);
+            }
+        }
+        endFrame();
+
+        // Buffer destructions are deferred by the deletion queue, until the frame that was just submitted is done
+        std::lock_guard<std::mutex> lock(m_resourceMutex);
+        for (auto slotId : snapshot.freedVertexSlots)
+        {
+            m_vertexBufferSlots.erase(slotId);
+        }
+        for (auto slotId : snapshot.freedIndexSlots)
+        {
+            m_indexBufferSlots.erase(slotId);
+        }
+        for (auto particleSystemId : snapshot.freedParticleSystems)
+        {
+            m_particleSystems.erase(particleSystemId);
+        }
+        for (auto textureId : snapshot.freedTextures)
+        {
+            m_textureAtlas->removeTexture(textureId);
+        }
+    }
+
+    renderer_memory_slot_id VulkanRenderer::allocateVertexData(std::span<const VertexData> vertices)
+    {
+        // Created and filled outside of the lock : allocating a large mesh does not delay frames
+        VulkanBufferUpload upload;
+        auto vertexBuffer = std::make_unique<VulkanVertexBuffer>(m_vulkanDevice, vertices, m_config.vertexLayout, 0, &upload);
+
+        std::lock_guard<std::mutex> lock(m_resourceMutex);
+
         static renderer_memory_slot_id s_nextVertexSlot = 0;
         if (m_vertexBufferSlots.size() > m_vertexBufferSlots.max_size())
         {
+            // Nothing will record the upload : its staging buffer is released here. The vertex buffer releases itself.
+            vkDestroyBuffer(m_vulkanDevice.getVkDevice(), upload.stagingBuffer, nullptr);
+            vkFreeMemory(m_vulkanDevice.getVkDevice(), upload.stagingMemory, nullptr);
             throw std::runtime_error("[Vulkan Renderer] Could not allocate vertex data : no memory slot available");
         }
 
-        auto insertedElementInfo = m_vertexBufferSlots.insert({s_nextVertexSlot, std::make_unique<VulkanVertexBuffer>(m_vulkanDevice, vertices)});
+        auto insertedElementInfo = m_vertexBufferSlots.insert({s_nextVertexSlot, std::move(vertexBuffer)});
+        m_pendingBufferUploads.push_back(upload);
 
         s_nextVertexSlot++;
 
@@ -183,18 +965,28 @@ namespace jate::rendering::vulkan
 
     void VulkanRenderer::freeVertexData(renderer_memory_slot_id slotId)
     {
+        std::lock_guard<std::mutex> lock(m_resourceMutex);
         m_vertexBufferSlots.erase(slotId);
     }
     
-    renderer_memory_slot_id VulkanRenderer::allocateIndexData(const std::vector<uint32_t> &indices)
+    renderer_memory_slot_id VulkanRenderer::allocateIndexData(std::span<const uint32_t> indices)
     {
+        VulkanBufferUpload upload;
+        auto indexBuffer = std::make_unique<VulkanIndexBuffer>(m_vulkanDevice, indices, 0, &upload);
+
+        std::lock_guard<std::mutex> lock(m_resourceMutex);
+
         static renderer_memory_slot_id s_nextIndexSlot = 0;
         if (m_indexBufferSlots.size() > m_indexBufferSlots.max_size())
         {
+            // Nothing will record the upload : its staging buffer is released here. The index buffer releases itself.
+            vkDestroyBuffer(m_vulkanDevice.getVkDevice(), upload.stagingBuffer, nullptr);
+            vkFreeMemory(m_vulkanDevice.getVkDevice(), upload.stagingMemory, nullptr);
             throw std::runtime_error("[Vulkan Renderer] Could not allocate index data : no memory slot available");
         }
 
-        auto insertedElementInfo = m_indexBufferSlots.insert({s_nextIndexSlot, std::make_unique<VulkanIndexBuffer>(m_vulkanDevice, indices)});
+        auto insertedElementInfo = m_indexBufferSlots.insert({s_nextIndexSlot, std::move(indexBuffer)});
+        m_pendingBufferUploads.push_back(upload);
 
         s_nextIndexSlot++;
 
@@ -203,11 +995,21 @@ namespace jate::rendering::vulkan
 
     void VulkanRenderer::freeIndexData(renderer_memory_slot_id slotId)
     {
+        std::lock_guard<std::mutex> lock(m_resourceMutex);
         m_indexBufferSlots.erase(slotId);
     }
 
+    void VulkanRenderer::onUploadsComplete(std::function<void ()> callback)
+    {
+        std::lock_guard<std::mutex> lock(m_resourceMutex);
+        m_pendingUploadCallbacks.push_back(std::move(callback));
+    }
+
     void VulkanRenderer::drawIndexed(renderer_memory_slot_id verticesSlotId, renderer_memory_slot_id indicesSlotId, const PushConstantData &pushConstantData)
     {
+        if (m_frameSkipped)
+            return;
+
         auto vertexBufferIt = m_vertexBufferSlots.find(verticesSlotId);
         if (vertexBufferIt == m_vertexBufferSlots.end())
         {
@@ -222,7 +1024,70 @@ namespace jate::rendering::vulkan
             return;
         }
 
-        m_currentFrameCommandBuffer->cmdPushConstants(pushConstantData, m_pipelineLayout);
-        m_currentFrameCommandBuffer->cmdDrawIndexedVertexBuffer(*(vertexBufferIt->second), *(indexBufferIt->second));
+        m_frameDrawCommands.push_back({verticesSlotId, indicesSlotId, pushConstantData});
+    }
+
+    renderer_texture_id VulkanRenderer::allocateTexture(uint32_t width, uint32_t height, const std::vector<uint8_t>& pixels)
+    {
+        std::lock_guard<std::mutex> lock(m_resourceMutex);
+        return m_textureAtlas->addTexture(width, height, pixels);
+    }
+
+    void VulkanRenderer::freeTexture(renderer_texture_id textureId)
+    {
+        std::lock_guard<std::mutex> lock(m_resourceMutex);
+        m_textureAtlas->removeTexture(textureId);
+    }
+
+    void VulkanRenderer::drawSprite(const SpriteDrawCommand& spriteCommand)
+    {
+        if (m_frameSkipped)
+            return;
+
+        glm::vec4 uvRect;
+        if (!m_textureAtlas->getUvRect(spriteCommand.texture, uvRect))
+        {
+            spdlog::error("[Vulkan Renderer] Drawing sprite with texture {}, but it is not allocated", spriteCommand.texture);
+            return;
+        }
+
+        m_frameSpriteInstances.push_back({spriteCommand.transform, uvRect, spriteCommand.color, m_textureAtlas->getBindlessIndex()});
+    }
+
+    renderer_particle_system_id VulkanRenderer::createParticleSystem(const ParticleEmitterSettings& settings)
+    {
+        std::lock_guard<std::mutex> lock(m_resourceMutex);
+
+        // Created now, rather than while recording the first frame drawing the system.
+        // Also before the system is inserted : if either throws, nothing is left behind, and the id is not taken.
+        getParticlePipeline(settings.blendMode);
+
+        static renderer_particle_system_id s_nextParticleSystem = 0;
+        auto insertedElementInfo = m_particleSystems.insert({s_nextParticleSystem, std::make_unique<VulkanParticleSystem>(m_vulkanDevice, *m_bindlessDescriptors, settings)});
+
+        s_nextParticleSystem++;
+
+        return (insertedElementInfo.first)->first;
+    }
+
+    void VulkanRenderer::destroyParticleSystem(renderer_particle_system_id particleSystemId)
+    {
+        std::lock_guard<std::mutex> lock(m_resourceMutex);
+        m_particleSystems.erase(particleSystemId);
+    }
+
+    void VulkanRenderer::drawParticles(const ParticleDrawCommand& particleCommand)
+    {
+        if (m_frameSkipped)
+            return;
+
+        if (m_particleSystems.find(particleCommand.particleSystem) == m_particleSystems.end())
+        {
+            spdlog::error("[Vulkan Renderer] Drawing particle system {}, but it is not allocated", particleCommand.particleSystem);
+            return;
+        }
+
+        // A system drawn twice in a frame is simulated once, from its last position
+        m_frameParticleEmitters[particleCommand.particleSystem] = particleCommand.emitterPosition;
     }
 }
\ No newline at end of file
@@ -0,0 +1,103 @@
+#include <jate/rendering/vulkan/vulkan_shader_cache.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace jate::rendering::vulkan
+{
+    VulkanShaderCache::VulkanShaderCache(VulkanDevice& device)
+        : m_device(device)
+    {
+    }
+
+    VulkanShaderCache::~VulkanShaderCache()
+    {
+        for (const auto& [name, shaderModule] : m_shaderModules)
+        {
+            vkDestroyShaderModule(m_device.getVkDevice(), shaderModule, nullptr);
+        }
+        for (const auto& [name, shaderModule] : m_replacedModules)
+        {
+            vkDestroyShaderModule(m_device.getVkDevice(), shaderModule, nullptr);
+        }
+    }
+
+    VkShaderModule VulkanShaderCache::getShaderModule(const std::string& name)
+    {
+        auto moduleIt = m_shaderModules.find(name);
+        if (moduleIt != m_shaderModules.end())
+            return moduleIt->second;
+
+        std::span<const EmbeddedShader> shaders = getEmbeddedShaders();
+        auto shaderIt = std::find_if(shaders.begin(), shaders.end(), [&name](const EmbeddedShader& shader) { return shader.name == name; });
+        if (shaderIt == shaders.end())
+        {
+            throw std::runtime_error("[Shader Cache] No embedded shader named " + name);
+        }
+
+        VkShaderModule shaderModule = createShaderModule(name, shaderIt->code);
+        m_shaderModules.emplace(name, shaderModule);
+        return shaderModule;
+    }
+
+    void VulkanShaderCache::reloadShader(const std::string& name, std::span<const uint32_t> code)
+    {
+        VkShaderModule shaderModule = createShaderModule(name, code);
+
+        auto [moduleIt, inserted] = m_shaderModules.try_emplace(name, VK_NULL_HANDLE);
+        auto [replacedIt, firstReload] = m_replacedModules.try_emplace(name, moduleIt->second);
+        if (!firstReload)
+        {
+            // Reloaded again before being committed : the module in between was never used by a pipeline
+            vkDestroyShaderModule(m_device.getVkDevice(), moduleIt->second, nullptr);
+        }
+        moduleIt->second = shaderModule;
+    }
+
+    void VulkanShaderCache::commitReload(const std::string& name)
+    {
+        auto replacedIt = m_replacedModules.find(name);
+        if (replacedIt == m_replacedModules.end())
+            return;
+
+        // Pipelines do not need their modules once created : the previous one can go right away
+        vkDestroyShaderModule(m_device.getVkDevice(), replacedIt->second, nullptr);
+        m_replacedModules.erase(replacedIt);
+    }
+
+    void VulkanShaderCache::revertReload(const std::string& name)
+    {
+        auto replacedIt = m_replacedModules.find(name);
+        if (replacedIt == m_replacedModules.end())
+            return;
+
+        auto moduleIt = m_shaderModules.find(name);
+        vkDestroyShaderModule(m_device.getVkDevice(), moduleIt->second, nullptr);
+        if (replacedIt->second == VK_NULL_HANDLE)
+        {
+            // Created again from the embedded code when next needed
+            m_shaderModules.erase(moduleIt);
+        }
+        else
+        {
+            moduleIt->second = replacedIt->second;
+        }
+        m_replacedModules.erase(replacedIt);
+    }
+
+    VkShaderModule VulkanShaderCache::createShaderModule(const std::string& name, std::span<const uint32_t> code) const
+    {
+        VkShaderModuleCreateInfo createInfo{};
+        createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+        createInfo.codeSize = code.size_bytes();
+        createInfo.pCode = code.data();
+
+        VkShaderModule shaderModule;
+        if (vkCreateShaderModule(m_device.getVkDevice(), &createInfo, nullptr, &shaderModule) != VK_SUCCESS)
+        {
+            throw std::runtime_error("[Shader Cache] Failed to create shader module " + name);
+        }
+
+        return shaderModule;
+    }
+}
\ No newline at end of file
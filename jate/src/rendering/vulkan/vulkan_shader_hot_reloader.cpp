@@ -0,0 +1,233 @@
+#include <jate/rendering/vulkan/vulkan_shader_hot_reloader.h>
+
+#include <jate/profiling/cpu_profiler.h>
+
+#include <spdlog/spdlog.h>
+#include <array>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <sstream>
+#include <utility>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace jate::rendering::vulkan
+{
+    VulkanShaderHotReloader::VulkanShaderHotReloader(const std::string& sourceDirectory, const std::string& glslcPath)
+        : m_sourceDirectory(sourceDirectory), m_glslcPath(glslcPath)
+    {
+        std::error_code error;
+        m_outputDirectory = std::filesystem::temp_directory_path(error) / "jate_shaders";
+        std::filesystem::create_directories(m_outputDirectory, error);
+
+#ifdef __linux__
+        // Editors either rewrite the file, or write a copy and rename it over the original
+        m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (m_inotifyFd < 0 || inotify_add_watch(m_inotifyFd, m_sourceDirectory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0)
+        {
+            spdlog::error("[Shader Hot Reload] Could not watch {}", sourceDirectory);
+            return;
+        }
+#else
+        for (const auto& entry : std::filesystem::directory_iterator(m_sourceDirectory, error))
+        {
+            m_writeTimes[entry.path().filename().string()] = entry.last_write_time(error);
+        }
+        if (error)
+        {
+            spdlog::error("[Shader Hot Reload] Could not watch {}", sourceDirectory);
+            return;
+        }
+#endif
+
+        spdlog::info("[Shader Hot Reload] Watching {}", sourceDirectory);
+        m_thread = std::thread(&VulkanShaderHotReloader::watchLoop, this);
+    }
+
+    VulkanShaderHotReloader::~VulkanShaderHotReloader()
+    {
+        m_stopping = true;
+        if (m_thread.joinable())
+        {
+            m_thread.join();
+        }
+
+#ifdef __linux__
+        if (m_inotifyFd >= 0)
+        {
+            close(m_inotifyFd);
+        }
+#endif
+    }
+
+    std::vector<VulkanShaderHotReloader::CompiledShader> VulkanShaderHotReloader::takeCompiledShaders()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return std::exchange(m_compiledShaders, {});
+    }
+
+    void VulkanShaderHotReloader::watchLoop()
+    {
+        while (!m_stopping)
+        {
+            std::vector<std::string> changedFiles = waitForChanges();
+
+            for (const std::string& name : findShadersToCompile(changedFiles))
+            {
+                std::optional<CompiledShader> shader = compile(name);
+                if (!shader.has_value())
+                    continue;
+
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_compiledShaders.push_back(std::move(shader.value()));
+            }
+        }
+    }
+
+#ifdef __linux__
+    std::vector<std::string> VulkanShaderHotReloader::waitForChanges()
+    {
+        std::set<std::string> changedFiles;
+        while (!m_stopping)
+        {
+            // Once something changed, wait for events to settle : a single save can produce several of them
+            std::chrono::milliseconds timeout = changedFiles.empty() ? ms_POLL_INTERVAL : ms_SETTLE_DELAY;
+            pollfd pollInfo{m_inotifyFd, POLLIN, 0};
+            if (poll(&pollInfo, 1, static_cast<int>(timeout.count())) <= 0)
+            {
+                if (!changedFiles.empty())
+                    break;
+                continue;
+            }
+
+            alignas(inotify_event) std::array<char, 4096> buffer;
+            ssize_t length = read(m_inotifyFd, buffer.data(), buffer.size());
+            for (ssize_t offset = 0; offset < length; )
+            {
+                const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer.data() + offset);
+                if (event->len > 0 && isShaderSource(event->name))
+                {
+                    changedFiles.insert(event->name);
+                }
+                offset += sizeof(inotify_event) + event->len;
+            }
+        }
+
+        return {changedFiles.begin(), changedFiles.end()};
+    }
+#else
+    std::vector<std::string> VulkanShaderHotReloader::waitForChanges()
+    {
+        // No change notification API is used here : write times are polled instead
+        std::vector<std::string> changedFiles;
+        while (!m_stopping && changedFiles.empty())
+        {
+            std::this_thread::sleep_for(ms_POLL_INTERVAL);
+
+            std::error_code error;
+            for (const auto& entry : std::filesystem::directory_iterator(m_sourceDirectory, error))
+            {
+                std::string name = entry.path().filename().string();
+                std::filesystem::file_time_type writeTime = entry.last_write_time(error);
+                auto [writeTimeIt, inserted] = m_writeTimes.try_emplace(name, writeTime);
+                if (inserted || writeTimeIt->second != writeTime)
+                {
+                    writeTimeIt->second = writeTime;
+                    if (isShaderSource(entry.path()))
+                    {
+                        changedFiles.push_back(name);
+                    }
+                }
+            }
+        }
+
+        if (!changedFiles.empty())
+        {
+            std::this_thread::sleep_for(ms_SETTLE_DELAY);
+        }
+        return changedFiles;
+    }
+#endif
+
+    std::vector<std::string> VulkanShaderHotReloader::findShadersToCompile(const std::vector<std::string>& changedFiles) const
+    {
+        std::set<std::string> shaders;
+        for (const std::string& name : changedFiles)
+        {
+            if (std::filesystem::path(name).extension() != ".glsl")
+            {
+                shaders.insert(name);
+                continue;
+            }
+
+            // Includes are not compiled on their own : every shader naming this one is
+            std::error_code error;
+            for (const auto& entry : std::filesystem::directory_iterator(m_sourceDirectory, error))
+            {
+                if (!isShaderSource(entry.path()) || entry.path().extension() == ".glsl")
+                    continue;
+
+                std::ifstream file(entry.path());
+                std::string source{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+                if (source.find("\"" + name + "\"") != std::string::npos)
+                {
+                    shaders.insert(entry.path().filename().string());
+                }
+            }
+        }
+
+        return {shaders.begin(), shaders.end()};
+    }
+
+    std::optional<VulkanShaderHotReloader::CompiledShader> VulkanShaderHotReloader::compile(const std::string& name) const
+    {
+        JATE_PROFILE_SCOPE("VulkanShaderHotReloader::compile");
+
+        std::filesystem::path sourcePath = m_sourceDirectory / name;
+        std::filesystem::path outputPath = m_outputDirectory / (name + ".spv");
+
+        std::ostringstream command;
+        command << "\"" << m_glslcPath << "\" -o \"" << outputPath.string() << "\" \"" << sourcePath.string() << "\"";
+        std::string commandLine = command.str();
+#ifdef _WIN32
+        // cmd.exe strips the outer quotes of a command line starting with one
+        commandLine = "\"" + commandLine + "\"";
+#endif
+
+        if (std::system(commandLine.c_str()) != 0)
+        {
+            spdlog::error("[Shader Hot Reload] Could not compile {}, keeping the previous version", name);
+            return std::nullopt;
+        }
+
+        std::ifstream file(outputPath, std::ios::ate | std::ios::binary);
+        size_t fileSize = file.is_open() ? static_cast<size_t>(file.tellg()) : 0;
+        if (fileSize == 0 || fileSize % sizeof(uint32_t) != 0)
+        {
+            spdlog::error("[Shader Hot Reload] Could not read the SPIR-V code of {}", name);
+            return std::nullopt;
+        }
+
+        CompiledShader shader{name, std::vector<uint32_t>(fileSize / sizeof(uint32_t))};
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(shader.code.data()), fileSize);
+
+        spdlog::info("[Shader Hot Reload] Recompiled {}", name);
+        return shader;
+    }
+
+    bool VulkanShaderHotReloader::isShaderSource(const std::filesystem::path& path)
+    {
+        // The shaders compiled by jate/CMakeLists.txt, and their includes
+        static const std::set<std::string> s_extensions = {
+            ".vert", ".frag", ".comp", ".geom", ".tesc", ".tese", ".mesh", ".task", ".rgen", ".rchit", ".rmiss", ".glsl"
+        };
+        return s_extensions.contains(path.extension().string());
+    }
+}
\ No newline at end of file
@@ -0,0 +1,109 @@
+#include <jate/rendering/vulkan/vulkan_sprite_batch.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace jate::rendering::vulkan
+{
+    VulkanSpriteBatch::VulkanSpriteBatch(VulkanDevice& device, uint8_t framesInFlight)
+        : m_device(device)
+    {
+        m_instanceBuffers.resize(framesInFlight);
+    }
+
+    VulkanSpriteBatch::~VulkanSpriteBatch()
+    {
+        for (auto& instanceBuffer : m_instanceBuffers)
+        {
+            releaseInstanceBuffer(instanceBuffer);
+        }
+    }
+
+    void VulkanSpriteBatch::releaseInstanceBuffer(InstanceBuffer& instanceBuffer)
+    {
+        if (instanceBuffer.buffer == VK_NULL_HANDLE)
+            return;
+
+        // Freeing the memory unmaps it. Frames still in flight may read the buffer, so the release is deferred.
+        m_device.destroyBufferDeferred(instanceBuffer.buffer, instanceBuffer.memory);
+        instanceBuffer = {};
+    }
+
+    void VulkanSpriteBatch::resize(uint8_t framesInFlight)
+    {
+        for (auto& instanceBuffer : m_instanceBuffers)
+        {
+            releaseInstanceBuffer(instanceBuffer);
+        }
+        m_instanceBuffers.clear();
+        m_instanceBuffers.resize(framesInFlight);
+    }
+
+    void VulkanSpriteBatch::upload(uint8_t frameInFlight, std::vector<SpriteInstanceData>& instances)
+    {
+        InstanceBuffer& instanceBuffer = m_instanceBuffers[frameInFlight];
+        instanceBuffer.count = 0;
+        if (instances.empty())
+            return;
+
+        // Farther sprites first (greater depth), so that blending sees what is behind. Stable, so that equal depths keep their draw order.
+        std::stable_sort(instances.begin(), instances.end(), [](const SpriteInstanceData& a, const SpriteInstanceData& b) {
+            return a.transform[3][2] > b.transform[3][2];
+        });
+
+        uint32_t instanceCount = static_cast<uint32_t>(instances.size());
+        if (instanceCount > instanceBuffer.capacity)
+        {
+            uint32_t capacity = std::max({instanceCount, instanceBuffer.capacity * 2, ms_MIN_CAPACITY});
+            releaseInstanceBuffer(instanceBuffer);
+
+            VkDeviceSize bufferSize = sizeof(SpriteInstanceData) * capacity;
+            m_device.createBuffer(bufferSize, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                instanceBuffer.buffer, instanceBuffer.memory);
+            vkMapMemory(m_device.getVkDevice(), instanceBuffer.memory, 0, bufferSize, 0, &instanceBuffer.mappedData);
+            instanceBuffer.capacity = capacity;
+        }
+
+        // Host coherent : the writes are visible to the GPU once the frame is submitted
+        memcpy(instanceBuffer.mappedData, instances.data(), sizeof(SpriteInstanceData) * instanceCount);
+        instanceBuffer.count = instanceCount;
+    }
+
+    void VulkanSpriteBatch::cmdDraw(VulkanCommandBuffer& commandBuffer, uint8_t frameInFlight) const
+    {
+        const InstanceBuffer& instanceBuffer = m_instanceBuffers[frameInFlight];
+        if (instanceBuffer.count == 0)
+            return;
+
+        // The quad corners are generated by the vertex shader : only the instance buffer is bound
+        commandBuffer.cmdBindVertexBuffer(instanceBuffer.buffer);
+        commandBuffer.cmdDraw(6, instanceBuffer.count);
+    }
+
+    std::vector<VkVertexInputBindingDescription> VulkanSpriteBatch::getBindingDescriptions()
+    {
+        std::vector<VkVertexInputBindingDescription> bindingDescriptions(1);
+        bindingDescriptions[0].binding = 0;
+        bindingDescriptions[0].inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
+        bindingDescriptions[0].stride = sizeof(SpriteInstanceData);
+        return bindingDescriptions;
+    }
+
+    std::vector<VkVertexInputAttributeDescription> VulkanSpriteBatch::getAttributeDescriptions()
+    {
+        std::vector<VkVertexInputAttributeDescription> attributeDescriptions;
+
+        // Transform : a mat4 takes one location per column
+        for (uint32_t column = 0; column < 4; column++)
+        {
+            attributeDescriptions.push_back({column, 0, VK_FORMAT_R32G32B32A32_SFLOAT, static_cast<uint32_t>(offsetof(SpriteInstanceData, transform) + sizeof(glm::vec4) * column)});
+        }
+
+        attributeDescriptions.push_back({4, 0, VK_FORMAT_R32G32B32A32_SFLOAT, static_cast<uint32_t>(offsetof(SpriteInstanceData, uvRect))});
+        attributeDescriptions.push_back({5, 0, VK_FORMAT_R32G32B32A32_SFLOAT, static_cast<uint32_t>(offsetof(SpriteInstanceData, color))});
+        attributeDescriptions.push_back({6, 0, VK_FORMAT_R32_UINT, static_cast<uint32_t>(offsetof(SpriteInstanceData, textureIndex))});
+
+        return attributeDescriptions;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,301 @@
+#include <jate/rendering/vulkan/vulkan_texture_atlas.h>
+
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+namespace jate::rendering::vulkan
+{
+    // Mip levels are generated with linear blits : without format support, only the base level is kept
+    static uint32_t computeMipLevels(VulkanDevice& device, VkFormat format, uint32_t size, uint32_t maxMipLevels)
+    {
+        VkFormatProperties properties;
+        vkGetPhysicalDeviceFormatProperties(device.getPhysicalDevice(), format, &properties);
+
+        const VkFormatFeatureFlags blitFeatures = VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
+        if ((properties.optimalTilingFeatures & blitFeatures) != blitFeatures)
+        {
+            spdlog::warn("[Texture Atlas] Linear blits are not supported for the atlas format, mipmaps are disabled");
+            return 1;
+        }
+
+        uint32_t mipLevels = 1;
+        while (mipLevels < maxMipLevels && (size >> mipLevels) > 0)
+        {
+            mipLevels++;
+        }
+        return mipLevels;
+    }
+
+    VulkanTextureAtlas::VulkanTextureAtlas(VulkanDevice& device, VulkanBindlessDescriptors& bindlessDescriptors, uint32_t size)
+        : m_device(device), m_bindlessDescriptors(bindlessDescriptors), m_size(size),
+          m_mipLevels(computeMipLevels(device, ms_FORMAT, size, ms_MAX_MIP_LEVELS)),
+          m_packer(size, size, 1u << (m_mipLevels - 1))     // Cells stay whole texels down to the smallest mip level
+    {
+        init_createImage();
+        init_createSampler();
+
+        // The atlas never changes image nor layout between frames : the descriptor is written once
+        m_bindlessIndex = m_bindlessDescriptors.addTexture(m_imageView, m_sampler);
+    }
+
+    VulkanTextureAtlas::~VulkanTextureAtlas()
+    {
+        VkDevice device = m_device.getVkDevice();
+
+        m_bindlessDescriptors.removeTexture(m_bindlessIndex);
+        vkDestroySampler(device, m_sampler, nullptr);
+        vkDestroyImageView(device, m_imageView, nullptr);
+        vkDestroyImage(device, m_image, nullptr);
+        vkFreeMemory(device, m_imageMemory, nullptr);
+    }
+
+    void VulkanTextureAtlas::init_createImage()
+    {
+        VkImageCreateInfo imageInfo{};
+        imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageInfo.extent = {m_size, m_size, 1};
+        imageInfo.mipLevels = m_mipLevels;
+        imageInfo.arrayLayers = 1;
+        imageInfo.format = ms_FORMAT;
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        imageInfo.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+        imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        m_device.createImageWithInfo(imageInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_image, m_imageMemory);
+
+        VkImageViewCreateInfo viewInfo{};
+        viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.image = m_image;
+        viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        viewInfo.format = ms_FORMAT;
+        viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        viewInfo.subresourceRange.baseMipLevel = 0;
+        viewInfo.subresourceRange.levelCount = m_mipLevels;
+        viewInfo.subresourceRange.baseArrayLayer = 0;
+        viewInfo.subresourceRange.layerCount = 1;
+
+        if (vkCreateImageView(m_device.getVkDevice(), &viewInfo, nullptr, &m_imageView) != VK_SUCCESS)
+        {
+            throw std::runtime_error("[Texture Atlas] Failed to create atlas image view");
+        }
+    }
+
+    void VulkanTextureAtlas::init_createSampler()
+    {
+        VkSamplerCreateInfo samplerInfo{};
+        samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        samplerInfo.magFilter = VK_FILTER_LINEAR;
+        samplerInfo.minFilter = VK_FILTER_LINEAR;
+        samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+        samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.mipLodBias = 0.0f;
+        samplerInfo.anisotropyEnable = VK_FALSE;
+        samplerInfo.maxAnisotropy = 1.0f;
+        samplerInfo.compareEnable = VK_FALSE;
+        samplerInfo.minLod = 0.0f;
+        samplerInfo.maxLod = static_cast<float>(m_mipLevels);
+        samplerInfo.borderColor = VK_BORDER_COLOR_INT_TRANSPARENT_BLACK;
+        samplerInfo.unnormalizedCoordinates = VK_FALSE;
+
+        if (vkCreateSampler(m_device.getVkDevice(), &samplerInfo, nullptr, &m_sampler) != VK_SUCCESS)
+        {
+            throw std::runtime_error("[Texture Atlas] Failed to create atlas sampler");
+        }
+    }
+
+    renderer_texture_id VulkanTextureAtlas::addTexture(uint32_t width, uint32_t height, const std::vector<uint8_t>& pixels)
+    {
+        if (width == 0 || height == 0 || pixels.size() < static_cast<size_t>(width) * height * 4)
+        {
+            throw std::runtime_error("[Texture Atlas] Texture pixels do not match its size");
+        }
+
+        std::optional<AtlasRegion> cell = m_packer.allocate(width + 2 * ms_BORDER, height + 2 * ms_BORDER);
+        if (!cell.has_value())
+        {
+            throw std::runtime_error("[Texture Atlas] No space left for a " + std::to_string(width) + "x" + std::to_string(height) + " texture");
+        }
+
+        Texture texture{};
+        texture.cell = cell.value();
+        texture.content = {cell->x + ms_BORDER, cell->y + ms_BORDER, width, height};
+
+        // The whole cell is uploaded, edge texels being repeated over the border and the padding
+        PendingUpload upload{};
+        upload.cell = texture.cell;
+        upload.pixels.resize(static_cast<size_t>(texture.cell.width) * texture.cell.height * 4);
+        for (uint32_t y = 0; y < texture.cell.height; y++)
+        {
+            uint32_t sourceY = std::min(y > ms_BORDER ? y - ms_BORDER : 0, height - 1);
+            for (uint32_t x = 0; x < texture.cell.width; x++)
+            {
+                uint32_t sourceX = std::min(x > ms_BORDER ? x - ms_BORDER : 0, width - 1);
+                memcpy(&upload.pixels[(static_cast<size_t>(y) * texture.cell.width + x) * 4], &pixels[(static_cast<size_t>(sourceY) * width + sourceX) * 4], 4);
+            }
+        }
+        m_pendingUploads.push_back(std::move(upload));
+
+        renderer_texture_id textureId = m_nextTextureId++;
+        m_textures.insert({textureId, texture});
+        return textureId;
+    }
+
+    void VulkanTextureAtlas::removeTexture(renderer_texture_id textureId)
+    {
+        auto textureIt = m_textures.find(textureId);
+        if (textureIt == m_textures.end())
+        {
+            spdlog::error("[Texture Atlas] Removing texture {}, which does not exist", textureId);
+            return;
+        }
+
+        const AtlasRegion& cell = textureIt->second.cell;
+        std::erase_if(m_pendingUploads, [&cell](const PendingUpload& upload) { return upload.cell.x == cell.x && upload.cell.y == cell.y; });
+
+        m_packer.free(cell);
+        m_textures.erase(textureIt);
+    }
+
+    bool VulkanTextureAtlas::getUvRect(renderer_texture_id textureId, glm::vec4& uvRect) const
+    {
+        auto textureIt = m_textures.find(textureId);
+        if (textureIt == m_textures.end())
+            return false;
+
+        const AtlasRegion& content = textureIt->second.content;
+        float size = static_cast<float>(m_size);
+        uvRect = {content.x / size, content.y / size, (content.x + content.width) / size, (content.y + content.height) / size};
+        return true;
+    }
+
+    VkImageMemoryBarrier VulkanTextureAtlas::createImageBarrier(uint32_t baseMipLevel, uint32_t levelCount,
+        VkImageLayout oldLayout, VkImageLayout newLayout, VkAccessFlags srcAccess, VkAccessFlags dstAccess) const
+    {
+        VkImageMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.srcAccessMask = srcAccess;
+        barrier.dstAccessMask = dstAccess;
+        barrier.oldLayout = oldLayout;
+        barrier.newLayout = newLayout;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = m_image;
+        barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        barrier.subresourceRange.baseMipLevel = baseMipLevel;
+        barrier.subresourceRange.levelCount = levelCount;
+        barrier.subresourceRange.baseArrayLayer = 0;
+        barrier.subresourceRange.layerCount = 1;
+        return barrier;
+    }
+
+    void VulkanTextureAtlas::recordPendingUploads(VulkanCommandBuffer& commandBuffer)
+    {
+        if (m_pendingUploads.empty())
+        {
+            if (!m_layoutInitialized)
+            {
+                // Nothing uploaded yet : the atlas content is undefined, but it must be in a layout it can be sampled in
+                commandBuffer.cmdPipelineBarrier(VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, {
+                    createImageBarrier(0, m_mipLevels, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 0, VK_ACCESS_SHADER_READ_BIT)
+                });
+                m_layoutInitialized = true;
+            }
+            return;
+        }
+
+        // Every upload of the frame shares one staging buffer, released once the frame is done
+        VkDeviceSize stagingSize = 0;
+        for (const auto& upload : m_pendingUploads)
+        {
+            stagingSize += upload.pixels.size();
+        }
+
+        VkBuffer stagingBuffer;
+        VkDeviceMemory stagingMemory;
+        m_device.createBuffer(stagingSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+            stagingBuffer, stagingMemory);
+
+        std::vector<VkBufferImageCopy> copyRegions;
+        copyRegions.reserve(m_pendingUploads.size());
+
+        void* stagingData;
+        vkMapMemory(m_device.getVkDevice(), stagingMemory, 0, stagingSize, 0, &stagingData);
+        VkDeviceSize offset = 0;
+        for (const auto& upload : m_pendingUploads)
+        {
+            memcpy(static_cast<uint8_t*>(stagingData) + offset, upload.pixels.data(), upload.pixels.size());
+
+            VkBufferImageCopy copyRegion{};
+            copyRegion.bufferOffset = offset;
+            copyRegion.bufferRowLength = 0;     // Tightly packed
+            copyRegion.bufferImageHeight = 0;
+            copyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            copyRegion.imageSubresource.mipLevel = 0;
+            copyRegion.imageSubresource.baseArrayLayer = 0;
+            copyRegion.imageSubresource.layerCount = 1;
+            copyRegion.imageOffset = {static_cast<int32_t>(upload.cell.x), static_cast<int32_t>(upload.cell.y), 0};
+            copyRegion.imageExtent = {upload.cell.width, upload.cell.height, 1};
+            copyRegions.push_back(copyRegion);
+
+            offset += upload.pixels.size();
+        }
+        vkUnmapMemory(m_device.getVkDevice(), stagingMemory);
+
+        // Earlier frames may still sample the atlas : wait for their fragment shaders before overwriting it
+        VkImageLayout currentLayout = m_layoutInitialized ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_UNDEFINED;
+        commandBuffer.cmdPipelineBarrier(VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, {
+            createImageBarrier(0, m_mipLevels, currentLayout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 0, VK_ACCESS_TRANSFER_WRITE_BIT)
+        });
+
+        commandBuffer.cmdCopyBufferToImage(stagingBuffer, m_image, copyRegions);
+
+        // Each level is downsampled from the previous one, only over the uploaded cells
+        for (uint32_t level = 1; level < m_mipLevels; level++)
+        {
+            commandBuffer.cmdPipelineBarrier(VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, {
+                createImageBarrier(level - 1, 1, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT)
+            });
+
+            std::vector<VkImageBlit> blits;
+            blits.reserve(m_pendingUploads.size());
+            for (const auto& upload : m_pendingUploads)
+            {
+                const AtlasRegion& cell = upload.cell;
+
+                VkImageBlit blit{};
+                blit.srcSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, level - 1, 0, 1};
+                blit.srcOffsets[0] = {static_cast<int32_t>(cell.x >> (level - 1)), static_cast<int32_t>(cell.y >> (level - 1)), 0};
+                blit.srcOffsets[1] = {static_cast<int32_t>((cell.x + cell.width) >> (level - 1)), static_cast<int32_t>((cell.y + cell.height) >> (level - 1)), 1};
+                blit.dstSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, level, 0, 1};
+                blit.dstOffsets[0] = {static_cast<int32_t>(cell.x >> level), static_cast<int32_t>(cell.y >> level), 0};
+                blit.dstOffsets[1] = {static_cast<int32_t>((cell.x + cell.width) >> level), static_cast<int32_t>((cell.y + cell.height) >> level), 1};
+                blits.push_back(blit);
+            }
+
+            commandBuffer.cmdBlitImage(m_image, m_image, blits, VK_FILTER_LINEAR);
+        }
+
+        // Downsampled levels are in TRANSFER_SRC, the last one is still in TRANSFER_DST
+        std::vector<VkImageMemoryBarrier> readBarriers;
+        if (m_mipLevels > 1)
+        {
+            readBarriers.push_back(createImageBarrier(0, m_mipLevels - 1, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 0, VK_ACCESS_SHADER_READ_BIT));
+        }
+        readBarriers.push_back(createImageBarrier(m_mipLevels - 1, 1, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT));
+        commandBuffer.cmdPipelineBarrier(VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, readBarriers);
+
+        // Tagged with the frame being recorded : released once it has completed
+        m_device.destroyBufferDeferred(stagingBuffer, stagingMemory);
+
+        m_pendingUploads.clear();
+        m_layoutInitialized = true;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,47 @@
+#include <jate/rendering/vulkan/vulkan_timeline_semaphore.h>
+
+#include <stdexcept>
+
+namespace jate::rendering::vulkan
+{
+    VulkanTimelineSemaphore::VulkanTimelineSemaphore(VkDevice device)
+        : m_device(device)
+    {
+        VkSemaphoreTypeCreateInfo typeInfo{};
+        typeInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+        typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+        typeInfo.initialValue = 0;
+
+        VkSemaphoreCreateInfo semaphoreInfo{};
+        semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        semaphoreInfo.pNext = &typeInfo;
+
+        if (vkCreateSemaphore(m_device, &semaphoreInfo, nullptr, &m_semaphore) != VK_SUCCESS)
+        {
+            throw std::runtime_error("Failed to create timeline semaphore");
+        }
+    }
+
+    VulkanTimelineSemaphore::~VulkanTimelineSemaphore()
+    {
+        vkDestroySemaphore(m_device, m_semaphore, nullptr);
+    }
+
+    uint64_t VulkanTimelineSemaphore::getCompletedValue() const
+    {
+        uint64_t value = 0;
+        vkGetSemaphoreCounterValue(m_device, m_semaphore, &value);
+        return value;
+    }
+
+    bool VulkanTimelineSemaphore::wait(uint64_t value, uint64_t timeout) const
+    {
+        VkSemaphoreWaitInfo waitInfo{};
+        waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+        waitInfo.semaphoreCount = 1;
+        waitInfo.pSemaphores = &m_semaphore;
+        waitInfo.pValues = &value;
+
+        return vkWaitSemaphores(m_device, &waitInfo, timeout) == VK_SUCCESS;
+    }
+}
\ No newline at end of file
@@ -1,11 +1,12 @@
 #include <jate/systems/render_system.h>
 
 #include <jate/utils/utils.h>
+#include <jate/profiling/cpu_profiler.h>
 
 namespace jate::systems
 {
-    RenderSystem::RenderSystem(rendering::ARenderer* renderer)
-        : m_renderer(renderer)
+    RenderSystem::RenderSystem(rendering::ARenderer* renderer, rendering::RenderSnapshot* snapshot)
+        : m_renderer(renderer), m_snapshot(snapshot)
     {
     }
 
@@ -23,16 +24,18 @@ namespace jate::systems
         auto componentIt = m_renderUnitComponents.find(component->getComponentId());
         if (componentIt != m_renderUnitComponents.end())
         {
-            componentIt->second->free(m_renderer);
+            componentIt->second->free(*m_snapshot);
             m_renderUnitComponents.erase(componentIt);
         }
     }
 
-    void RenderSystem::tick()
+    void RenderSystem::tick(float interpolationAlpha)
     {
+        JATE_PROFILE_SCOPE("RenderSystem::tick");
+
         for (const auto& renderUnit : m_renderUnitComponents)
         {
-            renderUnit.second->draw(m_renderer);
+            renderUnit.second->draw(m_renderer, *m_snapshot, interpolationAlpha);
         }
     }
 }
\ No newline at end of file
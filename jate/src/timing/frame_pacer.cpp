@@ -0,0 +1,65 @@
+#include <jate/timing/frame_pacer.h>
+
+#include <thread>
+
+namespace jate::timing
+{
+    FramePacer::FramePacer(double targetFrameRate)
+    {
+        setTargetFrameRate(targetFrameRate);
+    }
+
+    void FramePacer::setTargetFrameRate(double targetFrameRate)
+    {
+        m_targetFrameRate = targetFrameRate > 0.0 ? targetFrameRate : 0.0;
+        m_hasNextFrameTime = false;
+
+        if (isEnabled())
+        {
+            m_framePeriod = std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(1.0 / m_targetFrameRate));
+        }
+    }
+
+    void FramePacer::waitForNextFrame()
+    {
+        if (!isEnabled()) return;
+
+        clock::time_point now = clock::now();
+        if (!m_hasNextFrameTime)
+        {
+            m_nextFrameTime = now + m_framePeriod;
+            m_hasNextFrameTime = true;
+            return;
+        }
+
+        if (now < m_nextFrameTime)
+        {
+            while (m_nextFrameTime - now > m_spinThreshold)
+            {
+                clock::duration waitDuration = m_nextFrameTime - now - m_spinThreshold;
+                if (m_waitFunction)
+                {
+                    m_waitFunction(waitDuration);
+                }
+                else
+                {
+                    std::this_thread::sleep_for(waitDuration);
+                }
+                now = clock::now();
+            }
+
+            while (clock::now() < m_nextFrameTime)
+            {
+                std::this_thread::yield();
+            }
+
+            // Schedule from the deadline rather than from now, so that wake-up jitter does not accumulate
+            m_nextFrameTime += m_framePeriod;
+        }
+        else
+        {
+            // More than a frame late (hitch, window moved...) : do not try to catch up with a burst of frames
+            m_nextFrameTime = (now - m_nextFrameTime > m_framePeriod) ? now + m_framePeriod : m_nextFrameTime + m_framePeriod;
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include <jate/timing/frame_statistics.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace jate::timing
+{
+    TimingHistogram::TimingHistogram(double bucketWidthMs, double maxMs)
+        : m_bucketWidthMs(bucketWidthMs),
+          m_buckets(static_cast<size_t>(std::ceil(maxMs / bucketWidthMs)) + 1, 0)
+    {
+    }
+
+    void TimingHistogram::addSample(double durationMs)
+    {
+        durationMs = std::max(durationMs, 0.0);
+
+        size_t bucket = std::min(static_cast<size_t>(durationMs / m_bucketWidthMs), m_buckets.size() - 1);
+        m_buckets[bucket]++;
+
+        m_sampleCount++;
+        m_sumMs += durationMs;
+        m_maxMs = std::max(m_maxMs, durationMs);
+    }
+
+    void TimingHistogram::reset()
+    {
+        std::fill(m_buckets.begin(), m_buckets.end(), 0);
+        m_sampleCount = 0;
+        m_sumMs = 0.0;
+        m_maxMs = 0.0;
+    }
+
+    double TimingHistogram::getPercentile(double percentile) const
+    {
+        if (m_sampleCount == 0) return 0.0;
+
+        percentile = std::clamp(percentile, 0.0, 100.0);
+        uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(m_sampleCount))));
+
+        uint64_t cumulatedCount = 0;
+        for (size_t i = 0; i < m_buckets.size() - 1; i++)
+        {
+            cumulatedCount += m_buckets[i];
+            if (cumulatedCount >= rank)
+                return std::min(static_cast<double>(i + 1) * m_bucketWidthMs, m_maxMs);
+        }
+
+        // Falls in the overflow bucket : the max is the only meaningful value left
+        return m_maxMs;
+    }
+
+    void FrameStatistics::record(FrameMetric metric, double durationMs)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_histograms[static_cast<size_t>(metric)].addSample(durationMs);
+    }
+
+    FrameMetricSummary FrameStatistics::getSummary(FrameMetric metric) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const TimingHistogram& histogram = getHistogram(metric);
+
+        FrameMetricSummary summary{};
+        summary.sampleCount = histogram.getSampleCount();
+        summary.averageMs = histogram.getAverage();
+        summary.p50Ms = histogram.getPercentile(50.0);
+        summary.p95Ms = histogram.getPercentile(95.0);
+        summary.p99Ms = histogram.getPercentile(99.0);
+        summary.maxMs = histogram.getMax();
+        return summary;
+    }
+
+    void FrameStatistics::reset()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& histogram : m_histograms)
+        {
+            histogram.reset();
+        }
+    }
+}
\ No newline at end of file
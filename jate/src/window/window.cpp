@@ -29,9 +29,19 @@ namespace jate
             return;
         }
 
+        int frameBufferWidth, frameBufferHeight;
+        glfwGetFramebufferSize(m_glfwWindow, &frameBufferWidth, &frameBufferHeight);
+        m_frameBufferWidth = static_cast<uint32_t>(frameBufferWidth);
+        m_frameBufferHeight = static_cast<uint32_t>(frameBufferHeight);
+
         // Set callbacks
         glfwSetWindowUserPointer(m_glfwWindow, this);
 		glfwSetFramebufferSizeCallback(m_glfwWindow, frameBufferResizedCallback);
+        glfwSetKeyCallback(m_glfwWindow, keyCallback);
+        glfwSetCharCallback(m_glfwWindow, charCallback);
+        glfwSetMouseButtonCallback(m_glfwWindow, mouseButtonCallback);
+        glfwSetCursorPosCallback(m_glfwWindow, cursorPosCallback);
+        glfwSetScrollCallback(m_glfwWindow, scrollCallback);
     }
 
     void Window::createWindowSurface()
@@ -57,8 +67,82 @@ namespace jate
     void Window::frameBufferResizedCallback(GLFWwindow* glfwWindow, int width, int height)
     {
         Window* window = reinterpret_cast<Window*>(glfwGetWindowUserPointer(glfwWindow));
+		window->m_frameBufferWidth = static_cast<uint32_t>(width);
+		window->m_frameBufferHeight = static_cast<uint32_t>(height);
 		window->m_frameBufferResized = true;
-		window->m_width = width;
-		window->m_height = height;
 	}
+
+    void Window::pushInputEvent(const input::InputEvent& event)
+    {
+        if (!m_inputEvents.tryPush(event))
+        {
+            if (m_droppedInputEventCount == 0)
+            {
+                spdlog::warn("Input event queue is full, events are dropped");
+            }
+            m_droppedInputEventCount++;
+        }
+    }
+
+    void Window::keyCallback(GLFWwindow* glfwWindow, int key, int scancode, int action, int mods)
+    {
+        Window* window = reinterpret_cast<Window*>(glfwGetWindowUserPointer(glfwWindow));
+
+        input::InputEvent event{};
+        event.type = input::InputEventType::Key;
+        event.timestamp = std::chrono::steady_clock::now();
+        event.code = key;
+        event.scancode = scancode;
+        event.action = action;
+        event.mods = mods;
+        window->pushInputEvent(event);
+    }
+
+    void Window::charCallback(GLFWwindow* glfwWindow, unsigned int codepoint)
+    {
+        Window* window = reinterpret_cast<Window*>(glfwGetWindowUserPointer(glfwWindow));
+
+        input::InputEvent event{};
+        event.type = input::InputEventType::Char;
+        event.timestamp = std::chrono::steady_clock::now();
+        event.code = static_cast<int32_t>(codepoint);
+        window->pushInputEvent(event);
+    }
+
+    void Window::mouseButtonCallback(GLFWwindow* glfwWindow, int button, int action, int mods)
+    {
+        Window* window = reinterpret_cast<Window*>(glfwGetWindowUserPointer(glfwWindow));
+
+        input::InputEvent event{};
+        event.type = input::InputEventType::MouseButton;
+        event.timestamp = std::chrono::steady_clock::now();
+        event.code = button;
+        event.action = action;
+        event.mods = mods;
+        window->pushInputEvent(event);
+    }
+
+    void Window::cursorPosCallback(GLFWwindow* glfwWindow, double x, double y)
+    {
+        Window* window = reinterpret_cast<Window*>(glfwGetWindowUserPointer(glfwWindow));
+
+        input::InputEvent event{};
+        event.type = input::InputEventType::CursorMove;
+        event.timestamp = std::chrono::steady_clock::now();
+        event.x = x;
+        event.y = y;
+        window->pushInputEvent(event);
+    }
+
+    void Window::scrollCallback(GLFWwindow* glfwWindow, double xOffset, double yOffset)
+    {
+        Window* window = reinterpret_cast<Window*>(glfwGetWindowUserPointer(glfwWindow));
+
+        input::InputEvent event{};
+        event.type = input::InputEventType::Scroll;
+        event.timestamp = std::chrono::steady_clock::now();
+        event.x = xOffset;
+        event.y = yOffset;
+        window->pushInputEvent(event);
+    }
 }
\ No newline at end of file
@@ -0,0 +1,123 @@
+#include <jate/assets/mesh_asset.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Converts a Wavefront OBJ file to the .jmesh format. The work done here (parsing, triangulation) is what
+// loading a .jmesh at runtime avoids : the engine maps the result, and uploads it as is.
+//
+// Supported : positions, with optional vertex colors ("v x y z [r g b]"), and polygonal faces, triangulated as fans.
+// Texture coordinates and normals are ignored, since VertexData has no room for them.
+
+// OBJ indices start at 1, negative ones are relative to the end of the vertex list
+static bool parseFaceIndex(const std::string& token, size_t vertexCount, uint32_t& outIndex)
+{
+    long index = std::strtol(token.c_str(), nullptr, 10);     // Stops at the first '/'
+    if (index < 0)
+        index += static_cast<long>(vertexCount) + 1;
+
+    if (index < 1 || static_cast<size_t>(index) > vertexCount)
+        return false;
+
+    outIndex = static_cast<uint32_t>(index - 1);
+    return true;
+}
+
+static bool readObj(const std::string& path, std::vector<jate::rendering::VertexData>& vertices, std::vector<uint32_t>& indices)
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        std::cerr << "Could not open " << path << std::endl;
+        return false;
+    }
+
+    std::string line;
+    size_t lineNumber = 0;
+    std::vector<uint32_t> face;
+    while (std::getline(file, line))
+    {
+        lineNumber++;
+        std::istringstream stream(line);
+        std::string keyword;
+        stream >> keyword;
+
+        if (keyword == "v")
+        {
+            jate::rendering::VertexData& vertex = vertices.emplace_back();
+            vertex.color = {1.f, 1.f, 1.f};
+            stream >> vertex.position.x >> vertex.position.y >> vertex.position.z;
+            if (!stream)
+            {
+                std::cerr << path << ":" << lineNumber << " : invalid vertex" << std::endl;
+                return false;
+            }
+            stream >> vertex.color.x >> vertex.color.y >> vertex.color.z;
+        }
+        else if (keyword == "f")
+        {
+            face.clear();
+            std::string token;
+            while (stream >> token)
+            {
+                uint32_t index;
+                if (!parseFaceIndex(token, vertices.size(), index))
+                {
+                    std::cerr << path << ":" << lineNumber << " : invalid face index " << token << std::endl;
+                    return false;
+                }
+                face.push_back(index);
+            }
+
+            for (size_t i = 2; i < face.size(); i++)
+            {
+                indices.insert(indices.end(), {face[0], face[i - 1], face[i]});
+            }
+        }
+    }
+
+    if (vertices.size() < 3 || indices.size() < 3)
+    {
+        std::cerr << path << " has no triangle" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc != 3)
+    {
+        std::cerr << "Usage : mesh_converter <input.obj> <output.jmesh>" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::vector<jate::rendering::VertexData> vertices;
+    std::vector<uint32_t> indices;
+    if (!readObj(argv[1], vertices, indices))
+        return EXIT_FAILURE;
+
+    try
+    {
+        jate::assets::MeshAsset::write(argv[2], vertices, indices);
+
+        // Read back through the runtime path, so that a broken file never leaves the tool
+        jate::assets::MeshAsset mesh(argv[2]);
+        const jate::assets::MeshBounds& bounds = mesh.getBounds();
+        std::cout << argv[2] << " : " << mesh.getVertices().size() << " vertices, " << mesh.getIndices().size() / 3 << " triangles, bounds ("
+            << bounds.min.x << ", " << bounds.min.y << ", " << bounds.min.z << ") to ("
+            << bounds.max.x << ", " << bounds.max.y << ", " << bounds.max.z << ")" << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
\ No newline at end of file